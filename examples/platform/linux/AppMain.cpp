@@ -74,6 +74,7 @@
 
 #include "AppMain.h"
 #include "CommissionableInit.h"
+#include "MappedEventLogStorage.h"
 
 using namespace chip;
 using namespace chip::ArgParser;
@@ -383,6 +384,24 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
 
     initParams.testEventTriggerDelegate = &testEventTriggerDelegate;
 
+    // Keep the events in a file when asked to, with room for far more history than the in-memory buffers.
+    static MappedEventLogStorage eventLogStorage;
+    if (LinuxDeviceOptions::GetInstance().eventLog != nullptr)
+    {
+        const uint32_t kEventLogBufferSizes[MappedEventLogStorage::kNumBuffers] = { 1024 * 1024, 1024 * 1024, 1024 * 1024 };
+
+        CHIP_ERROR err = eventLogStorage.Init(LinuxDeviceOptions::GetInstance().eventLog, kEventLogBufferSizes);
+        if (err == CHIP_NO_ERROR)
+        {
+            initParams.eventLogStorageResources = eventLogStorage.GetLogStorageResources();
+        }
+        else
+        {
+            ChipLogError(NotSpecified, "Failed to open the event log file, events will not be kept: %" CHIP_ERROR_FORMAT,
+                         err.Format());
+        }
+    }
+
     // We need to set DeviceInfoProvider before Server::Init to setup the storage of DeviceInfoProvider properly.
     DeviceLayer::SetDeviceInfoProvider(&gExampleDeviceInfoProvider);
 
@@ -437,6 +456,8 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
 
     Server::GetInstance().Shutdown();
 
+    eventLogStorage.Shutdown();
+
     DeviceLayer::PlatformMgr().Shutdown();
 
     Cleanup();
@@ -0,0 +1,237 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "MappedEventLogStorage.h"
+
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr uint32_t kFileMagic   = 0x4c455443; // "CTEL"
+constexpr uint32_t kFileVersion = 1;
+
+// The first page of the file holds the file header, followed by the state slots of each
+// region. The regions holding the events follow the first page.
+constexpr size_t kHeaderPageSize   = 4096;
+constexpr size_t kStateSlotsOffset = 256;
+constexpr size_t kStateSlotsStride = 64;
+constexpr size_t kNumStateSlots    = 2;
+
+struct FileHeader
+{
+    uint32_t mMagic;
+    uint32_t mVersion;
+    uint32_t mNumBuffers;
+    uint32_t mBufferSizes[MappedEventLogStorage::kNumBuffers];
+};
+
+struct StateSlot
+{
+    uint64_t mSequence;
+    uint32_t mHeadOffset;
+    uint32_t mDataLength;
+    uint32_t mChecksum;
+    uint32_t mReserved;
+};
+
+static_assert(sizeof(FileHeader) <= kStateSlotsOffset, "File header overlaps the state slots");
+static_assert(kNumStateSlots * sizeof(StateSlot) <= kStateSlotsStride, "State slots overlap");
+static_assert(kStateSlotsOffset + MappedEventLogStorage::kNumBuffers * kStateSlotsStride <= kHeaderPageSize,
+              "State slots do not fit in the header page");
+
+// FNV-1a over the fields of the slot preceding the checksum.
+uint32_t ComputeChecksum(const StateSlot & slot)
+{
+    const uint8_t * bytes = reinterpret_cast<const uint8_t *>(&slot);
+    uint32_t hash         = 2166136261u;
+    for (size_t i = 0; i < offsetof(StateSlot, mChecksum); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+void MappedEventLogStorage::BufferStore::Init(uint8_t * apSlots, uint32_t aBufferSize)
+{
+    mpSlots      = apSlots;
+    mBufferSize  = aBufferSize;
+    mSequence    = 0;
+    mCurrentSlot = 0;
+}
+
+CHIP_ERROR MappedEventLogStorage::BufferStore::LoadState(uint32_t & aHeadOffset, uint32_t & aDataLength)
+{
+    bool found = false;
+
+    for (uint8_t i = 0; i < kNumStateSlots; i++)
+    {
+        StateSlot slot;
+        memcpy(&slot, mpSlots + i * sizeof(StateSlot), sizeof(slot));
+
+        if (slot.mChecksum != ComputeChecksum(slot) || slot.mSequence == 0 || slot.mHeadOffset >= mBufferSize ||
+            slot.mDataLength > mBufferSize)
+        {
+            continue;
+        }
+
+        if (!found || slot.mSequence > mSequence)
+        {
+            found        = true;
+            mSequence    = slot.mSequence;
+            mCurrentSlot = i;
+            aHeadOffset  = slot.mHeadOffset;
+            aDataLength  = slot.mDataLength;
+        }
+    }
+
+    return found ? CHIP_NO_ERROR : CHIP_ERROR_NOT_FOUND;
+}
+
+void MappedEventLogStorage::BufferStore::SaveState(uint32_t aHeadOffset, uint32_t aDataLength)
+{
+    StateSlot slot;
+    slot.mSequence   = mSequence + 1;
+    slot.mHeadOffset = aHeadOffset;
+    slot.mDataLength = aDataLength;
+    slot.mReserved   = 0;
+    slot.mChecksum   = ComputeChecksum(slot);
+
+    // The events described by the new state must be in place before it is committed, and the
+    // current slot is left untouched so that an interrupted commit falls back to it.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint8_t nextSlot = static_cast<uint8_t>((mCurrentSlot + 1) % kNumStateSlots);
+    memcpy(mpSlots + nextSlot * sizeof(StateSlot), &slot, sizeof(slot));
+
+    mSequence    = slot.mSequence;
+    mCurrentSlot = nextSlot;
+}
+
+CHIP_ERROR MappedEventLogStorage::Init(const char * aPath, const uint32_t (&aBufferSizes)[kNumBuffers])
+{
+    VerifyOrReturnError(mpMapping == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aPath != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t mappingSize = kHeaderPageSize;
+    for (uint32_t bufferSize : aBufferSizes)
+    {
+        VerifyOrReturnError(bufferSize > 0, CHIP_ERROR_INVALID_ARGUMENT);
+        mappingSize += bufferSize;
+    }
+
+    int fd = open(aPath, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        ChipLogError(AppServer, "Failed to open event log file %s: %s", aPath, strerror(errno));
+        return err;
+    }
+
+    struct stat st;
+    bool resized = false;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != mappingSize)
+    {
+        resized = true;
+        if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0)
+        {
+            CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+            ChipLogError(AppServer, "Failed to size event log file %s: %s", aPath, strerror(errno));
+            close(fd);
+            return err;
+        }
+    }
+
+    void * mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+        ChipLogError(AppServer, "Failed to map event log file %s: %s", aPath, strerror(errno));
+        close(fd);
+        return err;
+    }
+
+    mFd          = fd;
+    mpMapping    = static_cast<uint8_t *>(mapping);
+    mMappingSize = mappingSize;
+
+    FileHeader expected;
+    memset(&expected, 0, sizeof(expected));
+    expected.mMagic      = kFileMagic;
+    expected.mVersion    = kFileVersion;
+    expected.mNumBuffers = kNumBuffers;
+    memcpy(expected.mBufferSizes, aBufferSizes, sizeof(expected.mBufferSizes));
+
+    if (resized || memcmp(mpMapping, &expected, sizeof(expected)) != 0)
+    {
+        // Any state left in the file describes a different layout, start over with empty regions.
+        ChipLogProgress(AppServer, "Initializing event log file %s", aPath);
+        memset(mpMapping, 0, kHeaderPageSize);
+        memcpy(mpMapping, &expected, sizeof(expected));
+    }
+
+    static const chip::app::PriorityLevel kPriorities[kNumBuffers] = { chip::app::PriorityLevel::Debug,
+                                                                      chip::app::PriorityLevel::Info,
+                                                                      chip::app::PriorityLevel::Critical };
+
+    uint8_t * region = mpMapping + kHeaderPageSize;
+    for (size_t i = 0; i < kNumBuffers; i++)
+    {
+        mStores[i].Init(mpMapping + kStateSlotsOffset + i * kStateSlotsStride, aBufferSizes[i]);
+
+        mResources[i].mpBuffer    = region;
+        mResources[i].mBufferSize = aBufferSizes[i];
+        mResources[i].mPriority   = kPriorities[i];
+        mResources[i].mpStore     = &mStores[i];
+
+        region += aBufferSizes[i];
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void MappedEventLogStorage::Shutdown()
+{
+    VerifyOrReturn(mpMapping != nullptr);
+
+    // Writes to the mapping reach the file even if the process stops; flushing them to disk is
+    // otherwise left to the kernel while running.
+    if (msync(mpMapping, mMappingSize, MS_SYNC) != 0)
+    {
+        ChipLogError(AppServer, "Failed to flush event log file: %s", strerror(errno));
+    }
+    munmap(mpMapping, mMappingSize);
+    close(mFd);
+
+    mFd          = -1;
+    mpMapping    = nullptr;
+    mMappingSize = 0;
+}
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/EventManagement.h>
+#include <lib/core/CHIPError.h>
+
+/**
+ * Event log storage backed by a memory-mapped file, so that the events logged by the
+ * application survive a restart of the process.
+ *
+ * The file holds one region per priority level (Debug, Info, Critical) followed by the
+ * state of each region.  Events are written in place by the EventManagement; the state of
+ * each region is committed to one of two alternating, checksummed slots so that the process
+ * stopping while committing leaves the previous state intact.
+ *
+ * The file is only flushed to disk on Shutdown, so the events logged since the last flush
+ * may be lost if the system (rather than the process) stops.
+ */
+class MappedEventLogStorage
+{
+public:
+    static constexpr size_t kNumBuffers = 3;
+
+    MappedEventLogStorage() = default;
+    ~MappedEventLogStorage() { Shutdown(); }
+
+    /**
+     * @brief Open (or create) the event log file and map it into memory.
+     *
+     * An existing file whose layout does not match aBufferSizes is reset.
+     *
+     * @param aPath        - Path of the event log file.
+     * @param aBufferSizes - Size in bytes of the Debug, Info and Critical regions.
+     */
+    CHIP_ERROR Init(const char * aPath, const uint32_t (&aBufferSizes)[kNumBuffers]);
+
+    /**
+     * @brief Flush the event log file to disk and unmap it.  Must be called after the
+     *        EventManagement using the storage was shut down.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Resources to pass to EventManagement::Init, one per priority level.  Only
+     *        valid after a successful Init.
+     */
+    const chip::app::LogStorageResources * GetLogStorageResources() const { return mResources; }
+
+private:
+    class BufferStore : public chip::app::CircularEventBufferStore
+    {
+    public:
+        void Init(uint8_t * apSlots, uint32_t aBufferSize);
+
+        CHIP_ERROR LoadState(uint32_t & aHeadOffset, uint32_t & aDataLength) override;
+        void SaveState(uint32_t aHeadOffset, uint32_t aDataLength) override;
+
+    private:
+        uint8_t * mpSlots    = nullptr;
+        uint32_t mBufferSize = 0;
+        uint64_t mSequence   = 0;
+        uint8_t mCurrentSlot = 0;
+    };
+
+    int mFd             = -1;
+    uint8_t * mpMapping = nullptr;
+    size_t mMappingSize = 0;
+    BufferStore mStores[kNumBuffers];
+    chip::app::LogStorageResources mResources[kNumBuffers];
+};
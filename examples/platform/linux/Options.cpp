@@ -78,6 +78,7 @@ enum
     kOptionCSRResponseCSRExistingKeyPair                = 0x101e,
     kDeviceOption_TestEventTriggerEnableKey             = 0x101f,
     kCommissionerOption_FabricID                        = 0x1020,
+    kDeviceOption_EventLog                              = 0x1021,
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -112,6 +113,7 @@ OptionDef sDeviceOptionDefs[] = {
     { "command", kArgumentRequired, kDeviceOption_Command },
     { "PICS", kArgumentRequired, kDeviceOption_PICS },
     { "KVS", kArgumentRequired, kDeviceOption_KVS },
+    { "event-log", kArgumentRequired, kDeviceOption_EventLog },
     { "interface-id", kArgumentRequired, kDeviceOption_InterfaceId },
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
     { "trace_file", kArgumentRequired, kDeviceOption_TraceFile },
@@ -209,6 +211,9 @@ const char * sDeviceOptionHelp =
     "  --KVS <filepath>\n"
     "       A file to store Key Value Store items.\n"
     "\n"
+    "  --event-log <filepath>\n"
+    "       A file to store logged events in, so that they are kept across restarts.\n"
+    "\n"
     "  --interface-id <interface>\n"
     "       A interface id to advertise on.\n"
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
@@ -418,6 +423,10 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         LinuxDeviceOptions::GetInstance().KVS = aValue;
         break;
 
+    case kDeviceOption_EventLog:
+        LinuxDeviceOptions::GetInstance().eventLog = aValue;
+        break;
+
     case kDeviceOption_InterfaceId:
         LinuxDeviceOptions::GetInstance().interfaceId =
             Inet::InterfaceId(static_cast<chip::Inet::InterfaceId::PlatformType>(atoi(aValue)));
@@ -67,6 +67,42 @@ public:
      */
     virtual CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                                  MutableByteSpan & aValue) = 0;
+
+    /**
+     * Start or resume a batch of writes, such as the writes of a write
+     * transaction.  While the batch is in progress, the provider may hold back
+     * the values written, and persist them together, once per attribute, when
+     * the batch ends.  Values held back must still be returned by ReadValue.
+     *
+     * Only the values written between StartBatch and the following
+     * SuspendBatch or EndBatch for the same batch are held back as part of it,
+     * so that writes made while the batch is suspended, e.g. by other
+     * interactions, are persisted as usual.  A single batch is in progress at
+     * a time; other batches can only be suspended meanwhile.
+     *
+     * @param [in] aBatch identifies the batch, e.g. the object driving it.
+     */
+    virtual void StartBatch(const void * aBatch) {}
+
+    /**
+     * Suspend a batch started by StartBatch.  The values held back for the
+     * batch remain held back until it ends.
+     */
+    virtual void SuspendBatch(const void * aBatch) {}
+
+    /**
+     * End a batch started by StartBatch, suspended or not, and persist the
+     * values held back for it.  Every batch started must be ended.
+     */
+    virtual void EndBatch(const void * aBatch) {}
+
+protected:
+    /**
+     * Check that the value read into aValue, of aSize bytes, is a valid value
+     * of the attribute described by aMetadata, and reduce aValue to it.  Meant
+     * to be used by ReadValue implementations once they have read a value.
+     */
+    static CHIP_ERROR ValidateReadValue(const EmberAfAttributeMetadata * aMetadata, size_t aSize, MutableByteSpan & aValue);
 };
 
 /**
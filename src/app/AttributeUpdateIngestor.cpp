@@ -0,0 +1,167 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeUpdateIngestor.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/PlatformManager.h>
+
+#include <mutex>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR AttributeUpdateIngestor::Producer::UpdateAttribute(const ConcreteAttributePath & path, uint8_t type,
+                                                             const ByteSpan & value)
+{
+    VerifyOrReturnError(value.size() <= CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE, CHIP_ERROR_BUFFER_TOO_SMALL);
+    return BufferUpdate(path, type, &value);
+}
+
+CHIP_ERROR AttributeUpdateIngestor::Producer::MarkAttributeDirty(const ConcreteAttributePath & path)
+{
+    return BufferUpdate(path, 0, nullptr);
+}
+
+CHIP_ERROR AttributeUpdateIngestor::Producer::BufferUpdate(const ConcreteAttributePath & path, uint8_t type,
+                                                          const ByteSpan * value)
+{
+    VerifyOrReturnError(mIngestor != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    {
+        std::lock_guard<System::Mutex> lock(mLock);
+
+        AttributeUpdate * updates = mBuffers[mActiveBuffer];
+        size_t & updateCount      = mUpdateCount[mActiveBuffer];
+        AttributeUpdate * update  = nullptr;
+        for (size_t i = 0; i < updateCount && update == nullptr; i++)
+        {
+            if (updates[i].mPath == path)
+            {
+                update = &updates[i];
+            }
+        }
+
+        if (update == nullptr)
+        {
+            VerifyOrReturnError(updateCount < CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE, CHIP_ERROR_NO_MEMORY);
+            update            = &updates[updateCount++];
+            update->mPath     = path;
+            update->mHasValue = false;
+        }
+
+        // Marking an attribute dirty does not discard the value buffered for it, applying the value marks it dirty.
+        if (value != nullptr)
+        {
+            update->mType      = type;
+            update->mHasValue  = true;
+            update->mValueSize = static_cast<uint8_t>(value->size());
+            memcpy(update->mValue, value->data(), value->size());
+        }
+    }
+
+    return mIngestor->RequestDrain();
+}
+
+CHIP_ERROR AttributeUpdateIngestor::RegisterProducer(Producer & producer)
+{
+    VerifyOrReturnError(producer.mIngestor == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(System::Mutex::Init(producer.mLock));
+
+    producer.mIngestor = this;
+    producer.mNext     = mProducers;
+    mProducers         = &producer;
+    return CHIP_NO_ERROR;
+}
+
+void AttributeUpdateIngestor::UnregisterProducer(Producer & producer)
+{
+    VerifyOrReturn(producer.mIngestor == this);
+
+    for (Producer ** link = &mProducers; *link != nullptr; link = &(*link)->mNext)
+    {
+        if (*link == &producer)
+        {
+            *link = producer.mNext;
+            break;
+        }
+    }
+
+    // Both buffers may hold updates.
+    DrainProducer(producer);
+    DrainProducer(producer);
+    producer.mIngestor = nullptr;
+    producer.mNext     = nullptr;
+}
+
+void AttributeUpdateIngestor::Drain()
+{
+    // Cleared first, so that an update buffered while draining schedules another drain.
+    mDrainRequested.exchange(false, std::memory_order_acq_rel);
+
+    for (Producer * producer = mProducers; producer != nullptr; producer = producer->mNext)
+    {
+        DrainProducer(*producer);
+    }
+}
+
+CHIP_ERROR AttributeUpdateIngestor::ScheduleDrain()
+{
+    return DeviceLayer::PlatformMgr().ScheduleWork(DrainWork, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR AttributeUpdateIngestor::RequestDrain()
+{
+    // Only the first update buffered since the last drain needs to schedule one.  Checking before exchanging keeps the
+    // producers from writing the flag, shared by all of them, on every update.
+    VerifyOrReturnError(!mDrainRequested.load(std::memory_order_acquire), CHIP_NO_ERROR);
+    VerifyOrReturnError(!mDrainRequested.exchange(true, std::memory_order_acq_rel), CHIP_NO_ERROR);
+
+    CHIP_ERROR err = ScheduleDrain();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule attribute updates drain: %" CHIP_ERROR_FORMAT, err.Format());
+        mDrainRequested.store(false, std::memory_order_release);
+    }
+    return err;
+}
+
+void AttributeUpdateIngestor::DrainProducer(Producer & producer)
+{
+    uint8_t buffer;
+    {
+        std::lock_guard<System::Mutex> lock(producer.mLock);
+        buffer                 = producer.mActiveBuffer;
+        producer.mActiveBuffer = static_cast<uint8_t>(buffer ^ 1);
+    }
+
+    // The producer no longer touches this buffer until the next drain swaps them again.
+    for (size_t i = 0; i < producer.mUpdateCount[buffer]; i++)
+    {
+        ApplyUpdate(producer.mBuffers[buffer][i]);
+    }
+    producer.mUpdateCount[buffer] = 0;
+}
+
+void AttributeUpdateIngestor::DrainWork(intptr_t arg)
+{
+    reinterpret_cast<AttributeUpdateIngestor *>(arg)->Drain();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,150 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <system/SystemMutex.h>
+
+#include <atomic>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+static_assert(CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE <= UINT8_MAX, "Attribute update values are sized with a uint8_t");
+
+/**
+ * An attribute update buffered by an AttributeUpdateIngestor producer.
+ */
+struct AttributeUpdate
+{
+    ConcreteAttributePath mPath;
+    uint8_t mType      = 0;     ///< Type of the value, e.g. an EmberAfAttributeType.
+    bool mHasValue     = false; ///< False when the attribute was only marked dirty.
+    uint8_t mValueSize = 0;
+    uint8_t mValue[CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE];
+
+    ByteSpan GetValue() const { return ByteSpan(mValue, mValueSize); }
+};
+
+/**
+ * Ingests attribute updates from application threads, without them having to
+ * lock the CHIP stack for every update.
+ *
+ * Every thread updating attributes registers its own Producer, which buffers
+ * the updates; the latest value of an attribute supersedes the one still
+ * buffered.  The first update buffered since the last drain schedules a drain
+ * on the Matter thread, which applies the updates of all the producers in one
+ * go, once per coalesced path.
+ *
+ * Each producer buffers its updates under its own System::Mutex, which the
+ * drain only holds to swap the producer's buffers, so a producer never waits
+ * for the CHIP stack lock nor for the other producers.
+ *
+ * Subclasses define how an update is applied, e.g. by writing the attribute
+ * storage and marking the attribute dirty for reporting.  The ingestor must
+ * outlive any drain it scheduled.
+ */
+class AttributeUpdateIngestor
+{
+public:
+    class Producer
+    {
+    public:
+        Producer() = default;
+
+        Producer(const Producer &) = delete;
+        Producer & operator=(const Producer &) = delete;
+
+        /*
+         * Buffer the new value of an attribute.  Only to be called by the thread the producer belongs to, which does not
+         * need to lock the CHIP stack.
+         *
+         * @retval #CHIP_ERROR_INCORRECT_STATE if the producer is not registered.
+         * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if the value is larger than CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE.
+         * @retval #CHIP_ERROR_NO_MEMORY if CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE other attributes are
+         *         buffered already.  The update can be retried once the Matter thread drained them.
+         * @retval other errors if the drain could not be scheduled.  The update is still buffered and is applied by the
+         *         next drain.
+         */
+        CHIP_ERROR UpdateAttribute(const ConcreteAttributePath & path, uint8_t type, const ByteSpan & value);
+
+        /*
+         * Buffer a change of an attribute the ingestor does not store the value of, e.g. one stored by the application,
+         * so that it is only marked dirty.  Same constraints and errors as UpdateAttribute.
+         */
+        CHIP_ERROR MarkAttributeDirty(const ConcreteAttributePath & path);
+
+    private:
+        friend class AttributeUpdateIngestor;
+
+        CHIP_ERROR BufferUpdate(const ConcreteAttributePath & path, uint8_t type, const ByteSpan * value);
+
+        AttributeUpdateIngestor * mIngestor = nullptr;
+        Producer * mNext                    = nullptr;
+
+        // Updates are buffered in mBuffers[mActiveBuffer] while the drain applies the ones in the other buffer.
+        System::Mutex mLock;
+        AttributeUpdate mBuffers[2][CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE];
+        size_t mUpdateCount[2] = { 0, 0 };
+        uint8_t mActiveBuffer  = 0;
+    };
+
+    virtual ~AttributeUpdateIngestor() = default;
+
+    /*
+     * Must be called with the CHIP stack locked.  The producer must stay registered as long as its thread can update
+     * attributes.
+     */
+    CHIP_ERROR RegisterProducer(Producer & producer);
+
+    /*
+     * Applies the updates the producer still buffers.  Must be called with the CHIP stack locked.
+     */
+    void UnregisterProducer(Producer & producer);
+
+    /*
+     * Apply the updates buffered by all the producers.  Must be called with the CHIP stack locked.
+     */
+    void Drain();
+
+protected:
+    /*
+     * Apply an update, with the CHIP stack locked.
+     */
+    virtual void ApplyUpdate(AttributeUpdate & update) = 0;
+
+    /*
+     * Schedule a call to Drain on the Matter thread.  Can be called from any thread.  Schedules work on the
+     * PlatformManager by default.
+     */
+    virtual CHIP_ERROR ScheduleDrain();
+
+private:
+    CHIP_ERROR RequestDrain();
+    void DrainProducer(Producer & producer);
+
+    static void DrainWork(intptr_t arg);
+
+    Producer * mProducers = nullptr;
+    std::atomic<bool> mDrainRequested{ false };
+};
+
+} // namespace app
+} // namespace chip
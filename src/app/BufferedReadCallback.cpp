@@ -24,7 +24,6 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
-#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace app {
@@ -45,93 +44,104 @@ void BufferedReadCallback::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
+namespace {
+
+constexpr uint8_t kListStartControlByte = TLV::TLVElementType::Array | TLV::TLVTagControl::Anonymous;
+constexpr uint8_t kListEndControlByte   = static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer);
+
+/*
+ * Copy the element the reader is positioned on at the end of the data in aBuffer.  The reader itself is not advanced.
+ */
+CHIP_ERROR AppendElement(System::PacketBufferHandle & aBuffer, const TLV::TLVReader & aReader)
 {
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    TLV::TLVReader reader;
+    TLV::TLVWriter writer;
 
+    reader.Init(aReader);
+    writer.Init(aBuffer->Start() + aBuffer->DataLength(), aBuffer->AvailableDataLength());
+
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    aBuffer->SetDataLength(static_cast<uint16_t>(aBuffer->DataLength() + writer.GetLengthWritten()));
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR BufferedReadCallback::GenerateListTLV(System::ChainedPacketBufferTLVReader & aReader)
+{
     //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
+    // The list items were buffered as elements of a TLV array whose start was written ahead of them, so
+    // all that is left to do is to end the array.
     //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
+    // The buffers are not reassembled into a contiguous buffer: the reader reads the list in place across
+    // them. This relies on ChainedPacketBufferBackingStore not tracking the position of the reader in the chain,
+    // since decoders create readers off-of readers which share the backing store and read from it in any order.
     //
-    uint32_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
+    if (mBufferedList.IsNull() && mBufferedListTail.IsNull())
     {
-        totalBufSize += packetBuffer->TotalLength();
+        ReturnErrorOnFailure(BufferControlByte(kListStartControlByte));
     }
 
-    //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
-    //
-    totalBufSize += 4;
-
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(BufferControlByte(kListEndControlByte));
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+    mBufferedListTail.RightSize();
+    mBufferedList.AddToEnd(std::move(mBufferedListTail));
 
-    for (auto & bufHandle : mBufferedList)
-    {
-        System::PacketBufferTLVReader reader;
+    return aReader.Init(std::move(mBufferedList));
+}
 
-        reader.Init(std::move(bufHandle));
+CHIP_ERROR BufferedReadCallback::AddBufferedListBuffer(uint16_t aSize)
+{
+    System::PacketBufferHandle handle = System::PacketBufferHandle::New(aSize, 0);
+    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    if (!mBufferedListTail.IsNull())
+    {
+        // Compact the filled buffer down to a more reasonably sized packet buffer
+        // if we can.
+        //
+        mBufferedListTail.RightSize();
+        mBufferedList.AddToEnd(std::move(mBufferedListTail));
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
+    mBufferedListTail = std::move(handle);
 
-    writer.Finalize(backingBuffer);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BufferedReadCallback::BufferControlByte(uint8_t aControlByte)
+{
+    if (mBufferedListTail.IsNull() || mBufferedListTail->AvailableDataLength() == 0)
+    {
+        ReturnErrorOnFailure(AddBufferedListBuffer(chip::app::kMaxSecureSduLengthBytes));
+    }
 
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+    mBufferedListTail->Start()[mBufferedListTail->DataLength()] = aControlByte;
+    mBufferedListTail->SetDataLength(static_cast<uint16_t>(mBufferedListTail->DataLength() + 1));
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
-    System::PacketBufferTLVWriter writer;
-    System::PacketBufferHandle handle;
-
-    //
-    // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
-    // data received over the wire, which should always fit within that).
-    //
-    // We could have snapshotted the reader at its current position, advanced it past the current element
-    // and computed the delta in its read point to figure out the size of the element before allocating
-    // our target buffer. However, the reader's current position is already set past the control octet
-    // and the tag. Consequently, the computed size is always going to omit the sizes of these two parts of the
-    // TLV element. Since the tag can vary in size, for now, let's just do the safe thing. In the future, if this is a problem,
-    // we can improve this.
-    //
-    handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
-    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-    writer.Init(std::move(handle), false);
+    if (mBufferedList.IsNull() && mBufferedListTail.IsNull())
+    {
+        ReturnErrorOnFailure(BufferControlByte(kListStartControlByte));
+    }
 
-    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    ReturnErrorOnFailure(writer.Finalize(&handle));
+    CHIP_ERROR err = AppendElement(mBufferedListTail, reader);
+    if (err != CHIP_ERROR_BUFFER_TOO_SMALL && err != CHIP_ERROR_NO_MEMORY)
+    {
+        return err;
+    }
 
-    // Compact the buffer down to a more reasonably sized packet buffer
-    // if we can.
     //
-    handle.RightSize();
-
-    mBufferedList.push_back(std::move(handle));
-
-    return CHIP_NO_ERROR;
+    // The item does not fit in the buffer being filled, copy it into a new one. We allocate a packet buffer
+    // as big as an IPv6 MTU since we're buffering data received over the wire, which should always fit within that.
+    //
+    ReturnErrorOnFailure(AddBufferedListBuffer(chip::app::kMaxSecureSduLengthBytes));
+    return AppendElement(mBufferedListTail, reader);
 }
 
 CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData)
@@ -142,7 +152,7 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
         TLV::TLVType outerContainer;
 
         VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
-        mBufferedList.clear();
+        ClearBufferedList();
 
         ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
 
@@ -201,7 +211,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     }
 
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    System::ChainedPacketBufferTLVReader reader;
 
     ReturnErrorOnFailure(GenerateListTLV(reader));
 
@@ -221,7 +231,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     //
     // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
     //
-    mBufferedList.clear();
+    ClearBufferedList();
     mBufferedPath = ConcreteDataAttributePath();
     return CHIP_NO_ERROR;
 }
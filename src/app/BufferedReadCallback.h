@@ -23,7 +23,6 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/AttributePathParams.h>
 #include <app/ReadClient.h>
-#include <vector>
 
 namespace chip {
 namespace app {
@@ -42,9 +41,10 @@ public:
 
 private:
     /*
-     * Generates the reconsistuted TLV array from the stored individual list elements
+     * Completes the TLV array of the buffered list elements and hands the chain of buffers holding it over to the
+     * provided reader, which then reads the list in place across the buffers.
      */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
+    CHIP_ERROR GenerateListTLV(System::ChainedPacketBufferTLVReader & reader);
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -71,7 +71,7 @@ private:
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnError(CHIP_ERROR aError) override
     {
-        mBufferedList.clear();
+        ClearBufferedList();
         return mCallback.OnError(aError);
     }
 
@@ -114,15 +114,39 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, copy the list item where the reader is positioned at the end of
+     * our buffered list, allocating a packet buffer for it if it does not fit in the last one.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
      */
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
+
+    /*
+     * Append a TLV control byte (start or end of the list array) at the end of the buffered list.
+     */
+    CHIP_ERROR BufferControlByte(uint8_t aControlByte);
+
+    /*
+     * Allocate a new buffer to fill, adding the one being filled (if any) to the buffered list.
+     */
+    CHIP_ERROR AddBufferedListBuffer(uint16_t aSize);
+
+    void ClearBufferedList()
+    {
+        mBufferedList     = nullptr;
+        mBufferedListTail = nullptr;
+    }
+
     ConcreteDataAttributePath mBufferedPath;
-    std::vector<System::PacketBufferHandle> mBufferedList;
+
+    //
+    // The buffered list is the TLV of an array holding the list items, spread over a chain of packet buffers.  Items are
+    // packed into the buffers, but each of them is held entirely by one buffer so that its strings can be decoded as
+    // spans.  mBufferedListTail is the buffer being filled, which is added to the chain in mBufferedList once full.
+    //
+    System::PacketBufferHandle mBufferedList;
+    System::PacketBufferHandle mBufferedListTail;
     Callback & mCallback;
 };
 
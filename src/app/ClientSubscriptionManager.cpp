@@ -0,0 +1,486 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClientSubscriptionManager.h>
+
+#include <app/InteractionModelEngine.h>
+#include <crypto/RandUtils.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace chip {
+namespace app {
+
+using namespace System::Clock::Literals;
+
+SubscriptionTimerWheel::SubscriptionTimerWheel(System::Clock::Milliseconds32 aTickInterval, size_t aSlotCount) :
+    mTickInterval(aTickInterval), mSlots(aSlotCount)
+{
+    VerifyOrDie(aTickInterval.count() > 0 && aSlotCount > 0);
+}
+
+SubscriptionTimerWheel::~SubscriptionTimerWheel()
+{
+    for (auto & slot : mSlots)
+    {
+        while (!slot.Empty())
+        {
+            slot.begin()->Unlink();
+        }
+    }
+    while (!mExpired.Empty())
+    {
+        mExpired.begin()->Unlink();
+    }
+}
+
+void SubscriptionTimerWheel::Schedule(Timer & aTimer, System::Clock::Timestamp aDeadline)
+{
+    aTimer.Unlink();
+
+    // Round the deadline up to a tick, which must not have been processed yet.
+    uint64_t tick = (aDeadline.count() + mTickInterval.count() - 1) / mTickInterval.count();
+    tick          = std::max(tick, mCurrentTick + 1);
+
+    aTimer.mDeadline     = aDeadline;
+    aTimer.mDeadlineTick = tick;
+    mSlots[tick % mSlots.size()].PushBack(&aTimer);
+}
+
+void SubscriptionTimerWheel::Advance(System::Clock::Timestamp aNow)
+{
+    uint64_t nowTick = ToTick(aNow);
+    VerifyOrReturn(nowTick > mCurrentTick);
+
+    // Go over the slots of the ticks elapsed since the last call, at most once each.  Timers due further away than the
+    // number of slots share their slot with earlier timers, and are left there until their turn of the wheel.
+    uint64_t elapsedTicks = std::min<uint64_t>(nowTick - mCurrentTick, mSlots.size());
+    for (uint64_t i = 1; i <= elapsedTicks; i++)
+    {
+        TimerList & slot = mSlots[(mCurrentTick + i) % mSlots.size()];
+        for (auto it = slot.begin(); it != slot.end();)
+        {
+            Timer & timer = *it;
+            ++it;
+            if (timer.mDeadlineTick <= nowTick)
+            {
+                timer.Unlink();
+                mExpired.PushBack(&timer);
+            }
+        }
+    }
+    mCurrentTick = nowTick;
+
+    // The callbacks may cancel or reschedule any timer, so only ever take the first expired one.
+    while (!mExpired.Empty())
+    {
+        Timer & timer = *mExpired.begin();
+        timer.Unlink();
+        timer.mCallback(timer, timer.mpContext);
+    }
+}
+
+bool SubscriptionTimerWheel::IsEmpty() const
+{
+    return std::all_of(mSlots.begin(), mSlots.end(), [](const TimerList & slot) { return slot.Empty(); });
+}
+
+void ResubscribeRateLimiter::Init(uint32_t aRatePerSecond, uint32_t aBurst, System::Clock::Timestamp aNow)
+{
+    mRatePerSecond  = std::max<uint32_t>(aRatePerSecond, 1);
+    mMaxMilliTokens = std::max<uint32_t>(aBurst, 1) * kMilliTokensPerToken;
+    mMilliTokens    = mMaxMilliTokens;
+    mLastRefill     = aNow;
+}
+
+void ResubscribeRateLimiter::Refill(System::Clock::Timestamp aNow)
+{
+    VerifyOrReturn(aNow > mLastRefill);
+
+    // At mRatePerSecond tokens per second, mRatePerSecond milli-tokens are added per millisecond.
+    uint64_t elapsedMs = (aNow - mLastRefill).count();
+    mMilliTokens       = std::min(mMaxMilliTokens, mMilliTokens + elapsedMs * mRatePerSecond);
+    mLastRefill        = aNow;
+}
+
+bool ResubscribeRateLimiter::TryAcquire(System::Clock::Timestamp aNow, System::Clock::Milliseconds32 & aWait)
+{
+    Refill(aNow);
+
+    if (mMilliTokens >= kMilliTokensPerToken)
+    {
+        mMilliTokens -= kMilliTokensPerToken;
+        return true;
+    }
+
+    uint64_t missing = kMilliTokensPerToken - mMilliTokens;
+    aWait            = System::Clock::Milliseconds32(static_cast<uint32_t>((missing + mRatePerSecond - 1) / mRatePerSecond));
+    return false;
+}
+
+ClientSubscriptionManager::~ClientSubscriptionManager()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ClientSubscriptionManager::Init(InteractionModelEngine * apImEngine, const Config & aConfig)
+{
+    VerifyOrReturnError(mpImEngine == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apImEngine != nullptr && apImEngine->GetExchangeManager() != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aConfig.mTickInterval.count() > 0 && aConfig.mWheelSlots > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mWheel = Platform::MakeUnique<SubscriptionTimerWheel>(aConfig.mTickInterval, aConfig.mWheelSlots);
+    VerifyOrReturnError(mWheel, CHIP_ERROR_NO_MEMORY);
+
+    mpImEngine    = apImEngine;
+    mpSystemLayer = apImEngine->GetExchangeManager()->GetSessionManager()->SystemLayer();
+    mConfig       = aConfig;
+    mRateLimiter.Init(aConfig.mResubscribeRatePerSecond, aConfig.mResubscribeBurst,
+                      System::SystemClock().GetMonotonicTimestamp());
+    mMetrics = Metrics();
+
+    return CHIP_NO_ERROR;
+}
+
+void ClientSubscriptionManager::Shutdown()
+{
+    VerifyOrReturn(mpImEngine != nullptr);
+
+    while (!mSubscriptions.empty())
+    {
+        RemoveSubscription(*mSubscriptions.begin()->second.mpReadClient);
+    }
+
+    mpSystemLayer->CancelTimer(OnTick, this);
+    mpSystemLayer->CancelTimer(OnDispatch, this);
+    mTickTimerStarted = false;
+
+    mWheel.reset();
+    mpSystemLayer = nullptr;
+    mpImEngine    = nullptr;
+}
+
+CHIP_ERROR ClientSubscriptionManager::AddSubscription(ReadClient & aReadClient, Priority aPriority, ClusterStateCache * apCache)
+{
+    VerifyOrReturnError(mpImEngine != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aReadClient.IsSubscriptionType(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(to_underlying(aPriority) < kPriorityCount, CHIP_ERROR_INVALID_ARGUMENT);
+
+    auto result = mSubscriptions.emplace(std::piecewise_construct, std::forward_as_tuple(&aReadClient), std::forward_as_tuple());
+    VerifyOrReturnError(result.second, CHIP_ERROR_INCORRECT_STATE);
+
+    Subscription & subscription = result.first->second;
+    subscription.mpReadClient   = &aReadClient;
+    subscription.mpManager      = this;
+    subscription.mpCache        = apCache;
+    subscription.mPriority      = aPriority;
+    subscription.mLivenessTimer.Init(OnLivenessTimerExpired, &subscription);
+    subscription.mResubscribeTimer.Init(OnResubscribeTimerExpired, &subscription);
+
+    aReadClient.SetTimerDelegate(this);
+
+    return CHIP_NO_ERROR;
+}
+
+void ClientSubscriptionManager::RemoveSubscription(ReadClient & aReadClient)
+{
+    auto it = mSubscriptions.find(&aReadClient);
+    VerifyOrReturn(it != mSubscriptions.end());
+
+    Subscription & subscription = it->second;
+    aReadClient.SetTimerDelegate(nullptr);
+
+    if (subscription.mLivenessTimer.IsScheduled())
+    {
+        HandOverTimer(subscription.mLivenessCallback, subscription.mLivenessTimer.GetDeadline(), &aReadClient);
+    }
+
+    if (subscription.mResubscribeTimer.IsScheduled())
+    {
+        // A queued re-subscription is already due.
+        System::Clock::Timestamp deadline = subscription.mResubscribeQueued ? System::SystemClock().GetMonotonicTimestamp()
+                                                                            : subscription.mResubscribeTimer.GetDeadline();
+        HandOverTimer(subscription.mResubscribeCallback, deadline, &aReadClient);
+        CancelResubscribe(subscription);
+    }
+
+    mSubscriptions.erase(it);
+}
+
+void ClientSubscriptionManager::HandOverTimer(System::TimerCompleteCallback aCallback, System::Clock::Timestamp aDeadline,
+                                              ReadClient * apReadClient)
+{
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    System::Clock::Timeout delay = aDeadline > now ? System::Clock::Timeout(aDeadline - now) : System::Clock::kZero;
+
+    CHIP_ERROR err = mpSystemLayer->StartTimer(delay, aCallback, apReadClient);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to hand over subscription timer of ReadClient[%p]: %" CHIP_ERROR_FORMAT, apReadClient,
+                     err.Format());
+    }
+}
+
+CHIP_ERROR ClientSubscriptionManager::Subscribe(ClusterStateCache & aCache, ReadPrepareParams && aParams, Priority aPriority,
+                                                Platform::UniquePtr<ReadClient> & aReadClient)
+{
+    VerifyOrReturnError(mpImEngine != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // With no DataVersion filters in the parameters, the ReadClient gets the filters from the cache, for the clusters whose
+    // data is cached, each time it subscribes.
+    VerifyOrReturnError(aParams.mDataVersionFilterListSize == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    auto readClient = Platform::MakeUnique<ReadClient>(mpImEngine, mpImEngine->GetExchangeManager(), aCache.GetBufferedCallback(),
+                                                       ReadClient::InteractionType::Subscribe);
+    VerifyOrReturnError(readClient, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(AddSubscription(*readClient, aPriority, &aCache));
+    ReturnErrorOnFailure(readClient->SendAutoResubscribeRequest(std::move(aParams)));
+
+    aReadClient = std::move(readClient);
+    return CHIP_NO_ERROR;
+}
+
+void ClientSubscriptionManager::GetMetrics(Metrics & aMetrics) const
+{
+    aMetrics                             = mMetrics;
+    aMetrics.mSubscriptionCount          = mSubscriptions.size();
+    aMetrics.mQueuedResubscriptionCount  = mQueuedCount;
+    aMetrics.mActiveSubscriptionCount    = 0;
+    aMetrics.mPendingResubscriptionCount = 0;
+    aMetrics.mCachedClusterCount         = 0;
+    aMetrics.mCachedAttributeCount       = 0;
+    aMetrics.mCacheBytes                 = 0;
+
+    for (const auto & entry : mSubscriptions)
+    {
+        const Subscription & subscription = entry.second;
+
+        if (subscription.mLivenessTimer.IsScheduled())
+        {
+            aMetrics.mActiveSubscriptionCount++;
+        }
+
+        if (subscription.mResubscribeTimer.IsScheduled())
+        {
+            aMetrics.mPendingResubscriptionCount++;
+        }
+
+        if (subscription.mpCache != nullptr)
+        {
+            ClusterStateCache::MemoryUsage usage;
+            subscription.mpCache->GetMemoryUsage(usage);
+            aMetrics.mCachedClusterCount += usage.mClusterCount;
+            aMetrics.mCachedAttributeCount += usage.mAttributeCount;
+            aMetrics.mCacheBytes += usage.mTotalBytes;
+        }
+    }
+}
+
+ClientSubscriptionManager::Subscription * ClientSubscriptionManager::FindSubscription(ReadClient * apReadClient)
+{
+    auto it = mSubscriptions.find(apReadClient);
+    return it == mSubscriptions.end() ? nullptr : &it->second;
+}
+
+CHIP_ERROR ClientSubscriptionManager::StartLivenessTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                                         System::TimerCompleteCallback aCallback)
+{
+    Subscription * subscription = FindSubscription(apReadClient);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    subscription->mLivenessCallback = aCallback;
+    mWheel->Schedule(subscription->mLivenessTimer, System::SystemClock().GetMonotonicTimestamp() + aTimeout);
+    StartTickTimer();
+
+    return CHIP_NO_ERROR;
+}
+
+void ClientSubscriptionManager::CancelLivenessTimer(ReadClient * apReadClient)
+{
+    Subscription * subscription = FindSubscription(apReadClient);
+    VerifyOrReturn(subscription != nullptr);
+
+    mWheel->Cancel(subscription->mLivenessTimer);
+}
+
+CHIP_ERROR ClientSubscriptionManager::StartResubscribeTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                                            System::TimerCompleteCallback aCallback)
+{
+    Subscription * subscription = FindSubscription(apReadClient);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    CancelResubscribe(*subscription);
+    subscription->mResubscribeCallback = aCallback;
+
+    if (aTimeout == System::Clock::kZero)
+    {
+        // The re-subscription is requested right away, e.g. because a session was just established for it: only hold it
+        // for the rate limiter.  Dispatching it from a timer keeps it from re-entering the ReadClient scheduling it.
+        QueueResubscribe(*subscription);
+        StartDispatchTimer(System::Clock::kZero);
+        return CHIP_NO_ERROR;
+    }
+
+    // Spread out the re-subscriptions of subscriptions dropped at the same time.
+    uint32_t jitterMs = mConfig.mResubscribeJitter.count();
+    if (jitterMs > 0)
+    {
+        jitterMs = Crypto::GetRandU32() % (jitterMs + 1);
+    }
+
+    mWheel->Schedule(subscription->mResubscribeTimer,
+                     System::SystemClock().GetMonotonicTimestamp() + aTimeout + System::Clock::Milliseconds32(jitterMs));
+    StartTickTimer();
+
+    return CHIP_NO_ERROR;
+}
+
+void ClientSubscriptionManager::CancelResubscribeTimer(ReadClient * apReadClient)
+{
+    Subscription * subscription = FindSubscription(apReadClient);
+    VerifyOrReturn(subscription != nullptr);
+
+    CancelResubscribe(*subscription);
+}
+
+void ClientSubscriptionManager::CancelResubscribe(Subscription & aSubscription)
+{
+    if (aSubscription.mResubscribeQueued)
+    {
+        aSubscription.mResubscribeQueued = false;
+        mQueuedCount--;
+    }
+    aSubscription.mResubscribeTimer.Unlink();
+}
+
+void ClientSubscriptionManager::QueueResubscribe(Subscription & aSubscription)
+{
+    aSubscription.mResubscribeTimer.Unlink();
+    mReadyQueues[to_underlying(aSubscription.mPriority)].PushBack(&aSubscription.mResubscribeTimer);
+
+    if (!aSubscription.mResubscribeQueued)
+    {
+        aSubscription.mResubscribeQueued = true;
+        mQueuedCount++;
+    }
+    aSubscription.mQueuedGeneration = mRateLimitGeneration;
+
+    mMetrics.mMaxQueuedResubscriptionCount = std::max(mMetrics.mMaxQueuedResubscriptionCount, mQueuedCount);
+}
+
+void ClientSubscriptionManager::DispatchResubscribes()
+{
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    for (size_t priority = kPriorityCount; priority > 0; priority--)
+    {
+        ReadyQueue & queue = mReadyQueues[priority - 1];
+
+        while (!queue.Empty())
+        {
+            System::Clock::Milliseconds32 wait;
+            if (!mRateLimiter.TryAcquire(now, wait))
+            {
+                mRateLimitGeneration++;
+                StartDispatchTimer(wait);
+                return;
+            }
+
+            Subscription & subscription = *static_cast<Subscription *>(queue.begin()->GetContext());
+            CancelResubscribe(subscription);
+
+            if (subscription.mQueuedGeneration != mRateLimitGeneration)
+            {
+                mMetrics.mRateLimitedResubscribeCount++;
+            }
+            mMetrics.mResubscribeAttemptCount++;
+
+            // This may destroy the ReadClient, or schedule any re-subscription.
+            subscription.mResubscribeCallback(mpSystemLayer, subscription.mpReadClient);
+        }
+    }
+}
+
+void ClientSubscriptionManager::StartTickTimer()
+{
+    VerifyOrReturn(!mTickTimerStarted);
+
+    CHIP_ERROR err = mpSystemLayer->StartTimer(mConfig.mTickInterval, OnTick, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to start subscription timer wheel: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mTickTimerStarted = true;
+}
+
+void ClientSubscriptionManager::StartDispatchTimer(System::Clock::Milliseconds32 aDelay)
+{
+    // Restarting the timer replaces any dispatch already scheduled.
+    CHIP_ERROR err = mpSystemLayer->StartTimer(aDelay, OnDispatch, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule re-subscriptions: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void ClientSubscriptionManager::OnLivenessTimerExpired(SubscriptionTimerWheel::Timer & aTimer, void * apContext)
+{
+    Subscription * subscription         = static_cast<Subscription *>(apContext);
+    ClientSubscriptionManager * manager = subscription->mpManager;
+
+    manager->mMetrics.mLivenessTimeoutCount++;
+
+    // This may destroy the ReadClient, and the subscription with it.
+    subscription->mLivenessCallback(manager->mpSystemLayer, subscription->mpReadClient);
+}
+
+void ClientSubscriptionManager::OnResubscribeTimerExpired(SubscriptionTimerWheel::Timer & aTimer, void * apContext)
+{
+    Subscription * subscription = static_cast<Subscription *>(apContext);
+
+    // The re-subscription is dispatched after the wheel is done advancing.
+    subscription->mpManager->QueueResubscribe(*subscription);
+}
+
+void ClientSubscriptionManager::OnTick(System::Layer * apSystemLayer, void * apAppState)
+{
+    ClientSubscriptionManager * const _this = static_cast<ClientSubscriptionManager *>(apAppState);
+
+    _this->mTickTimerStarted = false;
+    _this->mWheel->Advance(System::SystemClock().GetMonotonicTimestamp());
+    _this->DispatchResubscribes();
+
+    if (!_this->mWheel->IsEmpty())
+    {
+        _this->StartTickTimer();
+    }
+}
+
+void ClientSubscriptionManager::OnDispatch(System::Layer * apSystemLayer, void * apAppState)
+{
+    static_cast<ClientSubscriptionManager *>(apAppState)->DispatchResubscribes();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,276 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ClusterStateCache.h>
+#include <app/ReadClient.h>
+#include <app/ReadPrepareParams.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/IntrusiveList.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+class InteractionModelEngine;
+
+/*
+ * Hashed timing wheel holding many timers with a single tick.  Deadlines are rounded up to the next tick, so timers
+ * never expire early but may expire up to one tick late.  Starting and cancelling a timer takes constant time.
+ */
+class SubscriptionTimerWheel
+{
+public:
+    class Timer : public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>
+    {
+    public:
+        using Callback = void (*)(Timer & aTimer, void * apContext);
+
+        void Init(Callback aCallback, void * apContext)
+        {
+            mCallback = aCallback;
+            mpContext = apContext;
+        }
+
+        bool IsScheduled() const { return IsInList(); }
+        void * GetContext() const { return mpContext; }
+        System::Clock::Timestamp GetDeadline() const { return mDeadline; }
+
+    private:
+        friend class SubscriptionTimerWheel;
+
+        Callback mCallback     = nullptr;
+        void * mpContext       = nullptr;
+        uint64_t mDeadlineTick = 0;
+        System::Clock::Timestamp mDeadline;
+    };
+
+    SubscriptionTimerWheel(System::Clock::Milliseconds32 aTickInterval, size_t aSlotCount);
+    ~SubscriptionTimerWheel();
+
+    System::Clock::Milliseconds32 GetTickInterval() const { return mTickInterval; }
+
+    /*
+     * Schedule aTimer to expire at aDeadline, rescheduling it if it is already scheduled.
+     */
+    void Schedule(Timer & aTimer, System::Clock::Timestamp aDeadline);
+    void Cancel(Timer & aTimer) { aTimer.Unlink(); }
+
+    /*
+     * Expire all the timers whose deadline is at or before aNow, in no particular order.  The callbacks may schedule and
+     * cancel timers, including the ones about to expire.
+     */
+    void Advance(System::Clock::Timestamp aNow);
+
+    bool IsEmpty() const;
+
+private:
+    using TimerList = IntrusiveList<Timer, IntrusiveMode::AutoUnlink>;
+
+    uint64_t ToTick(System::Clock::Timestamp aTime) const { return aTime.count() / mTickInterval.count(); }
+
+    System::Clock::Milliseconds32 mTickInterval;
+    std::vector<TimerList> mSlots;
+    TimerList mExpired;
+    uint64_t mCurrentTick = 0; // Last tick processed by Advance.
+};
+
+/*
+ * Token bucket limiting the rate at which re-subscriptions are started.
+ */
+class ResubscribeRateLimiter
+{
+public:
+    /*
+     * Allow aRatePerSecond re-subscriptions per second on average, and up to aBurst re-subscriptions at once.
+     */
+    void Init(uint32_t aRatePerSecond, uint32_t aBurst, System::Clock::Timestamp aNow);
+
+    /*
+     * Take a token if one is available at aNow.  Otherwise, aWait is set to the time until one becomes available.
+     */
+    bool TryAcquire(System::Clock::Timestamp aNow, System::Clock::Milliseconds32 & aWait);
+
+private:
+    static constexpr uint64_t kMilliTokensPerToken = 1000;
+
+    void Refill(System::Clock::Timestamp aNow);
+
+    uint32_t mRatePerSecond  = 1;
+    uint64_t mMaxMilliTokens = kMilliTokensPerToken;
+    uint64_t mMilliTokens    = kMilliTokensPerToken;
+    System::Clock::Timestamp mLastRefill;
+};
+
+/*
+ * Controller-side manager of the subscriptions to many nodes.
+ *
+ * The manager serves as the ReadClient::TimerDelegate of the subscriptions added to it:
+ *
+ *   - The liveness and re-subscription timers of all the subscriptions are held by a single timer wheel driven by one
+ *     System::Layer timer, instead of a System::Layer timer per subscription and per timer.
+ *
+ *   - Re-subscriptions are jittered and go through a rate limiter shared by all the subscriptions, so that the
+ *     subscriptions dropped by an outage do not all try to re-subscribe at once.  Re-subscriptions waiting for the rate
+ *     limiter are started in order of subscription priority.
+ *
+ *   - Counters and the memory used by the attached ClusterStateCaches are consolidated in Metrics.
+ *
+ * A subscription established through a ClusterStateCache re-subscribes with DataVersion filters for the clusters and the
+ * highest event number it already holds, so that publishers only report what changed while the subscription was down.
+ * Subscribe() sets up such a subscription.
+ *
+ * The manager must only be used from the Matter thread.
+ */
+class ClientSubscriptionManager : public ReadClient::TimerDelegate
+{
+public:
+    enum class Priority : uint8_t
+    {
+        kLow,
+        kNormal,
+        kHigh,
+    };
+
+    struct Config
+    {
+        System::Clock::Milliseconds32 mTickInterval = System::Clock::Milliseconds32(1000);
+        // Number of slots of the timer wheel.  Timers further away than mWheelSlots ticks take several turns of the wheel.
+        size_t mWheelSlots = 512;
+        // Upper bound of the random delay added to each scheduled re-subscription.
+        System::Clock::Milliseconds32 mResubscribeJitter = System::Clock::Milliseconds32(5000);
+        uint32_t mResubscribeRatePerSecond               = 10;
+        uint32_t mResubscribeBurst                       = 20;
+    };
+
+    struct Metrics
+    {
+        size_t mSubscriptionCount             = 0; ///< Subscriptions added to the manager.
+        size_t mActiveSubscriptionCount       = 0; ///< Subscriptions with a liveness timer, i.e. established.
+        size_t mPendingResubscriptionCount    = 0; ///< Subscriptions waiting to re-subscribe.
+        size_t mQueuedResubscriptionCount     = 0; ///< Of which waiting for the rate limiter.
+        size_t mMaxQueuedResubscriptionCount  = 0;
+        uint64_t mLivenessTimeoutCount        = 0;
+        uint64_t mResubscribeAttemptCount     = 0;
+        uint64_t mRateLimitedResubscribeCount = 0; ///< Re-subscriptions started later than due because of the rate limit.
+        size_t mCachedClusterCount            = 0; ///< Totals over the attached ClusterStateCaches.
+        size_t mCachedAttributeCount          = 0;
+        size_t mCacheBytes                    = 0;
+    };
+
+    ClientSubscriptionManager() = default;
+    ~ClientSubscriptionManager() override;
+
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine) { return Init(apImEngine, Config()); }
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine, const Config & aConfig);
+
+    /*
+     * Stop managing all the subscriptions, see RemoveSubscription.
+     */
+    void Shutdown();
+
+    /*
+     * Manage the timers of the subscription of aReadClient, which must not have been requested yet.  If apCache is
+     * provided, it is the ClusterStateCache holding the data of the subscription, and is accounted for in the metrics.
+     */
+    CHIP_ERROR AddSubscription(ReadClient & aReadClient, Priority aPriority = Priority::kNormal,
+                               ClusterStateCache * apCache = nullptr);
+
+    /*
+     * Stop managing the subscription of aReadClient.  Its pending timers are handed over to System::Layer, as if aReadClient
+     * had started them itself.  Destroying a ReadClient removes it implicitly.
+     */
+    void RemoveSubscription(ReadClient & aReadClient);
+
+    /*
+     * Subscribe through aCache with automatic re-subscription, the subscription being managed with priority aPriority.
+     * aParams must not hold DataVersion filters so that the ones of aCache are used when re-subscribing.
+     *
+     * On success, aReadClient holds the ReadClient of the subscription, which the caller owns.
+     */
+    CHIP_ERROR Subscribe(ClusterStateCache & aCache, ReadPrepareParams && aParams, Priority aPriority,
+                         Platform::UniquePtr<ReadClient> & aReadClient);
+
+    void GetMetrics(Metrics & aMetrics) const;
+
+    // ReadClient::TimerDelegate
+    CHIP_ERROR StartLivenessTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                  System::TimerCompleteCallback aCallback) override;
+    void CancelLivenessTimer(ReadClient * apReadClient) override;
+    CHIP_ERROR StartResubscribeTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                     System::TimerCompleteCallback aCallback) override;
+    void CancelResubscribeTimer(ReadClient * apReadClient) override;
+    void OnReadClientDestroyed(ReadClient * apReadClient) override { RemoveSubscription(*apReadClient); }
+
+private:
+    static constexpr size_t kPriorityCount = 3;
+
+    struct Subscription
+    {
+        ReadClient * mpReadClient                          = nullptr;
+        ClientSubscriptionManager * mpManager              = nullptr;
+        ClusterStateCache * mpCache                        = nullptr;
+        Priority mPriority                                 = Priority::kNormal;
+        System::TimerCompleteCallback mLivenessCallback    = nullptr;
+        System::TimerCompleteCallback mResubscribeCallback = nullptr;
+        SubscriptionTimerWheel::Timer mLivenessTimer;
+        // Scheduled in the wheel until the re-subscription is due, then queued in mReadyQueues until the rate limiter lets
+        // it start.
+        SubscriptionTimerWheel::Timer mResubscribeTimer;
+        bool mResubscribeQueued = false;
+        // Value of mRateLimitGeneration when the re-subscription was queued.
+        uint32_t mQueuedGeneration = 0;
+    };
+
+    using ReadyQueue = IntrusiveList<SubscriptionTimerWheel::Timer, IntrusiveMode::AutoUnlink>;
+
+    Subscription * FindSubscription(ReadClient * apReadClient);
+    void CancelResubscribe(Subscription & aSubscription);
+    void QueueResubscribe(Subscription & aSubscription);
+    void StartTickTimer();
+    void StartDispatchTimer(System::Clock::Milliseconds32 aDelay);
+    void DispatchResubscribes();
+    void HandOverTimer(System::TimerCompleteCallback aCallback, System::Clock::Timestamp aDeadline, ReadClient * apReadClient);
+
+    static void OnLivenessTimerExpired(SubscriptionTimerWheel::Timer & aTimer, void * apContext);
+    static void OnResubscribeTimerExpired(SubscriptionTimerWheel::Timer & aTimer, void * apContext);
+    static void OnTick(System::Layer * apSystemLayer, void * apAppState);
+    static void OnDispatch(System::Layer * apSystemLayer, void * apAppState);
+
+    InteractionModelEngine * mpImEngine = nullptr;
+    System::Layer * mpSystemLayer       = nullptr;
+    Config mConfig;
+    Platform::UniquePtr<SubscriptionTimerWheel> mWheel;
+    ResubscribeRateLimiter mRateLimiter;
+    ReadyQueue mReadyQueues[kPriorityCount];
+    std::unordered_map<ReadClient *, Subscription> mSubscriptions;
+    size_t mQueuedCount = 0;
+    // Incremented whenever the rate limiter holds back a queued re-subscription.
+    uint32_t mRateLimitGeneration = 0;
+    bool mTickTimerStarted        = false;
+    Metrics mMetrics;
+};
+
+} // namespace app
+} // namespace chip
@@ -49,31 +49,31 @@ size_t SizeOfStatusIB(const StatusIB & aStatus)
 
 } // anonymous namespace
 
-CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
+CHIP_ERROR ClusterStateCache::CopyElement(TLV::TLVReader & aData, Platform::ScopedMemoryBuffer<uint8_t> & aBuffer, size_t & aSize)
 {
-    Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
-    reader.Init(*apData);
+    reader.Init(aData);
     size_t totalBufSize = reader.GetTotalLength();
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    aBuffer.Calloc(totalBufSize);
+    VerifyOrReturnError(aBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    TLV::ScopedBufferTLVWriter writer(std::move(aBuffer), totalBufSize);
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
     aSize = writer.GetLengthWritten();
-    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+    ReturnErrorOnFailure(writer.Finalize(aBuffer));
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
                                           const StatusIB & aStatus)
 {
-    AttributeState state;
+    ClusterStateCacheStorage::AttributeState state;
+    Platform::ScopedMemoryBuffer<uint8_t> elementBuffer;
     bool endpointIsNew = false;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    if (!mStorage.HasEndpoint(aPath.mEndpointId))
     {
         //
-        // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
+        // Since we might potentially be creating a new entry for aPath.mEndpointId and aPath.mClusterId that
         // wasn't there before, we need to check if an entry didn't exist there previously and remember that so that
         // we can appropriately notify our clients of the addition of a new endpoint.
         //
@@ -83,18 +83,11 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
     if (apData)
     {
         size_t elementSize = 0;
-        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+        ReturnErrorOnFailure(CopyElement(*apData, elementBuffer, elementSize));
 
         if (mCacheData)
         {
-            Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-            backingBuffer.Calloc(elementSize);
-            VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-
-            state.Set<AttributeData>(std::move(backingBuffer));
+            state.Set<ByteSpan>(elementBuffer.Get(), elementSize);
         }
         else
         {
@@ -104,7 +97,7 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // Clear out the committed data version and only set it again once we have received all data for this cluster.
         // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
         //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
+        mStorage.GetOrAddClusterVersions(aPath)->mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
@@ -125,7 +118,7 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            mStorage.GetOrAddClusterVersions(aPath)->mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
@@ -151,7 +144,7 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    ReturnErrorOnFailure(mStorage.SetAttribute(aPath, state));
 
     if (mCacheData)
     {
@@ -174,26 +167,10 @@ CHIP_ERROR ClusterStateCache::UpdateEventCache(const EventHeader & aEventHeader,
         }
         if (mCacheData)
         {
-            System::PacketBufferHandle handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
-            VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-            System::PacketBufferTLVWriter writer;
-            writer.Init(std::move(handle), false);
-
-            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-            ReturnErrorOnFailure(writer.Finalize(&handle));
-
-            //
-            // Compact the buffer down to a more reasonably sized packet buffer
-            // if we can.
-            //
-            handle.RightSize();
-
-            EventData eventData;
-            eventData.first  = aEventHeader;
-            eventData.second = std::move(handle);
-
-            mEventDataCache.insert(std::move(eventData));
+            Platform::ScopedMemoryBuffer<uint8_t> elementBuffer;
+            size_t elementSize = 0;
+            ReturnErrorOnFailure(CopyElement(*apData, elementBuffer, elementSize));
+            ReturnErrorOnFailure(mStorage.AddEvent(aEventHeader, ByteSpan(elementBuffer.Get(), elementSize)));
         }
         mHighestReceivedEventNumber.SetValue(aEventHeader.mEventNumber);
     }
@@ -223,11 +200,11 @@ void ClusterStateCache::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
-    if (lastClusterInfo.mPendingDataVersion.HasValue())
+    auto * lastClusterInfo = mStorage.GetOrAddClusterVersions(mLastReportDataPath);
+    if (lastClusterInfo->mPendingDataVersion.HasValue())
     {
-        lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
-        lastClusterInfo.mPendingDataVersion.ClearValue();
+        lastClusterInfo->mCommittedDataVersion = lastClusterInfo->mPendingDataVersion;
+        lastClusterInfo->mPendingDataVersion.ClearValue();
     }
 }
 
@@ -258,110 +235,38 @@ void ClusterStateCache::OnReportEnd()
     }
 
     mCallback.OnReportEnd();
+
+    // Values replaced during the report are only released now, so that no value read by the callbacks moves.
+    mStorage.Compact();
 }
 
 CHIP_ERROR ClusterStateCache::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
-    CHIP_ERROR err;
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
-    if (attributeState->Is<StatusIB>())
+    ClusterStateCacheStorage::AttributeState attributeState;
+    ReturnErrorOnFailure(mStorage.GetAttribute(path, attributeState));
+    if (attributeState.Is<StatusIB>())
     {
         return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
     }
 
-    if (!attributeState->Is<AttributeData>())
+    if (!attributeState.Is<ByteSpan>())
     {
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
 
-    reader.Init(attributeState->Get<AttributeData>().Get(), attributeState->Get<AttributeData>().AllocatedSize());
+    reader.Init(attributeState.Get<ByteSpan>());
     return reader.Next();
 }
 
 CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
 {
-    CHIP_ERROR err;
-
-    auto eventData = GetEventData(eventNumber, err);
-    ReturnErrorOnFailure(err);
-
-    System::PacketBufferTLVReader bufReader;
-
-    bufReader.Init(eventData->second.Retain());
-    ReturnErrorOnFailure(bufReader.Next());
-
-    reader.Init(bufReader);
-    return CHIP_NO_ERROR;
-}
-
-const ClusterStateCache::EndpointState * ClusterStateCache::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
-{
-    auto endpointIter = mCache.find(endpointId);
-    if (endpointIter == mCache.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &endpointIter->second;
-}
-
-const ClusterStateCache::ClusterState * ClusterStateCache::GetClusterState(EndpointId endpointId, ClusterId clusterId,
-                                                                           CHIP_ERROR & err) const
-{
-    auto endpointState = GetEndpointState(endpointId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
+    const EventHeader * eventHeader;
+    ByteSpan eventData;
 
-    auto clusterState = endpointState->find(clusterId);
-    if (clusterState == endpointState->end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
+    ReturnErrorOnFailure(mStorage.GetEvent(eventNumber, eventHeader, eventData));
 
-    err = CHIP_NO_ERROR;
-    return &clusterState->second;
-}
-
-const ClusterStateCache::AttributeState * ClusterStateCache::GetAttributeState(EndpointId endpointId, ClusterId clusterId,
-                                                                               AttributeId attributeId, CHIP_ERROR & err) const
-{
-    auto clusterState = GetClusterState(endpointId, clusterId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto attributeState = clusterState->mAttributes.find(attributeId);
-    if (attributeState == clusterState->mAttributes.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &attributeState->second;
-}
-
-const ClusterStateCache::EventData * ClusterStateCache::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
-{
-    EventData compareKey;
-
-    compareKey.first.mEventNumber = eventNumber;
-    auto eventData                = mEventDataCache.find(std::move(compareKey));
-    if (eventData == mEventDataCache.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &(*eventData);
+    reader.Init(eventData);
+    return reader.Next();
 }
 
 void ClusterStateCache::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus)
@@ -397,10 +302,9 @@ void ClusterStateCache::OnAttributeData(const ConcreteDataAttributePath & aPath,
 CHIP_ERROR ClusterStateCache::GetVersion(const ConcreteClusterPath & aPath, Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
-    CHIP_ERROR err;
-    auto clusterState = GetClusterState(aPath.mEndpointId, aPath.mClusterId, err);
-    ReturnErrorOnFailure(err);
-    aVersion = clusterState->mCommittedDataVersion;
+    auto clusterVersions = mStorage.GetClusterVersions(aPath);
+    VerifyOrReturnError(clusterVersions != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aVersion = clusterVersions->mCommittedDataVersion;
     return CHIP_NO_ERROR;
 }
 
@@ -420,17 +324,15 @@ void ClusterStateCache::OnEventData(const EventHeader & aEventHeader, TLV::TLVRe
 
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
-    CHIP_ERROR err;
-
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
+    ClusterStateCacheStorage::AttributeState attributeState;
+    ReturnErrorOnFailure(mStorage.GetAttribute(path, attributeState));
 
-    if (!attributeState->Is<StatusIB>())
+    if (!attributeState.Is<StatusIB>())
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
-    status = attributeState->Get<StatusIB>();
+    status = attributeState.Get<StatusIB>();
     return CHIP_NO_ERROR;
 }
 
@@ -448,56 +350,67 @@ CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB
 
 void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
-    for (auto const & endpointIter : mCache)
+    struct Context
     {
-        EndpointId endpointId = endpointIter.first;
-        for (auto const & clusterIter : endpointIter.second)
-        {
-            if (!clusterIter.second.mCommittedDataVersion.HasValue())
+        const ClusterStateCacheStorage & mStorage;
+        std::vector<std::pair<DataVersionFilter, size_t>> & mFilters;
+        size_t mClusterSize;
+    } context{ mStorage, aVector, 0 };
+
+    mStorage.ForEachCluster(
+        [](void * apContext, const ConcreteClusterPath & clusterPath) -> CHIP_ERROR {
+            auto * ctx           = static_cast<Context *>(apContext);
+            auto clusterVersions = ctx->mStorage.GetClusterVersions(clusterPath);
+            if (!clusterVersions->mCommittedDataVersion.HasValue())
             {
-                continue;
+                return CHIP_NO_ERROR;
             }
-            DataVersion dataVersion = clusterIter.second.mCommittedDataVersion.Value();
-            size_t clusterSize      = 0;
-            ClusterId clusterId     = clusterIter.first;
 
-            for (auto const & attributeIter : clusterIter.second.mAttributes)
-            {
-                if (attributeIter.second.Is<StatusIB>())
-                {
-                    clusterSize += SizeOfStatusIB(attributeIter.second.Get<StatusIB>());
-                }
-                else if (attributeIter.second.Is<size_t>())
-                {
-                    clusterSize += attributeIter.second.Get<size_t>();
-                }
-                else
-                {
-                    VerifyOrDie(attributeIter.second.Is<AttributeData>());
-                    TLV::TLVReader bufReader;
-                    bufReader.Init(attributeIter.second.Get<AttributeData>().Get(),
-                                   attributeIter.second.Get<AttributeData>().AllocatedSize());
-                    ReturnOnFailure(bufReader.Next());
-                    // Skip to the end of the element.
-                    ReturnOnFailure(bufReader.Skip());
-
-                    // Compute the amount of value data
-                    clusterSize += bufReader.GetLengthRead();
-                }
-            }
-
-            if (clusterSize == 0)
+            ctx->mClusterSize = 0;
+            CHIP_ERROR err    = ctx->mStorage.ForEachAttribute(
+                clusterPath,
+                [](void * apAttributeContext, const ConcreteAttributePath &,
+                   const ClusterStateCacheStorage::AttributeState & attributeState) -> CHIP_ERROR {
+                    auto * attributeCtx = static_cast<Context *>(apAttributeContext);
+                    if (attributeState.Is<StatusIB>())
+                    {
+                        attributeCtx->mClusterSize += SizeOfStatusIB(attributeState.Get<StatusIB>());
+                    }
+                    else if (attributeState.Is<size_t>())
+                    {
+                        attributeCtx->mClusterSize += attributeState.Get<size_t>();
+                    }
+                    else
+                    {
+                        VerifyOrDie(attributeState.Is<ByteSpan>());
+                        TLV::TLVReader bufReader;
+                        bufReader.Init(attributeState.Get<ByteSpan>());
+                        ReturnErrorOnFailure(bufReader.Next());
+                        // Skip to the end of the element.
+                        ReturnErrorOnFailure(bufReader.Skip());
+
+                        // Compute the amount of value data
+                        attributeCtx->mClusterSize += bufReader.GetLengthRead();
+                    }
+                    return CHIP_NO_ERROR;
+                },
+                apContext);
+            ReturnErrorOnFailure(err);
+
+            if (ctx->mClusterSize == 0)
             {
                 // No data in this cluster, so no point in sending a dataVersion
                 // along at all.
-                continue;
+                return CHIP_NO_ERROR;
             }
 
-            DataVersionFilter filter(endpointId, clusterId, dataVersion);
+            DataVersionFilter filter(clusterPath.mEndpointId, clusterPath.mClusterId,
+                                     clusterVersions->mCommittedDataVersion.Value());
 
-            aVector.push_back(std::make_pair(filter, clusterSize));
-        }
-    }
+            ctx->mFilters.push_back(std::make_pair(filter, ctx->mClusterSize));
+            return CHIP_NO_ERROR;
+        },
+        &context);
 
     std::sort(aVector.begin(), aVector.end(),
               [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
@@ -23,6 +23,7 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/ClusterStateCacheStorage.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -59,6 +60,10 @@ namespace app {
  * through to a registered callback. In addition, it provides its own enhancements to the base ReadClient::Callback
  * to make it easier to know what has changed in the cache.
  *
+ * The attributes and events can either be kept in nested maps (StorageMode::kMaps), or in sorted vectors with the
+ * TLV packed into arenas (StorageMode::kFlat), which is better suited to caching whole nodes; see
+ * ClusterStateCacheStorage.
+ *
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
@@ -86,6 +91,14 @@ public:
         virtual void OnEndpointAdded(ClusterStateCache * cache, EndpointId endpointId){};
     };
 
+    enum class StorageMode : uint8_t
+    {
+        kMaps, // MapClusterStateCacheStorage
+        kFlat, // FlatClusterStateCacheStorage
+    };
+
+    using MemoryUsage = ClusterStateCacheStorage::MemoryUsage;
+
     /**
      *
      * @param [in] callback the derived callback which inherit from ReadClient::Callback
@@ -93,10 +106,13 @@ public:
      *             less than or equal to this value, skip those events
      * @param [in] cacheData boolean to decide whether this cache would store attribute/event data/status,
      *             the default is true.
+     * @param [in] storageMode how the attributes and events are laid out in memory, the default is StorageMode::kMaps.
      */
     ClusterStateCache(Callback & callback, Optional<EventNumber> highestReceivedEventNumber = Optional<EventNumber>::Missing(),
-                      bool cacheData = true) :
+                      bool cacheData = true, StorageMode storageMode = StorageMode::kMaps) :
         mCallback(callback),
+        mStorage(storageMode == StorageMode::kFlat ? static_cast<ClusterStateCacheStorage &>(mFlatStorage)
+                                                   : static_cast<ClusterStateCacheStorage &>(mMapStorage)),
         mBufferedReader(*this), mCacheData(cacheData)
     {
         mHighestReceivedEventNumber = highestReceivedEventNumber;
@@ -120,8 +136,8 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * valid until the cached value for that path is updated (or, with StorageMode::kFlat, until the end of the
+     * next report, which may compact the cache), so it must not be held across any async call boundaries.
      *
      * The template parameter AttributeObjectTypeT is generally expected to be a
      * ClusterName::Attributes::AttributeName::DecodableType, but any
@@ -285,12 +301,12 @@ public:
     CHIP_ERROR Get(EventNumber eventNumber, EventObjectTypeT & value) const
     {
         TLV::TLVReader reader;
-        CHIP_ERROR err;
+        const EventHeader * eventHeader;
+        ByteSpan eventData;
 
-        auto * eventData = GetEventData(eventNumber, err);
-        ReturnErrorOnFailure(err);
+        ReturnErrorOnFailure(mStorage.GetEvent(eventNumber, eventHeader, eventData));
 
-        if (eventData->first.mPath.mClusterId != value.GetClusterId() || eventData->first.mPath.mEventId != value.GetEventId())
+        if (eventHeader->mPath.mClusterId != value.GetClusterId() || eventHeader->mPath.mEventId != value.GetEventId())
         {
             return CHIP_ERROR_SCHEMA_MISMATCH;
         }
@@ -340,18 +356,7 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
-        CHIP_ERROR err;
-
-        auto clusterState = GetClusterState(endpointId, clusterId, err);
-        ReturnErrorOnFailure(err);
-
-        for (auto & attributeIter : clusterState->mAttributes)
-        {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
-            ReturnErrorOnFailure(func(path));
-        }
-
-        return CHIP_NO_ERROR;
+        return ForEachAttributeInCluster(ConcreteClusterPath(endpointId, clusterId), func);
     }
 
     /*
@@ -370,21 +375,23 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
+        struct Context
         {
-            for (auto & clusterIter : endpointIter.second)
-            {
-                if (clusterIter.first == clusterId)
+            const ClusterStateCache * mCache;
+            ClusterId mClusterId;
+            IteratorFunc * mFunc;
+        } context{ this, clusterId, &func };
+
+        return mStorage.ForEachCluster(
+            [](void * apContext, const ConcreteClusterPath & clusterPath) -> CHIP_ERROR {
+                auto * ctx = static_cast<Context *>(apContext);
+                if (clusterPath.mClusterId != ctx->mClusterId)
                 {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
+                    return CHIP_NO_ERROR;
                 }
-            }
-        }
-        return CHIP_NO_ERROR;
+                return ctx->mCache->ForEachAttributeInCluster(clusterPath, *ctx->mFunc);
+            },
+            &context);
     }
 
     /*
@@ -403,15 +410,22 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        struct Context
         {
-            for (auto & clusterIter : endpointIter->second)
-            {
-                ReturnErrorOnFailure(func(clusterIter.first));
-            }
-        }
-        return CHIP_NO_ERROR;
+            EndpointId mEndpointId;
+            IteratorFunc * mFunc;
+        } context{ endpointId, &func };
+
+        return mStorage.ForEachCluster(
+            [](void * apContext, const ConcreteClusterPath & clusterPath) -> CHIP_ERROR {
+                auto * ctx = static_cast<Context *>(apContext);
+                if (clusterPath.mEndpointId != ctx->mEndpointId)
+                {
+                    return CHIP_NO_ERROR;
+                }
+                return (*ctx->mFunc)(clusterPath.mClusterId);
+            },
+            &context);
     }
 
     /*
@@ -439,15 +453,24 @@ public:
     CHIP_ERROR ForEachEventData(IteratorFunc func, EventPathParams pathFilter = EventPathParams(),
                                 EventNumber minEventNumberFilter = 0) const
     {
-        for (const auto & item : mEventDataCache)
+        struct Context
         {
-            if (pathFilter.IsEventPathSupersetOf(item.first.mPath) && item.first.mEventNumber >= minEventNumberFilter)
-            {
-                ReturnErrorOnFailure(func(item.first));
-            }
-        }
-
-        return CHIP_NO_ERROR;
+            const EventPathParams & mPathFilter;
+            EventNumber mMinEventNumberFilter;
+            IteratorFunc * mFunc;
+        } context{ pathFilter, minEventNumberFilter, &func };
+
+        return mStorage.ForEachEvent(
+            [](void * apContext, const EventHeader & eventHeader) -> CHIP_ERROR {
+                auto * ctx = static_cast<Context *>(apContext);
+                if (!ctx->mPathFilter.IsEventPathSupersetOf(eventHeader.mPath) ||
+                    eventHeader.mEventNumber < ctx->mMinEventNumberFilter)
+                {
+                    return CHIP_NO_ERROR;
+                }
+                return (*ctx->mFunc)(eventHeader);
+            },
+            &context);
     }
 
     /*
@@ -484,7 +507,7 @@ public:
      */
     void ClearEventCache(bool resetTrackedEventCounters = false)
     {
-        mEventDataCache.clear();
+        mStorage.ClearEvents();
         if (resetTrackedEventCounters)
         {
             mHighestReceivedEventNumber.ClearValue();
@@ -499,31 +522,12 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
-private:
-    // An attribute state can be one of three things:
-    // * If we got a path-specific error for the attribute, the corresponding
-    //   status.
-    // * If we got data for the attribute and we are storing data ourselves, the
-    //   data.
-    // * If we got data for the attribute and we are not storing data
-    //   oureselves, the size of the data, so we can still prioritize sending
-    //   DataVersions correctly.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
-    using AttributeState = Variant<StatusIB, AttributeData, size_t>;
-    // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
-    //
-    // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
-    // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
-    // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
-    {
-        std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
-    };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    /*
+     * Get the amount of memory held by the cached attributes and events.
+     */
+    void GetMemoryUsage(MemoryUsage & aUsage) const { mStorage.GetMemoryUsage(aUsage); }
 
+private:
     struct Comparator
     {
         bool operator()(const AttributePathParams & x, const AttributePathParams & y) const
@@ -532,38 +536,16 @@ private:
         }
     };
 
-    using EventData = std::pair<EventHeader, System::PacketBufferHandle>;
-
-    //
-    // This is a custom comparator for use with the std::set<EventData> below. Uniqueness
-    // is determined solely by the event number associated with each event.
-    //
-    struct EventDataCompare
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttributeInCluster(const ConcreteClusterPath & clusterPath, IteratorFunc & func) const
     {
-        bool operator()(const EventData & lhs, const EventData & rhs) const
-        {
-            return (lhs.first.mEventNumber < rhs.first.mEventNumber);
-        }
-    };
-
-    /*
-     * These functions provide a way to index into the cached state with different sub-sets of a path, returning
-     * appropriate slices of the data as requested.
-     *
-     * In all variants, the respective slice is returned if a valid path is provided. 'err' is updated to reflect
-     * the status of the operation.
-     *
-     * Notable status values:
-     *      - If a cluster instance corresponding to endpointId and clusterId doesn't exist in the cache,
-     *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
-     *
-     */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
-    const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
-    const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                             CHIP_ERROR & err) const;
-
-    const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
+        return mStorage.ForEachAttribute(
+            clusterPath,
+            [](void * apContext, const ConcreteAttributePath & path, const ClusterStateCacheStorage::AttributeState &) -> CHIP_ERROR {
+                return (*static_cast<IteratorFunc *>(apContext))(path);
+            },
+            &func);
+    }
 
     /*
      * Updates the state of an attribute in the cache given a reader. If the reader is null, the state is updated
@@ -628,15 +610,17 @@ private:
     // on the wire if not all filters can be applied.
     void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
 
-    CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
+    // Copy the element the reader is positioned on into aBuffer, setting aSize to the length of its TLV encoding.
+    CHIP_ERROR CopyElement(TLV::TLVReader & aData, Platform::ScopedMemoryBuffer<uint8_t> & aBuffer, size_t & aSize);
 
     Callback & mCallback;
-    NodeState mCache;
+    MapClusterStateCacheStorage mMapStorage;
+    FlatClusterStateCacheStorage mFlatStorage;
+    ClusterStateCacheStorage & mStorage;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
 
-    std::set<EventData, EventDataCompare> mEventDataCache;
     Optional<EventNumber> mHighestReceivedEventNumber;
     std::map<ConcreteEventPath, StatusIB> mEventStatusCache;
     BufferedReadCallback mBufferedReader;
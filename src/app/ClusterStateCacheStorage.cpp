@@ -0,0 +1,532 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClusterStateCacheStorage.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Rough bookkeeping costs of the heap, used to estimate the memory held by the storage.
+constexpr size_t kHeapAllocationOverhead = 2 * sizeof(void *);
+constexpr size_t kMapNodeOverhead        = 4 * sizeof(void *) + kHeapAllocationOverhead;
+
+template <typename T>
+size_t VectorBytes(const std::vector<T> & aVector)
+{
+    return (aVector.capacity() == 0) ? 0 : aVector.capacity() * sizeof(T) + kHeapAllocationOverhead;
+}
+
+} // anonymous namespace
+
+//
+// MapClusterStateCacheStorage
+//
+
+bool MapClusterStateCacheStorage::HasEndpoint(EndpointId aEndpointId) const
+{
+    return mCache.find(aEndpointId) != mCache.end();
+}
+
+const MapClusterStateCacheStorage::ClusterState *
+MapClusterStateCacheStorage::GetClusterState(const ConcreteClusterPath & aPath) const
+{
+    auto endpointIter = mCache.find(aPath.mEndpointId);
+    if (endpointIter == mCache.end())
+    {
+        return nullptr;
+    }
+
+    auto clusterIter = endpointIter->second.find(aPath.mClusterId);
+    if (clusterIter == endpointIter->second.end())
+    {
+        return nullptr;
+    }
+
+    return &clusterIter->second;
+}
+
+const ClusterStateCacheStorage::ClusterVersions *
+MapClusterStateCacheStorage::GetClusterVersions(const ConcreteClusterPath & aPath) const
+{
+    auto clusterState = GetClusterState(aPath);
+    return (clusterState != nullptr) ? &clusterState->mVersions : nullptr;
+}
+
+ClusterStateCacheStorage::ClusterVersions * MapClusterStateCacheStorage::GetOrAddClusterVersions(const ConcreteClusterPath & aPath)
+{
+    return &mCache[aPath.mEndpointId][aPath.mClusterId].mVersions;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::SetAttribute(const ConcreteAttributePath & aPath, const AttributeState & aState)
+{
+    StoredAttributeState state;
+
+    if (aState.Is<ByteSpan>())
+    {
+        const ByteSpan & data = aState.Get<ByteSpan>();
+        AttributeData backingBuffer;
+        backingBuffer.Calloc(data.size());
+        VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+        memcpy(backingBuffer.Get(), data.data(), data.size());
+        state.Set<AttributeData>(std::move(backingBuffer));
+    }
+    else if (aState.Is<StatusIB>())
+    {
+        state.Set<StatusIB>(aState.Get<StatusIB>());
+    }
+    else
+    {
+        state.Set<size_t>(aState.Get<size_t>());
+    }
+
+    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::GetAttribute(const ConcreteAttributePath & aPath, AttributeState & aState) const
+{
+    auto clusterState = GetClusterState(aPath);
+    VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    auto attributeIter = clusterState->mAttributes.find(aPath.mAttributeId);
+    VerifyOrReturnError(attributeIter != clusterState->mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    const StoredAttributeState & state = attributeIter->second;
+    if (state.Is<AttributeData>())
+    {
+        aState.Set<ByteSpan>(state.Get<AttributeData>().Get(), state.Get<AttributeData>().AllocatedSize());
+    }
+    else if (state.Is<StatusIB>())
+    {
+        aState.Set<StatusIB>(state.Get<StatusIB>());
+    }
+    else
+    {
+        aState.Set<size_t>(state.Get<size_t>());
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::ForEachCluster(ClusterHandler aHandler, void * apContext) const
+{
+    for (auto & endpointIter : mCache)
+    {
+        for (auto & clusterIter : endpointIter.second)
+        {
+            ReturnErrorOnFailure(aHandler(apContext, ConcreteClusterPath(endpointIter.first, clusterIter.first)));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::ForEachAttribute(const ConcreteClusterPath & aPath, AttributeHandler aHandler,
+                                                         void * apContext) const
+{
+    auto clusterState = GetClusterState(aPath);
+    VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    for (auto & attributeIter : clusterState->mAttributes)
+    {
+        const ConcreteAttributePath path(aPath.mEndpointId, aPath.mClusterId, attributeIter.first);
+        AttributeState state;
+        ReturnErrorOnFailure(GetAttribute(path, state));
+        ReturnErrorOnFailure(aHandler(apContext, path, state));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::AddEvent(const EventHeader & aHeader, const ByteSpan & aData)
+{
+    System::PacketBufferHandle handle = System::PacketBufferHandle::NewWithData(aData.data(), aData.size(), 0, 0);
+    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    EventData eventData;
+    eventData.first  = aHeader;
+    eventData.second = std::move(handle);
+
+    mEvents.insert(std::move(eventData));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::GetEvent(EventNumber aEventNumber, const EventHeader *& apHeader, ByteSpan & aData) const
+{
+    EventData compareKey;
+
+    compareKey.first.mEventNumber = aEventNumber;
+    auto eventIter                = mEvents.find(compareKey);
+    VerifyOrReturnError(eventIter != mEvents.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    apHeader = &eventIter->first;
+    aData    = ByteSpan(eventIter->second->Start(), eventIter->second->DataLength());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MapClusterStateCacheStorage::ForEachEvent(EventHandler aHandler, void * apContext) const
+{
+    for (const auto & item : mEvents)
+    {
+        ReturnErrorOnFailure(aHandler(apContext, item.first));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void MapClusterStateCacheStorage::GetMemoryUsage(MemoryUsage & aUsage) const
+{
+    aUsage = MemoryUsage();
+
+    for (auto & endpointIter : mCache)
+    {
+        aUsage.mTotalBytes += kMapNodeOverhead + sizeof(NodeState::value_type);
+        for (auto & clusterIter : endpointIter.second)
+        {
+            aUsage.mClusterCount++;
+            aUsage.mTotalBytes += kMapNodeOverhead + sizeof(EndpointState::value_type);
+            for (auto & attributeIter : clusterIter.second.mAttributes)
+            {
+                aUsage.mAttributeCount++;
+                aUsage.mTotalBytes += kMapNodeOverhead + sizeof(std::pair<const AttributeId, StoredAttributeState>);
+                if (attributeIter.second.Is<AttributeData>())
+                {
+                    size_t size = attributeIter.second.Get<AttributeData>().AllocatedSize();
+                    aUsage.mAttributeDataBytes += size;
+                    aUsage.mTotalBytes += size + kHeapAllocationOverhead;
+                }
+            }
+        }
+    }
+
+    for (const auto & item : mEvents)
+    {
+        aUsage.mEventCount++;
+        aUsage.mEventDataBytes += item.second->DataLength();
+        aUsage.mTotalBytes += kMapNodeOverhead + sizeof(EventData) + sizeof(System::PacketBuffer) +
+            item.second->AllocSize() + kHeapAllocationOverhead;
+    }
+}
+
+//
+// FlatClusterStateCacheStorage
+//
+
+uint8_t * FlatClusterStateCacheStorage::Arena::Allocate(size_t aSize)
+{
+    if (aSize > mChunkFree)
+    {
+        size_t chunkSize = std::max(kDefaultChunkSize, aSize);
+        Platform::ScopedMemoryBuffer<uint8_t> chunk;
+        VerifyOrReturnValue(chunk.Alloc(chunkSize), nullptr);
+        mChunks.push_back(std::move(chunk));
+        mChunkSize = chunkSize;
+        mChunkFree = chunkSize;
+        mAllocatedBytes += chunkSize;
+    }
+
+    uint8_t * allocation = mChunks.back().Get() + (mChunkSize - mChunkFree);
+    mChunkFree -= aSize;
+    mUsedBytes += aSize;
+    return allocation;
+}
+
+void FlatClusterStateCacheStorage::Arena::Clear()
+{
+    mChunks.clear();
+    mChunkFree      = 0;
+    mChunkSize      = 0;
+    mAllocatedBytes = 0;
+    mUsedBytes      = 0;
+}
+
+void FlatClusterStateCacheStorage::Arena::Swap(Arena & aOther)
+{
+    std::swap(mChunks, aOther.mChunks);
+    std::swap(mChunkFree, aOther.mChunkFree);
+    std::swap(mChunkSize, aOther.mChunkSize);
+    std::swap(mAllocatedBytes, aOther.mAllocatedBytes);
+    std::swap(mUsedBytes, aOther.mUsedBytes);
+}
+
+std::vector<FlatClusterStateCacheStorage::ClusterEntry>::iterator
+FlatClusterStateCacheStorage::ClusterLowerBound(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    return std::lower_bound(mClusters.begin(), mClusters.end(), std::make_pair(aEndpointId, aClusterId),
+                            [](const ClusterEntry & entry, const std::pair<EndpointId, ClusterId> & key) {
+                                return std::make_pair(entry.mEndpointId, entry.mClusterId) < key;
+                            });
+}
+
+FlatClusterStateCacheStorage::ClusterEntry * FlatClusterStateCacheStorage::FindCluster(const ConcreteClusterPath & aPath)
+{
+    auto clusterIter = ClusterLowerBound(aPath.mEndpointId, aPath.mClusterId);
+    if (clusterIter == mClusters.end() || clusterIter->mEndpointId != aPath.mEndpointId || clusterIter->mClusterId != aPath.mClusterId)
+    {
+        return nullptr;
+    }
+    return &*clusterIter;
+}
+
+const FlatClusterStateCacheStorage::ClusterEntry * FlatClusterStateCacheStorage::FindCluster(const ConcreteClusterPath & aPath) const
+{
+    return const_cast<FlatClusterStateCacheStorage *>(this)->FindCluster(aPath);
+}
+
+bool FlatClusterStateCacheStorage::HasEndpoint(EndpointId aEndpointId) const
+{
+    auto clusterIter = const_cast<FlatClusterStateCacheStorage *>(this)->ClusterLowerBound(aEndpointId, 0);
+    return clusterIter != mClusters.end() && clusterIter->mEndpointId == aEndpointId;
+}
+
+const ClusterStateCacheStorage::ClusterVersions *
+FlatClusterStateCacheStorage::GetClusterVersions(const ConcreteClusterPath & aPath) const
+{
+    auto cluster = FindCluster(aPath);
+    return (cluster != nullptr) ? &cluster->mVersions : nullptr;
+}
+
+ClusterStateCacheStorage::ClusterVersions * FlatClusterStateCacheStorage::GetOrAddClusterVersions(const ConcreteClusterPath & aPath)
+{
+    auto clusterIter = ClusterLowerBound(aPath.mEndpointId, aPath.mClusterId);
+    if (clusterIter == mClusters.end() || clusterIter->mEndpointId != aPath.mEndpointId || clusterIter->mClusterId != aPath.mClusterId)
+    {
+        ClusterEntry entry;
+        entry.mEndpointId = aPath.mEndpointId;
+        entry.mClusterId  = aPath.mClusterId;
+        clusterIter       = mClusters.insert(clusterIter, std::move(entry));
+    }
+    return &clusterIter->mVersions;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::SetAttribute(const ConcreteAttributePath & aPath, const AttributeState & aState)
+{
+    GetOrAddClusterVersions(aPath);
+    ClusterEntry * cluster = FindCluster(aPath);
+
+    auto & attributes  = cluster->mAttributes;
+    auto attributeIter = std::lower_bound(attributes.begin(), attributes.end(), aPath.mAttributeId,
+                                          [](const AttributeEntry & entry, AttributeId id) { return entry.mAttributeId < id; });
+    if (attributeIter == attributes.end() || attributeIter->mAttributeId != aPath.mAttributeId)
+    {
+        AttributeEntry entry;
+        entry.mAttributeId = aPath.mAttributeId;
+        entry.mKind        = AttributeKind::kSize;
+        entry.mpData       = nullptr;
+        entry.mLength      = 0;
+        attributeIter      = attributes.insert(attributeIter, entry);
+    }
+
+    AttributeEntry & entry = *attributeIter;
+    size_t oldDataLength   = (entry.mKind == AttributeKind::kData) ? entry.mLength : 0;
+
+    if (aState.Is<ByteSpan>())
+    {
+        const ByteSpan & data = aState.Get<ByteSpan>();
+        uint8_t * buffer      = nullptr;
+
+        // Values are often re-reported with the same size, so reuse the space of the previous value when it fits
+        // instead of growing the arena.
+        if (oldDataLength >= data.size())
+        {
+            buffer = const_cast<uint8_t *>(entry.mpData);
+        }
+        else
+        {
+            buffer = mAttributeArena.Allocate(data.size());
+            VerifyOrReturnError(buffer != nullptr, CHIP_ERROR_NO_MEMORY);
+        }
+
+        memmove(buffer, data.data(), data.size());
+        entry.mKind   = AttributeKind::kData;
+        entry.mpData  = buffer;
+        entry.mLength = data.size();
+    }
+    else if (aState.Is<StatusIB>())
+    {
+        entry.mKind   = AttributeKind::kStatus;
+        entry.mStatus = aState.Get<StatusIB>();
+        entry.mpData  = nullptr;
+        entry.mLength = 0;
+    }
+    else
+    {
+        entry.mKind   = AttributeKind::kSize;
+        entry.mpData  = nullptr;
+        entry.mLength = aState.Get<size_t>();
+    }
+
+    mLiveAttributeBytes -= oldDataLength;
+    mLiveAttributeBytes += (entry.mKind == AttributeKind::kData) ? entry.mLength : 0;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::GetAttribute(const ConcreteAttributePath & aPath, AttributeState & aState) const
+{
+    auto cluster = FindCluster(aPath);
+    VerifyOrReturnError(cluster != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    auto & attributes  = cluster->mAttributes;
+    auto attributeIter = std::lower_bound(attributes.begin(), attributes.end(), aPath.mAttributeId,
+                                          [](const AttributeEntry & entry, AttributeId id) { return entry.mAttributeId < id; });
+    VerifyOrReturnError(attributeIter != attributes.end() && attributeIter->mAttributeId == aPath.mAttributeId,
+                        CHIP_ERROR_KEY_NOT_FOUND);
+
+    switch (attributeIter->mKind)
+    {
+    case AttributeKind::kStatus:
+        aState.Set<StatusIB>(attributeIter->mStatus);
+        break;
+    case AttributeKind::kData:
+        aState.Set<ByteSpan>(attributeIter->mpData, attributeIter->mLength);
+        break;
+    case AttributeKind::kSize:
+        aState.Set<size_t>(attributeIter->mLength);
+        break;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::ForEachCluster(ClusterHandler aHandler, void * apContext) const
+{
+    for (const auto & cluster : mClusters)
+    {
+        ReturnErrorOnFailure(aHandler(apContext, ConcreteClusterPath(cluster.mEndpointId, cluster.mClusterId)));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::ForEachAttribute(const ConcreteClusterPath & aPath, AttributeHandler aHandler,
+                                                          void * apContext) const
+{
+    auto cluster = FindCluster(aPath);
+    VerifyOrReturnError(cluster != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    for (const auto & attribute : cluster->mAttributes)
+    {
+        const ConcreteAttributePath path(aPath.mEndpointId, aPath.mClusterId, attribute.mAttributeId);
+        AttributeState state;
+        ReturnErrorOnFailure(GetAttribute(path, state));
+        ReturnErrorOnFailure(aHandler(apContext, path, state));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void FlatClusterStateCacheStorage::Compact()
+{
+    size_t deadBytes = mAttributeArena.UsedBytes() - mLiveAttributeBytes;
+
+    // Only bother once the replaced values take more room than the current ones, and more than a chunk.
+    if (deadBytes <= mLiveAttributeBytes || deadBytes < Arena::kDefaultChunkSize)
+    {
+        return;
+    }
+
+    Arena compacted;
+    uint8_t * buffer = (mLiveAttributeBytes > 0) ? compacted.Allocate(mLiveAttributeBytes) : nullptr;
+    VerifyOrReturn(mLiveAttributeBytes == 0 || buffer != nullptr);
+
+    for (auto & cluster : mClusters)
+    {
+        for (auto & attribute : cluster.mAttributes)
+        {
+            if (attribute.mKind == AttributeKind::kData)
+            {
+                memcpy(buffer, attribute.mpData, attribute.mLength);
+                attribute.mpData = buffer;
+                buffer += attribute.mLength;
+            }
+        }
+    }
+
+    mAttributeArena.Swap(compacted);
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::AddEvent(const EventHeader & aHeader, const ByteSpan & aData)
+{
+    auto eventIter = std::lower_bound(mEvents.begin(), mEvents.end(), aHeader.mEventNumber,
+                                      [](const EventEntry & entry, EventNumber number) { return entry.mHeader.mEventNumber < number; });
+    if (eventIter != mEvents.end() && eventIter->mHeader.mEventNumber == aHeader.mEventNumber)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    uint8_t * buffer = mEventArena.Allocate(aData.size());
+    VerifyOrReturnError(buffer != nullptr, CHIP_ERROR_NO_MEMORY);
+    memcpy(buffer, aData.data(), aData.size());
+
+    EventEntry entry;
+    entry.mHeader = aHeader;
+    entry.mpData  = buffer;
+    entry.mLength = aData.size();
+    mEvents.insert(eventIter, entry);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::GetEvent(EventNumber aEventNumber, const EventHeader *& apHeader, ByteSpan & aData) const
+{
+    auto eventIter = std::lower_bound(mEvents.begin(), mEvents.end(), aEventNumber,
+                                      [](const EventEntry & entry, EventNumber number) { return entry.mHeader.mEventNumber < number; });
+    VerifyOrReturnError(eventIter != mEvents.end() && eventIter->mHeader.mEventNumber == aEventNumber, CHIP_ERROR_KEY_NOT_FOUND);
+
+    apHeader = &eventIter->mHeader;
+    aData    = ByteSpan(eventIter->mpData, eventIter->mLength);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatClusterStateCacheStorage::ForEachEvent(EventHandler aHandler, void * apContext) const
+{
+    for (const auto & event : mEvents)
+    {
+        ReturnErrorOnFailure(aHandler(apContext, event.mHeader));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void FlatClusterStateCacheStorage::ClearEvents()
+{
+    mEvents.clear();
+    mEvents.shrink_to_fit();
+    mEventArena.Clear();
+}
+
+void FlatClusterStateCacheStorage::GetMemoryUsage(MemoryUsage & aUsage) const
+{
+    aUsage = MemoryUsage();
+
+    aUsage.mClusterCount = mClusters.size();
+    aUsage.mTotalBytes += VectorBytes(mClusters);
+    for (const auto & cluster : mClusters)
+    {
+        aUsage.mAttributeCount += cluster.mAttributes.size();
+        aUsage.mTotalBytes += VectorBytes(cluster.mAttributes);
+    }
+    aUsage.mAttributeDataBytes = mLiveAttributeBytes;
+    aUsage.mTotalBytes += mAttributeArena.AllocatedBytes() + mAttributeArena.ChunkCount() * kHeapAllocationOverhead;
+
+    aUsage.mEventCount     = mEvents.size();
+    aUsage.mEventDataBytes = mEventArena.UsedBytes();
+    aUsage.mTotalBytes += VectorBytes(mEvents);
+    aUsage.mTotalBytes += mEventArena.AllocatedBytes() + mEventArena.ChunkCount() * kHeapAllocationOverhead;
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/EventHeader.h>
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <lib/support/Variant.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/*
+ * Storage of the attributes and events of a node, as cached by the ClusterStateCache.
+ *
+ * Two layouts are provided:
+ *
+ *   - MapClusterStateCacheStorage keeps nested maps of endpoints, clusters and attributes, with the value of each
+ *     attribute and each event in an allocation of its own.
+ *
+ *   - FlatClusterStateCacheStorage keeps a vector of clusters sorted by path, each with a sorted vector of attributes,
+ *     and packs the values of all the attributes and events into arenas owned by the storage.  This takes far fewer
+ *     allocations and less memory when caching whole nodes, at the cost of compacting the attribute arena from time to
+ *     time as values are replaced.
+ */
+class ClusterStateCacheStorage
+{
+public:
+    // The state of an attribute, as seen from outside the storage:
+    // * the status, if we got a path-specific error for the attribute.
+    // * the TLV of the value, if we got data for the attribute and are storing data.
+    // * the size of the value, if we got data for the attribute and are not storing data.
+    using AttributeState = Variant<StatusIB, ByteSpan, size_t>;
+
+    // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
+    //
+    // mCommittedDataVersion represents a known data version for a cluster.
+    struct ClusterVersions
+    {
+        Optional<DataVersion> mPendingDataVersion;
+        Optional<DataVersion> mCommittedDataVersion;
+    };
+
+    /*
+     * Amount of memory held by the storage.  mTotalBytes is an estimate of all the heap memory held, including
+     * the bookkeeping of the containers.
+     */
+    struct MemoryUsage
+    {
+        size_t mClusterCount       = 0;
+        size_t mAttributeCount     = 0;
+        size_t mAttributeDataBytes = 0; ///< Bytes of TLV held for the current attribute values.
+        size_t mEventCount         = 0;
+        size_t mEventDataBytes     = 0; ///< Bytes of TLV held for the events.
+        size_t mTotalBytes         = 0;
+    };
+
+    using ClusterHandler   = CHIP_ERROR (*)(void * apContext, const ConcreteClusterPath & aPath);
+    using AttributeHandler = CHIP_ERROR (*)(void * apContext, const ConcreteAttributePath & aPath, const AttributeState & aState);
+    using EventHandler     = CHIP_ERROR (*)(void * apContext, const EventHeader & aHeader);
+
+    virtual ~ClusterStateCacheStorage() = default;
+
+    virtual bool HasEndpoint(EndpointId aEndpointId) const = 0;
+
+    /*
+     * Returns the data versions of a cluster, or nullptr if nothing is cached for the cluster.
+     */
+    virtual const ClusterVersions * GetClusterVersions(const ConcreteClusterPath & aPath) const = 0;
+
+    /*
+     * Returns the data versions of a cluster, adding the cluster if nothing is cached for it yet.
+     */
+    virtual ClusterVersions * GetOrAddClusterVersions(const ConcreteClusterPath & aPath) = 0;
+
+    /*
+     * Set the state of an attribute, adding its cluster if needed.  If the state holds TLV, it is copied.
+     */
+    virtual CHIP_ERROR SetAttribute(const ConcreteAttributePath & aPath, const AttributeState & aState) = 0;
+
+    /*
+     * Retrieve the state of an attribute.  If the state holds TLV, it remains valid until the attribute is updated
+     * or the storage is compacted.
+     *
+     * Returns CHIP_ERROR_KEY_NOT_FOUND if the attribute is not in the storage.
+     */
+    virtual CHIP_ERROR GetAttribute(const ConcreteAttributePath & aPath, AttributeState & aState) const = 0;
+
+    /*
+     * Iterate over the clusters, in increasing order of path.  Iteration stops at the first error returned by
+     * aHandler, which is returned.
+     */
+    virtual CHIP_ERROR ForEachCluster(ClusterHandler aHandler, void * apContext) const = 0;
+
+    /*
+     * Iterate over the attributes of a cluster, in increasing order of attribute ID.  Iteration stops at the first
+     * error returned by aHandler, which is returned.
+     *
+     * Returns CHIP_ERROR_KEY_NOT_FOUND if the cluster is not in the storage.
+     */
+    virtual CHIP_ERROR ForEachAttribute(const ConcreteClusterPath & aPath, AttributeHandler aHandler, void * apContext) const = 0;
+
+    /*
+     * Release the memory held for values that were since replaced.  Values returned by GetAttribute must not be used
+     * past this call.
+     */
+    virtual void Compact() {}
+
+    /*
+     * Add an event and a copy of its TLV payload.  An event with the same event number as an event already in the
+     * storage is ignored.
+     */
+    virtual CHIP_ERROR AddEvent(const EventHeader & aHeader, const ByteSpan & aData) = 0;
+
+    /*
+     * Retrieve an event.  Both the header and the payload remain valid until ClearEvents is called.
+     *
+     * Returns CHIP_ERROR_KEY_NOT_FOUND if there is no event with this number in the storage.
+     */
+    virtual CHIP_ERROR GetEvent(EventNumber aEventNumber, const EventHeader *& apHeader, ByteSpan & aData) const = 0;
+
+    /*
+     * Iterate over the events, in increasing order of event number.  Iteration stops at the first error returned by
+     * aHandler, which is returned.
+     */
+    virtual CHIP_ERROR ForEachEvent(EventHandler aHandler, void * apContext) const = 0;
+
+    virtual void ClearEvents() = 0;
+
+    virtual void GetMemoryUsage(MemoryUsage & aUsage) const = 0;
+};
+
+class MapClusterStateCacheStorage : public ClusterStateCacheStorage
+{
+public:
+    bool HasEndpoint(EndpointId aEndpointId) const override;
+    const ClusterVersions * GetClusterVersions(const ConcreteClusterPath & aPath) const override;
+    ClusterVersions * GetOrAddClusterVersions(const ConcreteClusterPath & aPath) override;
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & aPath, const AttributeState & aState) override;
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & aPath, AttributeState & aState) const override;
+    CHIP_ERROR ForEachCluster(ClusterHandler aHandler, void * apContext) const override;
+    CHIP_ERROR ForEachAttribute(const ConcreteClusterPath & aPath, AttributeHandler aHandler, void * apContext) const override;
+    CHIP_ERROR AddEvent(const EventHeader & aHeader, const ByteSpan & aData) override;
+    CHIP_ERROR GetEvent(EventNumber aEventNumber, const EventHeader *& apHeader, ByteSpan & aData) const override;
+    CHIP_ERROR ForEachEvent(EventHandler aHandler, void * apContext) const override;
+    void ClearEvents() override { mEvents.clear(); }
+    void GetMemoryUsage(MemoryUsage & aUsage) const override;
+
+private:
+    using AttributeData        = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    using StoredAttributeState = Variant<StatusIB, AttributeData, size_t>;
+
+    struct ClusterState
+    {
+        std::map<AttributeId, StoredAttributeState> mAttributes;
+        ClusterVersions mVersions;
+    };
+    using EndpointState = std::map<ClusterId, ClusterState>;
+    using NodeState     = std::map<EndpointId, EndpointState>;
+
+    using EventData = std::pair<EventHeader, System::PacketBufferHandle>;
+
+    //
+    // Uniqueness of the events is determined solely by the event number associated with each event.
+    //
+    struct EventDataCompare
+    {
+        bool operator()(const EventData & lhs, const EventData & rhs) const
+        {
+            return (lhs.first.mEventNumber < rhs.first.mEventNumber);
+        }
+    };
+
+    const ClusterState * GetClusterState(const ConcreteClusterPath & aPath) const;
+
+    NodeState mCache;
+    std::set<EventData, EventDataCompare> mEvents;
+};
+
+class FlatClusterStateCacheStorage : public ClusterStateCacheStorage
+{
+public:
+    bool HasEndpoint(EndpointId aEndpointId) const override;
+    const ClusterVersions * GetClusterVersions(const ConcreteClusterPath & aPath) const override;
+    ClusterVersions * GetOrAddClusterVersions(const ConcreteClusterPath & aPath) override;
+    CHIP_ERROR SetAttribute(const ConcreteAttributePath & aPath, const AttributeState & aState) override;
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & aPath, AttributeState & aState) const override;
+    CHIP_ERROR ForEachCluster(ClusterHandler aHandler, void * apContext) const override;
+    CHIP_ERROR ForEachAttribute(const ConcreteClusterPath & aPath, AttributeHandler aHandler, void * apContext) const override;
+    void Compact() override;
+    CHIP_ERROR AddEvent(const EventHeader & aHeader, const ByteSpan & aData) override;
+    CHIP_ERROR GetEvent(EventNumber aEventNumber, const EventHeader *& apHeader, ByteSpan & aData) const override;
+    CHIP_ERROR ForEachEvent(EventHandler aHandler, void * apContext) const override;
+    void ClearEvents() override;
+    void GetMemoryUsage(MemoryUsage & aUsage) const override;
+
+private:
+    /*
+     * Bump allocator over a list of chunks.  Allocations are never moved, and are only released all at once.
+     */
+    class Arena
+    {
+    public:
+        static constexpr size_t kDefaultChunkSize = 2048;
+
+        uint8_t * Allocate(size_t aSize);
+        void Clear();
+        void Swap(Arena & aOther);
+
+        size_t AllocatedBytes() const { return mAllocatedBytes; }
+        size_t UsedBytes() const { return mUsedBytes; }
+        size_t ChunkCount() const { return mChunks.size(); }
+
+    private:
+        std::vector<Platform::ScopedMemoryBuffer<uint8_t>> mChunks;
+        size_t mChunkFree      = 0; // Free bytes at the end of the last chunk.
+        size_t mChunkSize      = 0; // Size of the last chunk.
+        size_t mAllocatedBytes = 0;
+        size_t mUsedBytes      = 0;
+    };
+
+    enum class AttributeKind : uint8_t
+    {
+        kStatus,
+        kData,
+        kSize,
+    };
+
+    struct AttributeEntry
+    {
+        AttributeId mAttributeId;
+        AttributeKind mKind;
+        StatusIB mStatus;
+        const uint8_t * mpData; // kData: value in mAttributeArena.
+        size_t mLength;         // kData: length of the value, kSize: size of the value.
+    };
+
+    struct ClusterEntry
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        ClusterVersions mVersions;
+        std::vector<AttributeEntry> mAttributes; // Sorted by attribute ID.
+    };
+
+    struct EventEntry
+    {
+        EventHeader mHeader;
+        const uint8_t * mpData; // Payload in mEventArena.
+        size_t mLength;
+    };
+
+    ClusterEntry * FindCluster(const ConcreteClusterPath & aPath);
+    const ClusterEntry * FindCluster(const ConcreteClusterPath & aPath) const;
+    std::vector<ClusterEntry>::iterator ClusterLowerBound(EndpointId aEndpointId, ClusterId aClusterId);
+
+    std::vector<ClusterEntry> mClusters; // Sorted by endpoint ID, then cluster ID.
+    Arena mAttributeArena;
+    size_t mLiveAttributeBytes = 0; // Bytes of mAttributeArena used by current values.
+
+    std::vector<EventEntry> mEvents; // Sorted by event number.
+    Arena mEventArena;
+};
+
+} // namespace app
+} // namespace chip
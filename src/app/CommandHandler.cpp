@@ -61,6 +61,10 @@ CHIP_ERROR CommandHandler::AllocateBuffer()
 
         mInvokeResponseBuilder.CreateInvokeResponses();
         ReturnErrorOnFailure(mInvokeResponseBuilder.GetError());
+
+        // Keep room for closing the message, whichever response ends up being the last one it holds.
+        ReturnErrorOnFailure(mCommandMessageWriter.ReserveBuffer(kReservedSizeForTLVEncodingOverhead));
+        mResponseCount   = 0;
         mBufferAllocated = true;
     }
 
@@ -117,11 +121,12 @@ Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payloa
     invokeRequests.GetReader(&invokeRequestsReader);
 
     {
-        // We don't support handling multiple commands but the protocol is ready to support it in the future, reject all of them and
-        // IM Engine will send a status response.
+        // Requests with more commands than we can keep track of are rejected as a whole, and IM Engine will send a status
+        // response.
         size_t commandCount = 0;
         TLV::Utilities::Count(invokeRequestsReader, commandCount, false /* recurse */);
-        VerifyOrReturnError(commandCount == 1, Status::InvalidAction);
+        VerifyOrReturnError(commandCount >= 1 && commandCount <= CHIP_CONFIG_MAX_PATHS_PER_INVOKE, Status::InvalidAction);
+        VerifyOrReturnError(RecordCommandRefs(invokeRequestsReader, commandCount) == CHIP_NO_ERROR, Status::InvalidAction);
     }
 
     while (CHIP_NO_ERROR == (err = invokeRequestsReader.Next()))
@@ -154,12 +159,136 @@ Status CommandHandler::ProcessInvokeRequest(System::PacketBufferHandle && payloa
     return Status::Success;
 }
 
+CHIP_ERROR CommandHandler::RecordCommandRefs(const TLV::TLVReader & aInvokeRequestsReader, size_t aCommandCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVReader reader;
+
+    mCommandRefCount = 0;
+
+    // Group commands get no response, so their CommandRefs are of no use.
+    VerifyOrReturnError(!mExchangeCtx->IsGroupExchangeContext(), CHIP_NO_ERROR);
+
+    reader.Init(aInvokeRequestsReader);
+    while (CHIP_NO_ERROR == (err = reader.Next()))
+    {
+        CommandDataIB::Parser commandData;
+        CommandPathIB::Parser commandPath;
+        CommandRefEntry & entry = mCommandRefs[mCommandRefCount];
+
+        ReturnErrorOnFailure(commandData.Init(reader));
+        err = commandData.GetRef(&entry.mRef);
+        if (err == CHIP_END_OF_TLV && aCommandCount == 1)
+        {
+            // A lone command does not need a CommandRef.
+            continue;
+        }
+        ReturnErrorOnFailure(err);
+
+        ReturnErrorOnFailure(commandData.GetPath(&commandPath));
+        ReturnErrorOnFailure(commandPath.GetEndpointId(&entry.mRequestPath.mEndpointId));
+        ReturnErrorOnFailure(commandPath.GetClusterId(&entry.mRequestPath.mClusterId));
+        ReturnErrorOnFailure(commandPath.GetCommandId(&entry.mRequestPath.mCommandId));
+
+        // Both the CommandRef and the path of each command must be unique, so that responses can be matched to commands in
+        // either direction.
+        for (size_t i = 0; i < mCommandRefCount; i++)
+        {
+            VerifyOrReturnError(mCommandRefs[i].mRef != entry.mRef, CHIP_ERROR_INVALID_ARGUMENT);
+            VerifyOrReturnError(mCommandRefs[i].mRequestPath != entry.mRequestPath, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        mCommandRefCount++;
+    }
+
+    return err == CHIP_END_OF_TLV ? CHIP_NO_ERROR : err;
+}
+
+CHIP_ERROR CommandHandler::LookupCommandRef(const ConcreteCommandPath & aCommandPath, bool aIsRequestPath,
+                                            Optional<uint16_t> & aRef) const
+{
+    const CommandRefEntry * match = nullptr;
+
+    aRef.ClearValue();
+    for (size_t i = 0; i < mCommandRefCount; i++)
+    {
+        const ConcreteCommandPath & requestPath = mCommandRefs[i].mRequestPath;
+        if (requestPath.mEndpointId != aCommandPath.mEndpointId || requestPath.mClusterId != aCommandPath.mClusterId)
+        {
+            continue;
+        }
+        if (aIsRequestPath)
+        {
+            if (requestPath.mCommandId == aCommandPath.mCommandId)
+            {
+                match = &mCommandRefs[i];
+                break;
+            }
+            continue;
+        }
+        // The path of a response command does not tell apart several commands to the same cluster.
+        VerifyOrReturnError(match == nullptr, CHIP_ERROR_INCORRECT_STATE);
+        match = &mCommandRefs[i];
+    }
+
+    if (match != nullptr)
+    {
+        aRef.SetValue(match->mRef);
+    }
+    else if (mCommandRefCount == 1)
+    {
+        // Responses to a lone command are unambiguous even when their path does not match the request, such as the statuses
+        // of a command that does not exist.
+        aRef.SetValue(mCommandRefs[0].mRef);
+    }
+    else
+    {
+        VerifyOrReturnError(mCommandRefCount == 0, CHIP_ERROR_INCORRECT_STATE);
+    }
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CommandHandler::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PayloadHeader & aPayloadHeader,
                                              System::PacketBufferHandle && aPayload)
 {
-    ChipLogDetail(DataManagement, "CommandHandler: Unexpected message type %d", aPayloadHeader.GetMessageType());
-    StatusResponse::Send(Status::InvalidAction, mExchangeCtx.Get(), false /*aExpectResponse*/);
-    return CHIP_ERROR_INVALID_MESSAGE_TYPE;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(!mQueuedResponseChunks.IsNull(), err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+    VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::StatusResponse),
+                 err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+
+    // The client acknowledged a chunk of the response: carry on with the next one.
+    {
+        CHIP_ERROR statusError = CHIP_NO_ERROR;
+        SuccessOrExit(err = StatusResponse::ProcessStatusResponse(std::move(aPayload), statusError));
+        SuccessOrExit(err = statusError);
+        err = SendNextResponseChunk();
+    }
+
+exit:
+    if (err == CHIP_ERROR_INVALID_MESSAGE_TYPE)
+    {
+        ChipLogDetail(DataManagement, "CommandHandler: Unexpected message type %d", aPayloadHeader.GetMessageType());
+        StatusResponse::Send(Status::InvalidAction, mExchangeCtx.Get(), false /*aExpectResponse*/);
+    }
+    else if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to send chunked command response: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    if (mState == State::CommandSent && (err != CHIP_NO_ERROR || mQueuedResponseChunks.IsNull()))
+    {
+        mQueuedResponseChunks = nullptr;
+        Close();
+    }
+    return err;
+}
+
+void CommandHandler::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
+{
+    ChipLogProgress(DataManagement, "Time out! failed to receive status response from Exchange: " ChipLogFormatExchange,
+                    ChipLogValueExchange(apExchangeContext));
+    mQueuedResponseChunks = nullptr;
+    Close();
 }
 
 void CommandHandler::Close()
@@ -210,6 +339,13 @@ void CommandHandler::DecrementHoldOff()
         }
     }
 
+    // The remaining chunks of a chunked response are sent as the client acknowledges the previous ones, see OnMessageReceived.
+    if (mState == State::CommandSent && !mQueuedResponseChunks.IsNull())
+    {
+        return;
+    }
+
+    mQueuedResponseChunks = nullptr;
     Close();
 }
 
@@ -218,20 +354,35 @@ CHIP_ERROR CommandHandler::SendCommandResponse()
     System::PacketBufferHandle commandPacket;
 
     VerifyOrReturnError(mPendingWork == 0, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mExchangeCtx, CHIP_ERROR_INCORRECT_STATE);
 
     ReturnErrorOnFailure(Finalize(commandPacket));
-    ReturnErrorOnFailure(
-        mExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::InvokeCommandResponse, std::move(commandPacket)));
-    // The ExchangeContext is automatically freed here, and it makes mpExchangeCtx be temporarily dangling, but in
-    // all cases, we are going to call Close immediately after this function, which nulls out mpExchangeCtx.
+    mQueuedResponseChunks.AddToEnd(std::move(commandPacket));
+    ReturnErrorOnFailure(SendNextResponseChunk());
+    // Unless chunks remain to be sent, the ExchangeContext is automatically freed here, and it makes mpExchangeCtx be
+    // temporarily dangling, but in all cases, we are going to call Close immediately after this function, which nulls out
+    // mpExchangeCtx.
 
     MoveToState(State::CommandSent);
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandHandler::SendNextResponseChunk()
+{
+    using namespace Messaging;
+
+    System::PacketBufferHandle chunk = mQueuedResponseChunks.PopHead();
+    SendFlags sendFlags;
+    if (!mQueuedResponseChunks.IsNull())
+    {
+        VerifyOrReturnError(mExchangeCtx->HasSessionHandle(), CHIP_ERROR_INCORRECT_STATE);
+        mExchangeCtx->SetResponseTimeout(mExchangeCtx->GetSessionHandle()->ComputeRoundTripTimeout(app::kExpectedIMProcessingTime));
+        sendFlags.Set(SendMessageFlags::kExpectResponse);
+    }
+    return mExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::InvokeCommandResponse, std::move(chunk), sendFlags);
+}
+
 namespace {
 // We use this when the sender did not actually provide a CommandFields struct,
 // to avoid downstream consumers having to worry about cases when there is or is
@@ -454,7 +605,7 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
     return Status::Success;
 }
 
-CHIP_ERROR CommandHandler::AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
+CHIP_ERROR CommandHandler::TryAddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
 {
     ReturnErrorOnFailure(PrepareStatus(aCommandPath));
     CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
@@ -465,6 +616,18 @@ CHIP_ERROR CommandHandler::AddStatusInternal(const ConcreteCommandPath & aComman
     return FinishStatus();
 }
 
+CHIP_ERROR CommandHandler::AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
+{
+    CHIP_ERROR err = TryAddStatusInternal(aCommandPath, aStatus);
+    if (IsOutOfSpaceError(err))
+    {
+        RollbackResponse();
+        ReturnErrorOnFailure(StartNewResponseChunk());
+        err = TryAddStatusInternal(aCommandPath, aStatus);
+    }
+    return err;
+}
+
 CHIP_ERROR CommandHandler::AddStatus(const ConcreteCommandPath & aCommandPath, const Status aStatus)
 {
     return AddStatusInternal(aCommandPath, StatusIB(aStatus));
@@ -480,16 +643,39 @@ CHIP_ERROR CommandHandler::AddClusterSpecificFailure(const ConcreteCommandPath &
     return AddStatusInternal(aCommandPath, StatusIB(Status::Failure, aClusterStatus));
 }
 
-CHIP_ERROR CommandHandler::PrepareCommand(const ConcreteCommandPath & aCommandPath, bool aStartDataStruct)
+CHIP_ERROR CommandHandler::PrepareResponse(const Optional<uint16_t> & aRef)
 {
     ReturnErrorOnFailure(AllocateBuffer());
 
-    mInvokeResponseBuilder.Checkpoint(mBackupWriter);
     //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    // We must not be in the middle of preparing a response, or having sent them.
     //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mState == State::Idle || mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    mInvokeResponseBuilder.Checkpoint(mBackupWriter);
+    mResponseRef = aRef;
     MoveToState(State::Preparing);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CommandHandler::PrepareCommand(const ConcreteCommandPath & aResponseCommandPath, bool aStartDataStruct)
+{
+    Optional<uint16_t> ref;
+    ReturnErrorOnFailure(LookupCommandRef(aResponseCommandPath, /* aIsRequestPath = */ false, ref));
+    return PrepareCommandInternal(aResponseCommandPath, ref, aStartDataStruct);
+}
+
+CHIP_ERROR CommandHandler::PrepareInvokeResponseCommand(const ConcreteCommandPath & aRequestCommandPath,
+                                                        const ConcreteCommandPath & aResponseCommandPath, bool aStartDataStruct)
+{
+    Optional<uint16_t> ref;
+    ReturnErrorOnFailure(LookupCommandRef(aRequestCommandPath, /* aIsRequestPath = */ true, ref));
+    return PrepareCommandInternal(aResponseCommandPath, ref, aStartDataStruct);
+}
+
+CHIP_ERROR CommandHandler::PrepareCommandInternal(const ConcreteCommandPath & aResponseCommandPath, const Optional<uint16_t> & aRef,
+                                                  bool aStartDataStruct)
+{
+    ReturnErrorOnFailure(PrepareResponse(aRef));
     InvokeResponseIBs::Builder & invokeResponses = mInvokeResponseBuilder.GetInvokeResponses();
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
     ReturnErrorOnFailure(invokeResponses.GetError());
@@ -498,7 +684,7 @@ CHIP_ERROR CommandHandler::PrepareCommand(const ConcreteCommandPath & aCommandPa
     ReturnErrorOnFailure(commandData.GetError());
     CommandPathIB::Builder & path = commandData.CreatePath();
     ReturnErrorOnFailure(commandData.GetError());
-    ReturnErrorOnFailure(path.Encode(aCommandPath));
+    ReturnErrorOnFailure(path.Encode(aResponseCommandPath));
     if (aStartDataStruct)
     {
         ReturnErrorOnFailure(commandData.GetWriter()->StartContainer(TLV::ContextTag(CommandDataIB::Tag::kFields),
@@ -516,22 +702,22 @@ CHIP_ERROR CommandHandler::FinishCommand(bool aStartDataStruct)
     {
         ReturnErrorOnFailure(commandData.GetWriter()->EndContainer(mDataElementContainerType));
     }
+    if (mResponseRef.HasValue())
+    {
+        ReturnErrorOnFailure(commandData.Ref(mResponseRef.Value()).GetError());
+    }
     ReturnErrorOnFailure(commandData.EndOfCommandDataIB().GetError());
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB().GetError());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses().GetError());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage().GetError());
+    mResponseCount++;
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR CommandHandler::PrepareStatus(const ConcreteCommandPath & aCommandPath)
 {
-    ReturnErrorOnFailure(AllocateBuffer());
-    //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
-    //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
-    MoveToState(State::Preparing);
+    Optional<uint16_t> ref;
+    ReturnErrorOnFailure(LookupCommandRef(aCommandPath, /* aIsRequestPath = */ true, ref));
+    ReturnErrorOnFailure(PrepareResponse(ref));
     InvokeResponseIBs::Builder & invokeResponses = mInvokeResponseBuilder.GetInvokeResponses();
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
     ReturnErrorOnFailure(invokeResponses.GetError());
@@ -547,11 +733,14 @@ CHIP_ERROR CommandHandler::PrepareStatus(const ConcreteCommandPath & aCommandPat
 CHIP_ERROR CommandHandler::FinishStatus()
 {
     VerifyOrReturnError(mState == State::AddingCommand, CHIP_ERROR_INCORRECT_STATE);
-    ReturnErrorOnFailure(
-        mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus().EndOfCommandStatusIB().GetError());
+    CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
+    if (mResponseRef.HasValue())
+    {
+        ReturnErrorOnFailure(commandStatus.Ref(mResponseRef.Value()).GetError());
+    }
+    ReturnErrorOnFailure(commandStatus.EndOfCommandStatusIB().GetError());
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB().GetError());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses().GetError());
-    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage().GetError());
+    mResponseCount++;
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
 }
@@ -561,12 +750,27 @@ CHIP_ERROR CommandHandler::RollbackResponse()
     VerifyOrReturnError(mState == State::Preparing || mState == State::AddingCommand, CHIP_ERROR_INCORRECT_STATE);
     mInvokeResponseBuilder.Rollback(mBackupWriter);
     mInvokeResponseBuilder.ResetError();
-    // Note: We only support one command per request, so we reset the state to Idle here, need to review the states when adding
-    // supports of having multiple requests in the same transaction.
-    MoveToState(State::Idle);
+    mInvokeResponseBuilder.GetInvokeResponses().ResetError();
+    // Go back to the state we were in before PrepareCommand / PrepareStatus, depending on whether earlier responses are
+    // awaiting transmission.
+    MoveToState(mResponseCount > 0 ? State::AddedCommand : State::Idle);
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandHandler::StartNewResponseChunk()
+{
+    System::PacketBufferHandle chunk;
+
+    // A response that does not fit in an otherwise empty message will not fit in a new one either.
+    VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(mExchangeCtx && !mExchangeCtx->IsGroupExchangeContext(), CHIP_ERROR_INCORRECT_STATE);
+
+    ReturnErrorOnFailure(FinalizeInvokeResponseMessage(/* aMoreChunkedMessages = */ true, chunk));
+    mQueuedResponseChunks.AddToEnd(std::move(chunk));
+    MoveToState(State::Idle);
+    return AllocateBuffer();
+}
+
 TLV::TLVWriter * CommandHandler::GetCommandDataIBTLVWriter()
 {
     if (mState != State::AddingCommand)
@@ -616,8 +820,24 @@ CommandHandler::Handle::Handle(CommandHandler * handle)
 
 CHIP_ERROR CommandHandler::Finalize(System::PacketBufferHandle & commandPacket)
 {
-    VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
-    return mCommandMessageWriter.Finalize(&commandPacket);
+    // The message being encoded may only be empty if the responses before it have been moved to chunks of their own.
+    VerifyOrReturnError(mState == State::AddedCommand || (mState == State::Idle && !mQueuedResponseChunks.IsNull()),
+                        CHIP_ERROR_INCORRECT_STATE);
+    return FinalizeInvokeResponseMessage(/* aMoreChunkedMessages = */ false, commandPacket);
+}
+
+CHIP_ERROR CommandHandler::FinalizeInvokeResponseMessage(bool aMoreChunkedMessages, System::PacketBufferHandle & aPacket)
+{
+    VerifyOrReturnError(mBufferAllocated, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mCommandMessageWriter.UnreserveBuffer(kReservedSizeForTLVEncodingOverhead));
+    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().EndOfInvokeResponses().GetError());
+    if (aMoreChunkedMessages)
+    {
+        ReturnErrorOnFailure(mInvokeResponseBuilder.MoreChunkedMessages(true).GetError());
+    }
+    ReturnErrorOnFailure(mInvokeResponseBuilder.EndOfInvokeResponseMessage().GetError());
+    mBufferAllocated = false;
+    return mCommandMessageWriter.Finalize(&aPacket);
 }
 
 const char * CommandHandler::GetStateStr() const
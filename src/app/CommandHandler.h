@@ -26,6 +26,12 @@
  *      Allows adding the responses asynchronously.  See the documentation
  *      for the CommandHandler::Handle class below.
  *
+ *      An InvokeRequest may carry up to CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+ *      commands, each with a distinct CommandRef.  Each response carries the
+ *      CommandRef of the command it answers, found from the request path
+ *      given to the Add* methods.  Responses that do not fit in one
+ *      InvokeResponseMessage are sent in several, chunked messages.
+ *
  */
 
 #pragma once
@@ -33,6 +39,7 @@
 #include <app/ConcreteCommandPath.h>
 #include <app/data-model/Encode.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/core/Optional.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/BitFlags.h>
@@ -105,6 +112,11 @@ public:
      *
      * The Invoke Response will not be sent until all outstanding Handles have
      * been destroyed or have had Release called.
+     *
+     * When the InvokeRequest carries several commands, the commands handled
+     * synchronously and the ones completed through Handles may respond in any
+     * order: each response is matched to its command by the request path
+     * given to the Add* methods.
      */
     class Handle
     {
@@ -177,7 +189,20 @@ public:
     CHIP_ERROR AddClusterSpecificFailure(const ConcreteCommandPath & aCommandPath, ClusterStatus aClusterStatus);
 
     Protocols::InteractionModel::Status ProcessInvokeRequest(System::PacketBufferHandle && payload, bool isTimedInvoke);
-    CHIP_ERROR PrepareCommand(const ConcreteCommandPath & aCommandPath, bool aStartDataStruct = true);
+
+    /**
+     * Start encoding a data response for the command at aRequestCommandPath, with aResponseCommandPath as the path of the
+     * response command.  This must be followed by FinishCommand.
+     */
+    CHIP_ERROR PrepareInvokeResponseCommand(const ConcreteCommandPath & aRequestCommandPath,
+                                            const ConcreteCommandPath & aResponseCommandPath, bool aStartDataStruct = true);
+
+    /**
+     * Legacy version of PrepareInvokeResponseCommand, which only knows the path of the response command.  The command it
+     * responds to is taken to be the only command of the request on the same endpoint and cluster, so this fails with
+     * CHIP_ERROR_INCORRECT_STATE when several commands of a batch could match.
+     */
+    CHIP_ERROR PrepareCommand(const ConcreteCommandPath & aResponseCommandPath, bool aStartDataStruct = true);
     CHIP_ERROR FinishCommand(bool aEndDataStruct = true);
     CHIP_ERROR PrepareStatus(const ConcreteCommandPath & aCommandPath);
     CHIP_ERROR FinishStatus();
@@ -211,6 +236,17 @@ public:
             // The state guarantees that either we can rollback or we don't have to rollback the buffer, so we don't care about the
             // return value of RollbackResponse.
             RollbackResponse();
+
+            // If the response does not fit next to the responses already encoded, move those to a message of their own and try
+            // again in a new one.
+            if (IsOutOfSpaceError(err) && StartNewResponseChunk() == CHIP_NO_ERROR)
+            {
+                err = TryAddResponseData(aRequestCommandPath, aData);
+                if (err != CHIP_NO_ERROR)
+                {
+                    RollbackResponse();
+                }
+            }
         }
         return err;
     }
@@ -298,13 +334,8 @@ private:
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                  System::PacketBufferHandle && payload) override;
 
-    void OnResponseTimeout(Messaging::ExchangeContext * ec) override
-    {
-        //
-        // We're not expecting responses to any messages we send out on this EC.
-        //
-        VerifyOrDie(false);
-    }
+    // We only expect responses while sending chunked InvokeResponseMessages.
+    void OnResponseTimeout(Messaging::ExchangeContext * ec) override;
 
     enum class State
     {
@@ -356,6 +387,43 @@ private:
 
     CHIP_ERROR Finalize(System::PacketBufferHandle & commandPacket);
 
+    /**
+     * Close the InvokeResponseMessage being encoded, which holds the responses added since the previous chunk, and queue it
+     * to be sent with MoreChunkedMessages set.  A new message is then started for the responses to come.
+     */
+    CHIP_ERROR StartNewResponseChunk();
+
+    /**
+     * Close the InvokeResponseMessage being encoded and release its buffer into aPacket.
+     */
+    CHIP_ERROR FinalizeInvokeResponseMessage(bool aMoreChunkedMessages, System::PacketBufferHandle & aPacket);
+
+    /**
+     * Send the next queued InvokeResponseMessage.  The messages before the last one expect a StatusResponse, upon which the
+     * next one is sent.
+     */
+    CHIP_ERROR SendNextResponseChunk();
+
+    static bool IsOutOfSpaceError(CHIP_ERROR aError)
+    {
+        return aError == CHIP_ERROR_NO_MEMORY || aError == CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /**
+     * Record the CommandRefs of the commands of the request, checking that every command of a batch has a distinct one.
+     */
+    CHIP_ERROR RecordCommandRefs(const TLV::TLVReader & aInvokeRequestsReader, size_t aCommandCount);
+
+    /**
+     * Find the CommandRef of the command at aCommandPath.  If aIsRequestPath is false, aCommandPath is the path of a response
+     * command, which only identifies the request command by endpoint and cluster.
+     */
+    CHIP_ERROR LookupCommandRef(const ConcreteCommandPath & aCommandPath, bool aIsRequestPath, Optional<uint16_t> & aRef) const;
+
+    CHIP_ERROR PrepareResponse(const Optional<uint16_t> & aRef);
+    CHIP_ERROR PrepareCommandInternal(const ConcreteCommandPath & aResponseCommandPath, const Optional<uint16_t> & aRef,
+                                      bool aStartDataStruct);
+
     /**
      * Called internally to signal the completion of all work on this object, gracefully close the
      * exchange (by calling into the base class) and finally, signal to a registerd callback that it's
@@ -376,6 +444,7 @@ private:
     Protocols::InteractionModel::Status ProcessGroupCommandDataIB(CommandDataIB::Parser & aCommandElement);
     CHIP_ERROR SendCommandResponse();
     CHIP_ERROR AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus);
+    CHIP_ERROR TryAddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus);
 
     /**
      * If this function fails, it may leave our TLV buffer in an inconsistent state.  Callers should snapshot as needed before
@@ -389,7 +458,7 @@ private:
     CHIP_ERROR TryAddResponseData(const ConcreteCommandPath & aRequestCommandPath, const CommandData & aData)
     {
         ConcreteCommandPath path = { aRequestCommandPath.mEndpointId, aRequestCommandPath.mClusterId, CommandData::GetCommandId() };
-        ReturnErrorOnFailure(PrepareCommand(path, false));
+        ReturnErrorOnFailure(PrepareInvokeResponseCommand(aRequestCommandPath, path, false));
         TLV::TLVWriter * writer = GetCommandDataIBTLVWriter();
         VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
         ReturnErrorOnFailure(DataModel::Encode(*writer, TLV::ContextTag(CommandDataIB::Tag::kFields), aData));
@@ -397,6 +466,30 @@ private:
         return FinishCommand(/* aEndDataStruct = */ false);
     }
 
+    struct CommandRefEntry
+    {
+        ConcreteCommandPath mRequestPath = ConcreteCommandPath(0, 0, 0);
+        uint16_t mRef                    = 0;
+    };
+
+    /*
+     *  Layout of an InvokeResponseMessage, with the bytes reserved for closing it while the responses are encoded:
+     *
+     *  {
+     *    SuppressResponse = false,
+     *    InvokeResponses = [
+     *      (...)
+     *    ],                           <-- 1 byte  "end of InvokeResponseIBs" (end of container)
+     *    moreChunkedMessages = true,  <-- 2 bytes "kReservedSizeForMoreChunksFlag"
+     *    InteractionModelRevision = 1,<-- 3 bytes "kReservedSizeForIMRevision"
+     *  }                              <-- 1 byte  "end of InvokeResponseMessage" (end of container)
+     */
+    static constexpr uint16_t kReservedSizeForMoreChunksFlag = 1 + 1;
+    static constexpr uint16_t kReservedSizeForEndOfContainer = 1;
+    static constexpr uint16_t kReservedSizeForIMRevision     = 1 + 1 + 1;
+    static constexpr uint16_t kReservedSizeForTLVEncodingOverhead =
+        kReservedSizeForEndOfContainer + kReservedSizeForMoreChunksFlag + kReservedSizeForIMRevision + kReservedSizeForEndOfContainer;
+
     Messaging::ExchangeHolder mExchangeCtx;
     Callback * mpCallback = nullptr;
     InvokeResponseMessage::Builder mInvokeResponseBuilder;
@@ -411,6 +504,14 @@ private:
     chip::System::PacketBufferTLVWriter mCommandMessageWriter;
     TLV::TLVWriter mBackupWriter;
     bool mBufferAllocated = false;
+    // Number of responses in the InvokeResponseMessage being encoded.
+    size_t mResponseCount = 0;
+    // CommandRef of the response being encoded.
+    Optional<uint16_t> mResponseRef;
+    CommandRefEntry mCommandRefs[CHIP_CONFIG_MAX_PATHS_PER_INVOKE];
+    size_t mCommandRefCount = 0;
+    // InvokeResponseMessages ready to be sent, chained in the order they are to be sent.
+    System::PacketBufferHandle mQueuedResponseChunks;
     // If mGoneAsync is true, we have finished out initial processing of the
     // incoming invoke.  After this point, our session could go away at any
     // time.
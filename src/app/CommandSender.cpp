@@ -55,12 +55,24 @@ CHIP_ERROR CommandSender::AllocateBuffer()
         mInvokeRequestBuilder.CreateInvokeRequests();
         ReturnErrorOnFailure(mInvokeRequestBuilder.GetError());
 
+        if (mBatchCommands)
+        {
+            ReturnErrorOnFailure(mCommandMessageWriter.ReserveBuffer(kReservedSizeForTLVEncodingOverhead));
+        }
+
         mBufferAllocated = true;
     }
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandSender::EnableBatchCommands()
+{
+    VerifyOrReturnError(mState == State::Idle && !mBufferAllocated, CHIP_ERROR_INCORRECT_STATE);
+    mBatchCommands = true;
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CommandSender::SendCommandRequest(const SessionHandle & session, Optional<System::Clock::Timeout> timeout)
 {
     VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
@@ -162,9 +174,16 @@ CHIP_ERROR CommandSender::OnMessageReceived(Messaging::ExchangeContext * apExcha
 
     if (aPayloadHeader.HasMessageType(MsgType::InvokeCommandResponse))
     {
-        err = ProcessInvokeResponse(std::move(aPayload));
+        bool moreChunkedMessages = false;
+        err                      = ProcessInvokeResponse(std::move(aPayload), moreChunkedMessages);
         SuccessOrExit(err);
         sendStatusResponse = false;
+        if (moreChunkedMessages)
+        {
+            // Acknowledge this chunk of the response, upon which the server sends the next one.
+            SuccessOrExit(err = StatusResponse::Send(Status::Success, apExchangeContext, true /*aExpectResponse*/));
+            MoveToState(State::CommandSent);
+        }
     }
     else if (aPayloadHeader.HasMessageType(MsgType::StatusResponse))
     {
@@ -201,7 +220,7 @@ exit:
     return err;
 }
 
-CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && payload)
+CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && payload, bool & moreChunkedMessages)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
@@ -219,6 +238,12 @@ CHIP_ERROR CommandSender::ProcessInvokeResponse(System::PacketBufferHandle && pa
 
     ReturnErrorOnFailure(invokeResponseMessage.GetSuppressResponse(&suppressResponse));
     ReturnErrorOnFailure(invokeResponseMessage.GetInvokeResponses(&invokeResponses));
+
+    moreChunkedMessages = false;
+    err                 = invokeResponseMessage.GetMoreChunkedMessages(&moreChunkedMessages);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    err = CHIP_NO_ERROR;
+
     invokeResponses.GetReader(&invokeResponsesReader);
 
     while (CHIP_NO_ERROR == (err = invokeResponsesReader.Next()))
@@ -271,6 +296,7 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
     EndpointId endpointId;
     // Default to success when an invoke response is received.
     StatusIB statusIB;
+    Optional<uint16_t> commandRef;
 
     {
         bool hasDataResponse = false;
@@ -289,6 +315,12 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
             StatusIB::Parser status;
             commandStatus.GetErrorStatus(&status);
             ReturnErrorOnFailure(status.DecodeStatusIB(statusIB));
+
+            uint16_t ref;
+            if (commandStatus.GetRef(&ref) == CHIP_NO_ERROR)
+            {
+                commandRef.SetValue(ref);
+            }
         }
         else if (CHIP_END_OF_TLV == err)
         {
@@ -302,6 +334,12 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
             commandData.GetFields(&commandDataReader);
             err             = CHIP_NO_ERROR;
             hasDataResponse = true;
+
+            uint16_t ref;
+            if (commandData.GetRef(&ref) == CHIP_NO_ERROR)
+            {
+                commandRef.SetValue(ref);
+            }
         }
 
         if (err != CHIP_NO_ERROR)
@@ -328,7 +366,21 @@ CHIP_ERROR CommandSender::ProcessInvokeResponseIB(InvokeResponseIB::Parser & aIn
         }
         ReturnErrorOnFailure(err);
 
-        if (mpCallback != nullptr)
+        if (mBatchCommands)
+        {
+            // The responses to a batch of commands can only be told apart by their CommandRef, unless there is a single command.
+            if (!commandRef.HasValue() && mBatchCommandCount == 1)
+            {
+                commandRef.SetValue(0);
+            }
+            VerifyOrReturnError(commandRef.HasValue() && commandRef.Value() < mBatchCommandCount, CHIP_ERROR_INVALID_TLV_ELEMENT);
+            if (mpCallback != nullptr)
+            {
+                mpCallback->OnResponseWithCommandRef(this, ConcreteCommandPath(endpointId, clusterId, commandId), commandRef.Value(),
+                                                     statusIB, hasDataResponse ? &commandDataReader : nullptr);
+            }
+        }
+        else if (mpCallback != nullptr)
         {
             if (statusIB.IsSuccess())
             {
@@ -349,9 +401,10 @@ CHIP_ERROR CommandSender::PrepareCommand(const CommandPathParams & aCommandPathP
     ReturnErrorOnFailure(AllocateBuffer());
 
     //
-    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    // We must not be in the middle of preparing a command, or having prepared (unless batching commands) or sent one.
     //
-    VerifyOrReturnError(mState == State::Idle, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mState == State::Idle || (mBatchCommands && mState == State::AddedCommand), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mBatchCommandCount < CHIP_CONFIG_MAX_PATHS_PER_INVOKE, CHIP_ERROR_NO_MEMORY);
     InvokeRequests::Builder & invokeRequests = mInvokeRequestBuilder.GetInvokeRequests();
     CommandDataIB::Builder & invokeRequest   = invokeRequests.CreateCommandData();
     ReturnErrorOnFailure(invokeRequests.GetError());
@@ -382,6 +435,15 @@ CHIP_ERROR CommandSender::FinishCommand(bool aEndDataStruct)
         ReturnErrorOnFailure(commandData.GetWriter()->EndContainer(mDataElementContainerType));
     }
 
+    if (mBatchCommands)
+    {
+        ReturnErrorOnFailure(commandData.Ref(mBatchCommandCount).GetError());
+        ReturnErrorOnFailure(commandData.EndOfCommandDataIB().GetError());
+        mBatchCommandCount++;
+        MoveToState(State::AddedCommand);
+        return CHIP_NO_ERROR;
+    }
+
     ReturnErrorOnFailure(commandData.EndOfCommandDataIB().GetError());
     ReturnErrorOnFailure(mInvokeRequestBuilder.GetInvokeRequests().EndOfInvokeRequests().GetError());
     ReturnErrorOnFailure(mInvokeRequestBuilder.EndOfInvokeRequestMessage().GetError());
@@ -419,6 +481,12 @@ CHIP_ERROR CommandSender::FinishCommand(const Optional<uint16_t> & aTimedInvokeT
 CHIP_ERROR CommandSender::Finalize(System::PacketBufferHandle & commandPacket)
 {
     VerifyOrReturnError(mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    if (mBatchCommands)
+    {
+        ReturnErrorOnFailure(mCommandMessageWriter.UnreserveBuffer(kReservedSizeForTLVEncodingOverhead));
+        ReturnErrorOnFailure(mInvokeRequestBuilder.GetInvokeRequests().EndOfInvokeRequests().GetError());
+        ReturnErrorOnFailure(mInvokeRequestBuilder.EndOfInvokeRequestMessage().GetError());
+    }
     return mCommandMessageWriter.Finalize(&commandPacket);
 }
 
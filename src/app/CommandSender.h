@@ -97,6 +97,35 @@ public:
          */
         virtual void OnError(const CommandSender * apCommandSender, CHIP_ERROR aError) {}
 
+        /**
+         * OnResponseWithCommandRef will be called instead of OnResponse and OnError for each path-specific response to a batch of
+         * commands (see EnableBatchCommands).  The responses may come in any order, and aCommandRef tells which command each one
+         * is for.
+         *
+         * The CommandSender object MUST continue to exist after this call is completed. The application shall wait until it
+         * receives an OnDone call to destroy the object.
+         *
+         * @param[in] apCommandSender The command sender object that initiated the command transaction.
+         * @param[in] aPath           The command path field in invoke command response.
+         * @param[in] aCommandRef     The CommandRef of the command, which is its index in the batch.
+         * @param[in] aStatusIB       The status of the command, which may be a failure.
+         * @param[in] apData          The command data, will be nullptr if the server returns a StatusIB.
+         *
+         * By default, successful responses are passed on to OnResponse and failures to OnError.
+         */
+        virtual void OnResponseWithCommandRef(CommandSender * apCommandSender, const ConcreteCommandPath & aPath,
+                                              uint16_t aCommandRef, const StatusIB & aStatusIB, TLV::TLVReader * apData)
+        {
+            if (aStatusIB.IsSuccess())
+            {
+                OnResponse(apCommandSender, aPath, aStatusIB, apData);
+            }
+            else
+            {
+                OnError(apCommandSender, aStatusIB.ToChipError());
+            }
+        }
+
         /**
          * OnDone will be called when CommandSender has finished all work and is safe to destroy and free the
          * allocated CommandSender object.
@@ -122,6 +151,15 @@ public:
      * If callbacks are passed the only one that will be called in a group sesttings is the onDone
      */
     CommandSender(Callback * apCallback, Messaging::ExchangeManager * apExchangeMgr, bool aIsTimedRequest = false);
+
+    /**
+     * Send up to CHIP_CONFIG_MAX_PATHS_PER_INVOKE commands in a single Invoke Request, which must all have distinct paths.  This
+     * must be called before the first command is prepared.  Commands are then added one after the other with PrepareCommand /
+     * FinishCommand or AddRequestData, and the responses are delivered through Callback::OnResponseWithCommandRef, with the
+     * index of the command in the batch as CommandRef.
+     */
+    CHIP_ERROR EnableBatchCommands();
+
     CHIP_ERROR PrepareCommand(const CommandPathParams & aCommandPathParams, bool aStartDataStruct = true);
     CHIP_ERROR FinishCommand(bool aEndDataStruct = true);
     TLV::TLVWriter * GetCommandDataIBTLVWriter();
@@ -256,7 +294,7 @@ private:
      */
     void Abort();
 
-    CHIP_ERROR ProcessInvokeResponse(System::PacketBufferHandle && payload);
+    CHIP_ERROR ProcessInvokeResponse(System::PacketBufferHandle && payload, bool & moreChunkedMessages);
     CHIP_ERROR ProcessInvokeResponseIB(InvokeResponseIB::Parser & aInvokeResponse);
 
     // Send our queued-up Invoke Request message.  Assumes the exchange is ready
@@ -265,6 +303,15 @@ private:
 
     CHIP_ERROR Finalize(System::PacketBufferHandle & commandPacket);
 
+    // End Of Container (0x18) uses one byte.
+    static constexpr uint16_t kReservedSizeForEndOfContainer = 1;
+    // Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
+    // context tag, 1 byte for value
+    static constexpr uint16_t kReservedSizeForIMRevision = 1 + 1 + 1;
+    // Reserved buffer for closing a batch of commands (end of InvokeRequests, IM revision, end of InvokeRequestMessage).
+    static constexpr uint16_t kReservedSizeForTLVEncodingOverhead =
+        kReservedSizeForEndOfContainer + kReservedSizeForIMRevision + kReservedSizeForEndOfContainer;
+
     Messaging::ExchangeHolder mExchangeCtx;
     Callback * mpCallback                      = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -283,6 +330,9 @@ private:
     State mState = State::Idle;
     chip::System::PacketBufferTLVWriter mCommandMessageWriter;
     bool mBufferAllocated = false;
+    // In batch mode, the InvokeRequests are only closed when the request is sent.
+    bool mBatchCommands         = false;
+    uint16_t mBatchCommandCount = 0;
 };
 
 } // namespace app
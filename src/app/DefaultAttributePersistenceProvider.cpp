@@ -33,6 +33,45 @@ CHIP_ERROR DefaultAttributePersistenceProvider::WriteValue(const ConcreteAttribu
     {
         return CHIP_ERROR_BUFFER_TOO_SMALL;
     }
+
+    BatchedWrite * batchedWrite = FindBatchedWrite(aPath);
+    if (batchedWrite != nullptr && batchedWrite->mBatch != mActiveBatch)
+    {
+        // The attribute is written outside of the batch its value was held back for, which may only end much later: the
+        // new value supersedes it and is persisted right away.
+        RemoveBatchedWrite(*batchedWrite);
+    }
+    else if (mActiveBatch != nullptr)
+    {
+        if (batchedWrite == nullptr && mBatchedWriteCount < ArraySize(mBatchedWrites))
+        {
+            batchedWrite         = &mBatchedWrites[mBatchedWriteCount++];
+            batchedWrite->mPath  = aPath;
+            batchedWrite->mBatch = mActiveBatch;
+        }
+
+        if (batchedWrite != nullptr)
+        {
+            if (batchedWrite->mValue.AllocatedSize() != aValue.size())
+            {
+                batchedWrite->mValue.Alloc(aValue.size());
+            }
+            if (batchedWrite->mValue)
+            {
+                memcpy(batchedWrite->mValue.Get(), aValue.data(), aValue.size());
+                return CHIP_NO_ERROR;
+            }
+
+            // The value can't be held back: forget about the attribute and write it right away.
+            RemoveBatchedWrite(*batchedWrite);
+        }
+    }
+
+    return StoreValue(aPath, aValue);
+}
+
+CHIP_ERROR DefaultAttributePersistenceProvider::StoreValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
     return mStorage->SyncSetKeyValue(
         DefaultStorageKeyAllocator::AttributeValue(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId).KeyName(),
         aValue.data(), static_cast<uint16_t>(aValue.size()));
@@ -44,30 +83,118 @@ CHIP_ERROR DefaultAttributePersistenceProvider::ReadValue(const ConcreteAttribut
     VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
     uint16_t size = static_cast<uint16_t>(min(aValue.size(), static_cast<size_t>(UINT16_MAX)));
-    ReturnErrorOnFailure(mStorage->SyncGetKeyValue(
-        DefaultStorageKeyAllocator::AttributeValue(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId).KeyName(),
-        aValue.data(), size));
+    if (const BatchedWrite * batchedWrite = FindBatchedWrite(aPath))
+    {
+        // The value held back is newer than the one in the storage.
+        VerifyOrReturnError(batchedWrite->mValue.AllocatedSize() <= size, CHIP_ERROR_BUFFER_TOO_SMALL);
+        size = static_cast<uint16_t>(batchedWrite->mValue.AllocatedSize());
+        memcpy(aValue.data(), batchedWrite->mValue.Get(), size);
+    }
+    else
+    {
+        ReturnErrorOnFailure(mStorage->SyncGetKeyValue(
+            DefaultStorageKeyAllocator::AttributeValue(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId).KeyName(),
+            aValue.data(), size));
+    }
+    return ValidateReadValue(aMetadata, size, aValue);
+}
+
+void DefaultAttributePersistenceProvider::Shutdown()
+{
+    while (mBatchedWriteCount > 0)
+    {
+        PersistBatchedWrite(mBatchedWrites[0]);
+    }
+    mActiveBatch = nullptr;
+}
+
+void DefaultAttributePersistenceProvider::SuspendBatch(const void * aBatch)
+{
+    if (mActiveBatch == aBatch)
+    {
+        mActiveBatch = nullptr;
+    }
+}
+
+void DefaultAttributePersistenceProvider::EndBatch(const void * aBatch)
+{
+    SuspendBatch(aBatch);
+
+    for (size_t i = 0; i < mBatchedWriteCount;)
+    {
+        if (mBatchedWrites[i].mBatch != aBatch)
+        {
+            i++;
+            continue;
+        }
+
+        // Replaces the write at i with the last one.
+        PersistBatchedWrite(mBatchedWrites[i]);
+    }
+}
+
+DefaultAttributePersistenceProvider::BatchedWrite *
+DefaultAttributePersistenceProvider::FindBatchedWrite(const ConcreteAttributePath & aPath)
+{
+    for (size_t i = 0; i < mBatchedWriteCount; i++)
+    {
+        if (mBatchedWrites[i].mPath == aPath)
+        {
+            return &mBatchedWrites[i];
+        }
+    }
+    return nullptr;
+}
+
+void DefaultAttributePersistenceProvider::RemoveBatchedWrite(BatchedWrite & aBatchedWrite)
+{
+    // Fill the hole with the last batched write.
+    aBatchedWrite.mValue.Free();
+    aBatchedWrite = std::move(mBatchedWrites[--mBatchedWriteCount]);
+}
+
+void DefaultAttributePersistenceProvider::PersistBatchedWrite(BatchedWrite & aBatchedWrite)
+{
+    const ByteSpan value(aBatchedWrite.mValue.Get(), aBatchedWrite.mValue.AllocatedSize());
+
+    CHIP_ERROR err = StoreValue(aBatchedWrite.mPath, value);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement,
+                     "Failed to persist attribute endpoint=%u Cluster=" ChipLogFormatMEI " attribute=" ChipLogFormatMEI
+                     ": %" CHIP_ERROR_FORMAT,
+                     aBatchedWrite.mPath.mEndpointId, ChipLogValueMEI(aBatchedWrite.mPath.mClusterId),
+                     ChipLogValueMEI(aBatchedWrite.mPath.mAttributeId), err.Format());
+    }
+    RemoveBatchedWrite(aBatchedWrite);
+}
+
+CHIP_ERROR AttributePersistenceProvider::ValidateReadValue(const EmberAfAttributeMetadata * aMetadata, size_t aSize,
+                                                           MutableByteSpan & aValue)
+{
+    VerifyOrReturnError(aSize <= aValue.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
     EmberAfAttributeType type = aMetadata->attributeType;
     if (emberAfIsStringAttributeType(type))
     {
         // Ensure that we've read enough bytes that we are not ending up with
         // un-initialized memory.  Should have read length + 1 (for the length
         // byte).
-        VerifyOrReturnError(size >= emberAfStringLength(aValue.data()) + 1, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(aSize >= emberAfStringLength(aValue.data()) + 1u, CHIP_ERROR_INCORRECT_STATE);
     }
     else if (emberAfIsLongStringAttributeType(type))
     {
         // Ensure that we've read enough bytes that we are not ending up with
         // un-initialized memory.  Should have read length + 2 (for the length
         // bytes).
-        VerifyOrReturnError(size >= emberAfLongStringLength(aValue.data()) + 2, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(aSize >= emberAfLongStringLength(aValue.data()) + 2u, CHIP_ERROR_INCORRECT_STATE);
     }
     else
     {
         // Ensure we got the expected number of bytes for all other types.
-        VerifyOrReturnError(size == aMetadata->size, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(aSize == aMetadata->size, CHIP_ERROR_INCORRECT_STATE);
     }
-    aValue.reduce_size(size);
+    aValue.reduce_size(aSize);
     return CHIP_NO_ERROR;
 }
 
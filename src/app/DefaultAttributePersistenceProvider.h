@@ -16,8 +16,10 @@
 #pragma once
 
 #include <app/AttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace app {
@@ -29,6 +31,12 @@ namespace app {
  * NOTE: SetAttributePersistenceProvider must still be called with an instance
  * of this class, since it can't be constructed automatically without knowing
  * what PersistentStorageDelegate is to be used.
+ *
+ * Within a batch, up to CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES values are
+ * held back and written to the storage once per attribute when the batch
+ * ends, so that an attribute written several times during a write transaction
+ * is only persisted once, after the transaction.  A value held back for a
+ * batch is persisted right away when the attribute is written outside of it.
  */
 class DefaultAttributePersistenceProvider : public AttributePersistenceProvider
 {
@@ -46,15 +54,35 @@ public:
         return CHIP_NO_ERROR;
     }
 
-    void Shutdown() {}
+    void Shutdown();
 
     // AttributePersistenceProvider implementation.
     CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
+    void StartBatch(const void * aBatch) override { mActiveBatch = aBatch; }
+    void SuspendBatch(const void * aBatch) override;
+    void EndBatch(const void * aBatch) override;
 
 protected:
     PersistentStorageDelegate * mStorage;
+
+private:
+    struct BatchedWrite
+    {
+        ConcreteAttributePath mPath;
+        const void * mBatch = nullptr;
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    };
+
+    CHIP_ERROR StoreValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue);
+    BatchedWrite * FindBatchedWrite(const ConcreteAttributePath & aPath);
+    void RemoveBatchedWrite(BatchedWrite & aBatchedWrite);
+    void PersistBatchedWrite(BatchedWrite & aBatchedWrite);
+
+    BatchedWrite mBatchedWrites[CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES];
+    size_t mBatchedWriteCount = 0;
+    const void * mActiveBatch = nullptr;
 };
 
 } // namespace app
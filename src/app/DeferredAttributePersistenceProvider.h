@@ -69,6 +69,9 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
                          MutableByteSpan & value) override;
+    void StartBatch(const void * batch) override { mPersister.StartBatch(batch); }
+    void SuspendBatch(const void * batch) override { mPersister.SuspendBatch(batch); }
+    void EndBatch(const void * batch) override { mPersister.EndBatch(batch); }
 
 private:
     void FlushAndScheduleNext();
@@ -22,6 +22,7 @@
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
+#include <algorithm>
 #include <assert.h>
 #include <inttypes.h>
 #include <lib/core/TLVUtilities.h>
@@ -57,6 +58,74 @@ public:
     virtual ~CircularEventReader() = default;
 };
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+/**
+ * @brief
+ *   A read-only TLV backing store exposing a range of the data of a CircularEventBuffer, accounting for wraparound.
+ */
+class CircularEventBufferSpan : public TLV::TLVBackingStore
+{
+public:
+    /**
+     * @param[in] aBuffer  The buffer holding the data.
+     * @param[in] aOffset  Offset of the range from the head of the buffer, in bytes.
+     * @param[in] aLength  Length of the range, in bytes.
+     */
+    CircularEventBufferSpan(const CircularEventBuffer & aBuffer, uint32_t aOffset, uint32_t aLength)
+    {
+        const uint32_t bufferSize = aBuffer.GetTotalDataLength();
+        uint32_t start            = static_cast<uint32_t>(aBuffer.QueueHead() - aBuffer.GetQueue()) + aOffset;
+        if (start >= bufferSize)
+        {
+            start -= bufferSize;
+        }
+
+        mpQueue       = aBuffer.GetQueue();
+        mpStart       = mpQueue + start;
+        mFirstLength  = std::min(aLength, bufferSize - start);
+        mSecondLength = aLength - mFirstLength;
+    }
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mpStart;
+        bufLen   = mFirstLength;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        // The reader asks for more data once it reached the end of the part of the range that precedes the wraparound.
+        if (bufStart == mpStart + mFirstLength && mSecondLength > 0)
+        {
+            bufStart = mpQueue;
+            bufLen   = mSecondLength;
+        }
+        else
+        {
+            bufLen = 0;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mpQueue = nullptr;
+    const uint8_t * mpStart = nullptr;
+    uint32_t mFirstLength   = 0;
+    uint32_t mSecondLength  = 0;
+};
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 EventManagement & EventManagement::GetInstance()
 {
     return sInstance;
@@ -114,16 +183,139 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
 
         current->mProcessEvictedElement = nullptr;
         current->mAppData               = nullptr;
+
+        if (apLogStorageResources[bufferIndex].mpStore != nullptr)
+        {
+            CHIP_ERROR err = current->Restore(apLogStorageResources[bufferIndex].mpStore);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(EventLogging, "Failed to restore events with priority %u: %" CHIP_ERROR_FORMAT,
+                             static_cast<unsigned>(apLogStorageResources[bufferIndex].mPriority), err.Format());
+            }
+        }
     }
 
     mpEventNumberCounter = apEventNumberCounter;
-    mLastEventNumber     = mpEventNumberCounter->GetValue();
+    mpEventBuffer        = apCircularEventBuffer;
+    RestoreEventNumber();
+    mLastEventNumber = mpEventNumberCounter->GetValue();
 
-    mpEventBuffer = apCircularEventBuffer;
     mState        = EventManagementStates::Idle;
     mBytesWritten = 0;
 
     mMonotonicStartupTime = aMonotonicStartupTime;
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    mNumBuffers = aNumBuffers;
+    for (auto & index : mEventLogIndex)
+    {
+        index.Clear();
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+}
+
+CHIP_ERROR EventManagement::RecordEventNumber(const TLVReader & aReader, size_t, void * apContext)
+{
+    RestoredEventsContext * const restored = static_cast<RestoredEventsContext *>(apContext);
+    TLVReader reader;
+    TLVType containerType;
+    TLVType containerType1;
+    EventEnvelopeContext event;
+
+    reader.Init(aReader);
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.EnterContainer(containerType1));
+
+    CHIP_ERROR err = TLV::Utilities::Iterate(reader, FetchEventParameters, &event, false /*recurse*/);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+
+    if (restored->mCount == 0)
+    {
+        restored->mFirst = event.mEventNumber;
+    }
+    restored->mLast = event.mEventNumber;
+    restored->mCount++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::GetRestoredEvents(CircularEventBuffer & aBuffer, RestoredEventsContext & aRestored)
+{
+    CircularTLVReader reader;
+    reader.Init(aBuffer);
+
+    aRestored.mCount = 0;
+    CHIP_ERROR err   = TLV::Utilities::Iterate(reader, RecordEventNumber, &aRestored, false /*recurse*/);
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
+void EventManagement::RestoreEventNumber()
+{
+    bool restored           = false;
+    EventNumber lastRestored = 0;
+
+    // Buffers are walked from the one holding the oldest events.  Promoting an event writes it to the next buffer before
+    // evicting it from its current one, so a process stopping in between leaves a stale copy at the head of the less
+    // critical buffer.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        RestoredEventsContext events;
+        CHIP_ERROR err = GetRestoredEvents(*buffer, events);
+        while (err == CHIP_NO_ERROR && restored && events.mCount > 0 && events.mFirst <= lastRestored)
+        {
+            buffer->mProcessEvictedElement = nullptr;
+            err                            = buffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                err = GetRestoredEvents(*buffer, events);
+            }
+        }
+
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(EventLogging, "Failed to read restored events with priority %u: %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(buffer->GetPriority()), err.Format());
+            continue;
+        }
+
+        if (events.mCount > 0)
+        {
+            restored     = true;
+            lastRestored = events.mLast;
+        }
+    }
+
+    VerifyOrReturn(restored);
+    ChipLogProgress(EventLogging, "Restored events up to event number 0x" ChipLogFormatX64, ChipLogValueX64(lastRestored));
+
+    // Event numbers must keep increasing across restarts.
+    const EventNumber current = mpEventNumberCounter->GetValue();
+    VerifyOrReturn(current <= lastRestored);
+
+    CHIP_ERROR err = mpEventNumberCounter->AdvanceBy(lastRestored - current + 1);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "%s AdvanceBy() failed with %" CHIP_ERROR_FORMAT, __FUNCTION__, err.Format());
+    }
+}
+
+void EventManagement::ClearEvents()
+{
+    VerifyOrReturn(mState != EventManagementStates::Shutdown);
+
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        buffer->Clear();
+    }
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    for (auto & index : mEventLogIndex)
+    {
+        index.Clear();
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
 }
 
 CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
@@ -155,6 +347,8 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    IndexCopiedHead(apEventBuffer);
+
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
     if (err != CHIP_NO_ERROR)
@@ -192,12 +386,17 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
     {
         if (requiredSpace > eventBuffer->AvailableDataLength())
         {
+            uint32_t dataLength           = eventBuffer->DataLength();
             ctx.mpEventBuffer             = eventBuffer;
             ctx.mSpaceNeededForMovedEvent = 0;
 
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                IndexEvictedHead(eventBuffer, dataLength - eventBuffer->DataLength());
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -226,6 +425,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    IndexEvictedHead(eventBuffer, dataLength - eventBuffer->DataLength());
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -380,14 +580,18 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
+    // Events restored from a previous run may carry system timestamps larger than the ones of later events, deltas are only
+    // used when time moved forward.
     if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue))
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
     }
     if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue))
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
@@ -468,6 +672,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     SuccessOrExit(err);
 
     mBytesWritten += writer.GetLengthWritten();
+    IndexLoggedEvent(opts, mLastEventNumber, writer.GetLengthWritten());
 
 exit:
     if (err != CHIP_NO_ERROR)
@@ -642,19 +847,30 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const ObjectLi
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
 {
-    // TODO: Add particular set of event Paths in FetchEventsSince so that we can filter the interested paths
-    CHIP_ERROR err     = CHIP_NO_ERROR;
-    const bool recurse = false;
-    TLVReader reader;
-    CircularEventBufferWrapper bufWrapper;
+    CHIP_ERROR err = CHIP_NO_ERROR;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    // Buffers are visited in the same order as the reader returned by GetEventReader, i.e. from the most critical one.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        err = FetchEventsFromBuffer(*buffer, context);
+        SuccessOrExit(err);
+    }
+#else
+    const bool recurse = false;
+    TLVReader reader;
+    CircularEventBufferWrapper bufWrapper;
+
+    err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
     if (err == CHIP_END_OF_TLV)
     {
         err = CHIP_NO_ERROR;
@@ -725,6 +941,19 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     TLVReader reader;
     CircularEventBufferWrapper bufWrapper;
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    for (auto & index : mEventLogIndex)
+    {
+        for (size_t i = 0; i < index.Count(); i++)
+        {
+            if (index[i].mHasFabricIndex && index[i].mFabricIndex == aFabricIndex)
+            {
+                index[i].mFabricIndex = kUndefinedFabricIndex;
+            }
+        }
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     ReturnErrorOnFailure(GetEventReader(reader, PriorityLevel::Critical, &bufWrapper));
     CHIP_ERROR err = TLV::Utilities::Iterate(reader, FabricRemovedCB, &aFabricIndex, recurse);
     if (err == CHIP_END_OF_TLV)
@@ -843,6 +1072,142 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
     return CHIP_END_OF_TLV;
 }
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+EventLogIndex * EventManagement::GetEventLogIndex(const CircularEventBuffer * apBuffer)
+{
+    VerifyOrReturnValue(apBuffer != nullptr && apBuffer >= mpEventBuffer, nullptr);
+
+    const size_t position = static_cast<size_t>(apBuffer - mpEventBuffer);
+    VerifyOrReturnValue(position < mNumBuffers && position < kMaxIndexedBuffers, nullptr);
+    return &mEventLogIndex[position];
+}
+
+void EventManagement::IndexLoggedEvent(const EventOptions & aOptions, EventNumber aEventNumber, uint32_t aLength)
+{
+    EventLogIndex * index = GetEventLogIndex(mpEventBuffer);
+    VerifyOrReturn(index != nullptr);
+
+    EventLogIndex::Entry entry;
+    entry.mEventNumber    = aEventNumber;
+    entry.mClusterId      = aOptions.mPath.mClusterId;
+    entry.mEventId        = aOptions.mPath.mEventId;
+    entry.mLength         = aLength;
+    entry.mEndpointId     = aOptions.mPath.mEndpointId;
+    entry.mFabricIndex    = aOptions.mFabricIndex;
+    entry.mHasFabricIndex = (aOptions.mFabricIndex != kUndefinedFabricIndex);
+    index->Append(entry);
+}
+
+void EventManagement::IndexEvictedHead(CircularEventBuffer * apBuffer, uint32_t aLength)
+{
+    EventLogIndex * index = GetEventLogIndex(apBuffer);
+    VerifyOrReturn(index != nullptr);
+
+    // The evicted event was indexed only if the index described the whole buffer before the eviction.
+    const uint32_t previousLength = apBuffer->DataLength() + aLength;
+    if (index->IndexedBytes() == previousLength && index->Count() > 0 && (*index)[0].mLength == aLength)
+    {
+        index->RemoveFirst();
+    }
+    else if (index->IndexedBytes() > apBuffer->DataLength())
+    {
+        // The index no longer matches the buffer; fall back to walking the TLV.
+        index->Clear();
+    }
+}
+
+void EventManagement::IndexCopiedHead(CircularEventBuffer * apBuffer)
+{
+    EventLogIndex * index     = GetEventLogIndex(apBuffer);
+    EventLogIndex * nextIndex = GetEventLogIndex(apBuffer->GetNextCircularEventBuffer());
+    VerifyOrReturn(nextIndex != nullptr);
+
+    if (index != nullptr && index->Count() > 0 && index->IndexedBytes() == apBuffer->DataLength())
+    {
+        nextIndex->Append((*index)[0]);
+    }
+    else
+    {
+        // The copied event is not indexed, and the index must describe the newest events of the buffer.
+        nextIndex->Clear();
+    }
+}
+
+CHIP_ERROR EventManagement::FetchEventsFromBuffer(CircularEventBuffer & aBuffer, EventLoadOutContext & aContext)
+{
+    const EventLogIndex * index = GetEventLogIndex(&aBuffer);
+    const size_t indexCount     = (index != nullptr) ? index->Count() : 0;
+    const uint32_t indexedBytes = (index != nullptr) ? index->IndexedBytes() : 0;
+    VerifyOrReturnError(indexedBytes <= aBuffer.DataLength(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Events older than the first indexed one are read as usual.
+    uint32_t offset = aBuffer.DataLength() - indexedBytes;
+    if (offset > 0)
+    {
+        CircularEventBufferSpan span(aBuffer, 0, offset);
+        TLVReader reader;
+        reader.Init(span, offset);
+
+        CHIP_ERROR err = TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, false /*recurse*/);
+        VerifyOrReturnError(err == CHIP_END_OF_TLV || err == CHIP_NO_ERROR, err);
+    }
+
+    for (size_t i = 0; i < indexCount; i++)
+    {
+        const EventLogIndex::Entry & entry = (*index)[i];
+        const uint32_t eventOffset         = offset;
+        offset += entry.mLength;
+
+        EventEnvelopeContext event;
+        event.mEndpointId = entry.mEndpointId;
+        event.mClusterId  = entry.mClusterId;
+        event.mEventId    = entry.mEventId;
+        if (entry.mHasFabricIndex)
+        {
+            event.mFabricIndex.SetValue(entry.mFabricIndex);
+        }
+
+        aContext.mCurrentEventNumber = entry.mEventNumber;
+        CHIP_ERROR err               = CheckEventContext(&aContext, event);
+        if (err == CHIP_ERROR_UNEXPECTED_EVENT)
+        {
+            continue;
+        }
+        ReturnErrorOnFailure(err);
+
+        // Only the events to report are decoded.
+        CircularEventBufferSpan span(aBuffer, eventOffset, entry.mLength);
+        TLVReader reader;
+        reader.Init(span, entry.mLength);
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(CopyEventsSince(reader, 0, &aContext));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void EventLogIndex::Append(const Entry & aEntry)
+{
+    if (mCount == CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE)
+    {
+        RemoveFirst();
+    }
+
+    mEntries[(mFirst + mCount) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE] = aEntry;
+    mCount++;
+    mIndexedBytes += aEntry.mLength;
+}
+
+void EventLogIndex::RemoveFirst()
+{
+    VerifyOrReturn(mCount > 0);
+
+    mIndexedBytes -= mEntries[mFirst].mLength;
+    mFirst = (mFirst + 1) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE;
+    mCount--;
+}
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const
 {
     aEventNumber              = mLastEventNumber;
@@ -856,6 +1221,74 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mpPrev    = apPrev;
     mpNext    = apNext;
     mPriority = aPriorityLevel;
+    mpStore   = nullptr;
+}
+
+CHIP_ERROR CircularEventBuffer::Restore(CircularEventBufferStore * apStore)
+{
+    uint32_t headOffset = 0;
+    uint32_t dataLength = 0;
+
+    VerifyOrReturnError(apStore != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mpStore = apStore;
+
+    CHIP_ERROR err = mpStore->LoadState(headOffset, dataLength);
+    if (err == CHIP_ERROR_NOT_FOUND)
+    {
+        CommitState();
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    if (headOffset >= GetTotalDataLength() || dataLength > GetTotalDataLength())
+    {
+        CommitState();
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+    SetQueueState(GetQueue() + headOffset, dataLength);
+
+    // Only keep the events that can be read back entirely.
+    CircularTLVReader reader;
+    reader.Init(*this);
+    uint32_t validLength = 0;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        SuccessOrExit(err = reader.Skip());
+        validLength = reader.GetLengthRead();
+    }
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    if (validLength != dataLength)
+    {
+        ChipLogError(EventLogging, "Discarding %" PRIu32 " bytes of unreadable events with priority %u", dataLength - validLength,
+                     static_cast<unsigned>(mPriority));
+        SetQueueState(GetQueue() + headOffset, validLength);
+    }
+    CommitState();
+    return err;
+}
+
+CHIP_ERROR CircularEventBuffer::EvictHead()
+{
+    ReturnErrorOnFailure(TLVCircularBuffer::EvictHead());
+    CommitState();
+    return CHIP_NO_ERROR;
+}
+
+void CircularEventBuffer::Clear()
+{
+    SetQueueState(GetQueue(), 0);
+    CommitState();
+}
+
+void CircularEventBuffer::CommitState()
+{
+    VerifyOrReturn(mpStore != nullptr);
+    mpStore->SaveState(static_cast<uint32_t>(QueueHead() - GetQueue()), DataLength());
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -874,6 +1307,28 @@ CHIP_ERROR CircularEventBuffer::OnInit(TLV::TLVWriter & writer, uint8_t *& bufSt
     return CHIP_NO_ERROR;
 }
 
+/**
+ * @brief
+ * The writer may evict the oldest event to get space; commit the eviction before the space gets overwritten.
+ */
+CHIP_ERROR CircularEventBuffer::GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    const uint32_t dataLength = DataLength();
+    ReturnErrorOnFailure(TLVCircularBuffer::GetNewBuffer(writer, bufStart, bufLen));
+    if (DataLength() != dataLength)
+    {
+        CommitState();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CircularEventBuffer::FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen)
+{
+    ReturnErrorOnFailure(TLVCircularBuffer::FinalizeBuffer(writer, bufStart, bufLen));
+    CommitState();
+    return CHIP_NO_ERROR;
+}
+
 void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 {
     CircularEventBuffer * prev;
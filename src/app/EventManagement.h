@@ -76,6 +76,35 @@ constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   Persistence of the state of a CircularEventBuffer whose storage outlives the process, e.g. a memory-mapped file.
+ *
+ *   The store only records where the events are within the storage; the events themselves are written in place.
+ */
+class CircularEventBufferStore
+{
+public:
+    virtual ~CircularEventBufferStore() = default;
+
+    /**
+     * @brief
+     *   Load the last committed state of the buffer.
+     *
+     * @param[out] aHeadOffset  Offset of the oldest event from the start of the storage, in bytes.
+     * @param[out] aDataLength  Length of the events held in the storage, in bytes.
+     *
+     * @retval CHIP_ERROR_NOT_FOUND if no state was committed, the storage is then considered empty.
+     */
+    virtual CHIP_ERROR LoadState(uint32_t & aHeadOffset, uint32_t & aDataLength) = 0;
+
+    /**
+     * @brief
+     *   Commit the state of the buffer.  Called once the events it describes are in place in the storage.
+     */
+    virtual void SaveState(uint32_t aHeadOffset, uint32_t aDataLength) = 0;
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -128,6 +157,30 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Resume from the events left in the storage by a previous run, and commit any later change of the buffer to
+     *   apStore.
+     *
+     *   Events that cannot be decoded, e.g. because they were being written when the process stopped, are discarded along
+     *   with any event that follows them.
+     *
+     * @param[in] apStore  The store holding the state of the storage passed to Init.
+     */
+    CHIP_ERROR Restore(CircularEventBufferStore * apStore);
+
+    /**
+     * @brief
+     *   Evicts the oldest event, see TLV::TLVCircularBuffer::EvictHead.
+     */
+    CHIP_ERROR EvictHead();
+
+    /**
+     * @brief
+     *   Drops all the events held in the buffer, and commits the empty buffer to the store if there is one.
+     */
+    void Clear();
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -139,7 +192,13 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    CircularEventBufferStore * mpStore = nullptr; ///< Optional store persisting the state of the buffer
+
+    void CommitState();
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+    CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+    CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override;
 };
 
 class CircularEventReader;
@@ -160,6 +219,63 @@ private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
 };
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+/**
+ * @brief
+ *   A fixed-size index of the most recent events stored in one CircularEventBuffer, in storage order (internal API).
+ *
+ *   The index always describes the newest events of the buffer: when it is full, the entry of the oldest event is dropped,
+ *   and events stored before the first entry have to be located by walking the TLV.
+ */
+class EventLogIndex
+{
+public:
+    struct Entry
+    {
+        EventNumber mEventNumber = 0;
+        ClusterId mClusterId     = 0;
+        EventId mEventId         = 0;
+        uint32_t mLength         = 0; ///< Encoded size of the event in the buffer, in bytes
+        EndpointId mEndpointId   = 0;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        bool mHasFabricIndex     = false;
+    };
+
+    void Clear()
+    {
+        mFirst        = 0;
+        mCount        = 0;
+        mIndexedBytes = 0;
+    }
+
+    size_t Count() const { return mCount; }
+
+    /**
+     * The number of bytes, at the end of the buffer, occupied by the indexed events.
+     */
+    uint32_t IndexedBytes() const { return mIndexedBytes; }
+
+    Entry & operator[](size_t aIndex) { return mEntries[(mFirst + aIndex) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE]; }
+    const Entry & operator[](size_t aIndex) const { return mEntries[(mFirst + aIndex) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE]; }
+
+    /**
+     * Record an event appended to the buffer, dropping the entry of the oldest event if the index is full.
+     */
+    void Append(const Entry & aEntry);
+
+    /**
+     * Forget the entry of the oldest indexed event.
+     */
+    void RemoveFirst();
+
+private:
+    Entry mEntries[CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+    size_t mFirst          = 0;
+    size_t mCount          = 0;
+    uint32_t mIndexedBytes = 0;
+};
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 enum class EventManagementStates
 {
     Idle       = 1, // No log offload in progress, log offload can begin without any constraints
@@ -187,6 +303,8 @@ struct LogStorageResources
     uint32_t mBufferSize = 0; ///< The size, in bytes, of the `mBuffer`.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    CircularEventBufferStore * mpStore = nullptr; // Optional.  When provided, `mpBuffer` outlives the process and the events
+                                                  // it holds are restored on Init.
 };
 
 /**
@@ -376,6 +494,12 @@ public:
      */
     EventNumber GetLastEventNumber() const { return mLastEventNumber; }
 
+    /**
+     * @brief
+     *   Drop all the logged events, including those kept in persistent storage, e.g. on factory reset.
+     */
+    void ClearEvents();
+
     /**
      * @brief
      *   IsValid returns whether the EventManagement instance is valid
@@ -411,6 +535,25 @@ private:
         Optional<FabricIndex> mFabricIndex;
     };
 
+    /**
+     * @brief
+     *  Internal structure for reading the event numbers of restored events.
+     */
+    struct RestoredEventsContext
+    {
+        EventNumber mFirst = 0;
+        EventNumber mLast  = 0;
+        size_t mCount      = 0;
+    };
+
+    /**
+     * @brief Drop the duplicated events left by a promotion interrupted by a restart, and make sure the event number
+     * counter is past the restored events.
+     */
+    void RestoreEventNumber();
+    static CHIP_ERROR GetRestoredEvents(CircularEventBuffer & aBuffer, RestoredEventsContext & aRestored);
+    static CHIP_ERROR RecordEventNumber(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
+
     void VendEventNumber();
     CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
     /**
@@ -545,6 +688,38 @@ private:
      */
     CircularEventBuffer * GetPriorityBuffer(PriorityLevel aPriority) const;
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    /**
+     * @brief Get the event index of a buffer, or nullptr if the buffer is not indexed.
+     */
+    EventLogIndex * GetEventLogIndex(const CircularEventBuffer * apBuffer);
+
+    /**
+     * @brief Record an event that was just written to the lowest-priority buffer.
+     */
+    void IndexLoggedEvent(const EventOptions & aOptions, EventNumber aEventNumber, uint32_t aLength);
+
+    /**
+     * @brief Update the index of a buffer whose head event, of aLength bytes, was just evicted.
+     */
+    void IndexEvictedHead(CircularEventBuffer * apBuffer, uint32_t aLength);
+
+    /**
+     * @brief Record, in the index of the next buffer, the head event of apBuffer that was just copied there.
+     */
+    void IndexCopiedHead(CircularEventBuffer * apBuffer);
+
+    /**
+     * @brief Copy the matching events of a single buffer, using its index to skip events that are not matching without
+     * decoding them.
+     */
+    CHIP_ERROR FetchEventsFromBuffer(CircularEventBuffer & aBuffer, EventLoadOutContext & aContext);
+#else
+    void IndexLoggedEvent(const EventOptions & aOptions, EventNumber aEventNumber, uint32_t aLength) {}
+    void IndexEvictedHead(CircularEventBuffer * apBuffer, uint32_t aLength) {}
+    void IndexCopiedHead(CircularEventBuffer * apBuffer) {}
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     // EventBuffer for debug level,
     CircularEventBuffer * mpEventBuffer        = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -558,6 +733,13 @@ private:
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    static constexpr uint32_t kMaxIndexedBuffers = to_underlying(PriorityLevel::Last) + 1;
+
+    EventLogIndex mEventLogIndex[kMaxIndexedBuffers]; ///< Index of the buffer at the same position in the mpEventBuffer array
+    uint32_t mNumBuffers = 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
 };
 } // namespace app
 } // namespace chip
@@ -64,6 +64,16 @@ CHIP_ERROR CommandDataIB::Parser::PrettyPrint() const
             ReturnErrorOnFailure(CheckIMPayload(reader, 0, "CommandFields"));
             PRETTY_PRINT_DECDEPTH();
             break;
+        case to_underlying(Tag::kRef):
+            VerifyOrReturnError(TLV::kTLVType_UnsignedInteger == reader.GetType(), CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint16_t ref;
+                ReturnErrorOnFailure(reader.Get(ref));
+                PRETTY_PRINT("\tRef = 0x%x,", ref);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
         default:
             PRETTY_PRINT("Unknown tag num %" PRIu32, tagNum);
             break;
@@ -96,12 +106,27 @@ CHIP_ERROR CommandDataIB::Parser::GetFields(TLV::TLVReader * const apReader) con
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandDataIB::Parser::GetRef(uint16_t * const apRef) const
+{
+    return GetUnsignedInteger(to_underlying(Tag::kRef), apRef);
+}
+
 CommandPathIB::Builder & CommandDataIB::Builder::CreatePath()
 {
     mError = mPath.Init(mpWriter, to_underlying(Tag::kPath));
     return mPath;
 }
 
+CommandDataIB::Builder & CommandDataIB::Builder::Ref(const uint16_t aRef)
+{
+    // skip if error has already been set
+    if (mError == CHIP_NO_ERROR)
+    {
+        mError = mpWriter->Put(TLV::ContextTag(Tag::kRef), aRef);
+    }
+    return *this;
+}
+
 CommandDataIB::Builder & CommandDataIB::Builder::EndOfCommandDataIB()
 {
     EndOfContainer();
@@ -37,6 +37,7 @@ enum class Tag : uint8_t
 {
     kPath        = 0,
     kErrorStatus = 1,
+    kRef         = 2,
 };
 
 class Parser : public StructParser
@@ -67,6 +68,17 @@ public:
      *          #CHIP_END_OF_TLV if there is no such element
      */
     CHIP_ERROR GetErrorStatus(StatusIB::Parser * const apErrorStatus) const;
+
+    /**
+     *  @brief Get the CommandRef of the command this status is for, within a batch of commands.
+     *
+     *  @param [in] apRef    A pointer to apRef
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_ERROR_WRONG_TLV_TYPE if there is such element but it's not an unsigned integer
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetRef(uint16_t * const apRef) const;
 };
 
 class Builder : public StructBuilder
@@ -86,6 +98,13 @@ public:
      */
     StatusIB::Builder & CreateErrorStatus();
 
+    /**
+     *  @brief Set the CommandRef of the command this status is for, within a batch of commands.
+     *
+     *  @return A reference to *this
+     */
+    CommandStatusIB::Builder & Ref(const uint16_t aRef);
+
     /**
      *  @brief Mark the end of this CommandStatusIB
      *
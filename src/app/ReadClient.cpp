@@ -95,6 +95,11 @@ ReadClient::~ReadClient()
     {
         StopResubscription();
 
+        if (mpTimerDelegate != nullptr)
+        {
+            mpTimerDelegate->OnReadClientDestroyed(this);
+        }
+
         // Only remove ourselves from the engine's tracker list if we still continue to have a valid pointer to it.
         // This won't be the case if the engine shut down before this destructor was called (in which case, mpImEngine
         // will point to null)
@@ -154,9 +159,17 @@ CHIP_ERROR ReadClient::ScheduleResubscription(uint32_t aTimeTillNextResubscripti
         mReadPrepareParams.mSessionHolder->AsSecureSession()->MarkAsDefunct();
     }
 
-    ReturnErrorOnFailure(
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-            System::Clock::Milliseconds32(aTimeTillNextResubscriptionMs), OnResubscribeTimerCallback, this));
+    if (mpTimerDelegate != nullptr)
+    {
+        ReturnErrorOnFailure(mpTimerDelegate->StartResubscribeTimer(
+            this, System::Clock::Milliseconds32(aTimeTillNextResubscriptionMs), OnResubscribeTimerCallback));
+    }
+    else
+    {
+        ReturnErrorOnFailure(
+            InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
+                System::Clock::Milliseconds32(aTimeTillNextResubscriptionMs), OnResubscribeTimerCallback, this));
+    }
     mIsResubscriptionScheduled = true;
 
     return CHIP_NO_ERROR;
@@ -800,8 +813,15 @@ CHIP_ERROR ReadClient::RefreshLivenessCheckTimer()
         DataManagement,
         "Refresh LivenessCheckTime for %lu milliseconds with SubscriptionId = 0x%08" PRIx32 " Peer = %02x:" ChipLogFormatX64,
         static_cast<long unsigned>(timeout.count()), mSubscriptionId, GetFabricIndex(), ChipLogValueX64(GetPeerNodeId()));
-    err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-        timeout, OnLivenessTimeoutCallback, this);
+    if (mpTimerDelegate != nullptr)
+    {
+        err = mpTimerDelegate->StartLivenessTimer(this, timeout, OnLivenessTimeoutCallback);
+    }
+    else
+    {
+        err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
+            timeout, OnLivenessTimeoutCallback, this);
+    }
 
     return err;
 }
@@ -839,14 +859,27 @@ CHIP_ERROR ReadClient::ComputeLivenessCheckTimerTimeout(System::Clock::Timeout *
 
 void ReadClient::CancelLivenessCheckTimer()
 {
+    if (mpTimerDelegate != nullptr)
+    {
+        mpTimerDelegate->CancelLivenessTimer(this);
+        return;
+    }
+
     InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
         OnLivenessTimeoutCallback, this);
 }
 
 void ReadClient::CancelResubscribeTimer()
 {
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnResubscribeTimerCallback, this);
+    if (mpTimerDelegate != nullptr)
+    {
+        mpTimerDelegate->CancelResubscribeTimer(this);
+    }
+    else
+    {
+        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
+            OnResubscribeTimerCallback, this);
+    }
     mIsResubscriptionScheduled = false;
 }
 
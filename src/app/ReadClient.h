@@ -251,6 +251,40 @@ public:
         virtual void OnUnsolicitedMessageFromPublisher(ReadClient * apReadClient) {}
     };
 
+    /**
+     * A TimerDelegate takes over the liveness and re-subscription timers of subscriptions, which otherwise run as
+     * System::Layer timers of their own.  This lets a controller with many subscriptions share timers between them and
+     * schedule their re-subscriptions together (see ClientSubscriptionManager).
+     *
+     * When a timer expires, the delegate must call the callback provided when the timer was started, with the ReadClient as
+     * its app state.
+     */
+    class TimerDelegate
+    {
+    public:
+        virtual ~TimerDelegate() = default;
+
+        /**
+         * Start the liveness timer of apReadClient, replacing any liveness timer already started for it.
+         */
+        virtual CHIP_ERROR StartLivenessTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                              System::TimerCompleteCallback aCallback) = 0;
+        virtual void CancelLivenessTimer(ReadClient * apReadClient) = 0;
+
+        /**
+         * Start the re-subscription timer of apReadClient, replacing any re-subscription timer already started for it.
+         * The delegate may defer the re-subscription past aTimeout, e.g. to spread re-subscriptions over time.
+         */
+        virtual CHIP_ERROR StartResubscribeTimer(ReadClient * apReadClient, System::Clock::Timeout aTimeout,
+                                                 System::TimerCompleteCallback aCallback) = 0;
+        virtual void CancelResubscribeTimer(ReadClient * apReadClient) = 0;
+
+        /**
+         * Called when apReadClient is destroyed, after its timers were cancelled.
+         */
+        virtual void OnReadClientDestroyed(ReadClient * apReadClient) = 0;
+    };
+
     enum class InteractionType : uint8_t
     {
         Read,
@@ -337,6 +371,12 @@ public:
         return CHIP_NO_ERROR;
     }
 
+    /**
+     * Set the delegate handling the timers of this subscription.  Must be called before the subscription is requested, and
+     * the delegate must outlive this ReadClient.
+     */
+    void SetTimerDelegate(TimerDelegate * apTimerDelegate) { mpTimerDelegate = apTimerDelegate; }
+
     ReadClient * GetNextClient() { return mpNext; }
     void SetNextClient(ReadClient * apClient) { mpNext = apClient; }
 
@@ -554,6 +594,7 @@ private:
 
     ReadClient * mpNext                 = nullptr;
     InteractionModelEngine * mpImEngine = nullptr;
+    TimerDelegate * mpTimerDelegate     = nullptr;
 
     //
     // This stores the params associated with the interaction in a specific set of cases:
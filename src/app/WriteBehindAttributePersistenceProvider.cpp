@@ -0,0 +1,265 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteBehindAttributePersistenceProvider.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::Init(System::Layer * systemLayer, const Config & config)
+{
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mSystemLayer = systemLayer;
+    mConfig      = config;
+    return CHIP_NO_ERROR;
+}
+
+void WriteBehindAttributePersistenceProvider::Shutdown()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+    Flush();
+    mSystemLayer = nullptr;
+}
+
+void WriteBehindAttributePersistenceProvider::Flush()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+    PersistDueAttributes(System::SystemClock().GetMonotonicTimestamp(), true /* all */);
+    CancelFlush();
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & path, const ByteSpan & value)
+{
+    mStats.mWriteCount++;
+
+    DirtyAttribute * attribute = FindDirtyAttribute(path);
+    if (mSystemLayer == nullptr || mActiveBatch != nullptr)
+    {
+        // The value being written supersedes the one held back.
+        if (attribute != nullptr)
+        {
+            RemoveDirtyAttribute(*attribute);
+        }
+        mStats.mPersistCount++;
+        return mPersister.WriteValue(path, value);
+    }
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    if (attribute == nullptr)
+    {
+        if (mDirtyAttributeCount == ArraySize(mDirtyAttributes))
+        {
+            // Make room by persisting the attribute due first.
+            DirtyAttribute * first = &mDirtyAttributes[0];
+            for (size_t i = 1; i < mDirtyAttributeCount; i++)
+            {
+                if (GetFlushTime(mDirtyAttributes[i]) < GetFlushTime(*first))
+                {
+                    first = &mDirtyAttributes[i];
+                }
+            }
+            PersistDirtyAttribute(*first);
+        }
+
+        attribute                  = &mDirtyAttributes[mDirtyAttributeCount++];
+        attribute->mPath           = path;
+        attribute->mFirstWriteTime = now;
+    }
+
+    if (attribute->mValue.AllocatedSize() != value.size())
+    {
+        attribute->mValue.Alloc(value.size());
+    }
+    if (!attribute->mValue)
+    {
+        // The value can't be held back, write it right away.
+        RemoveDirtyAttribute(*attribute);
+        mStats.mPersistCount++;
+        return mPersister.WriteValue(path, value);
+    }
+
+    memcpy(attribute->mValue.Get(), value.data(), value.size());
+    attribute->mLastWriteTime = now;
+
+    // Further writes only push the flush time of the attribute back, so the timer only needs to be brought forward when an
+    // attribute becomes dirty.
+    if (!mFlushScheduled || GetFlushTime(*attribute) < mScheduledFlushTime)
+    {
+        ScheduleFlush(now);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & path,
+                                                              const EmberAfAttributeMetadata * metadata, MutableByteSpan & value)
+{
+    const DirtyAttribute * attribute = FindDirtyAttribute(path);
+    if (attribute == nullptr)
+    {
+        return mPersister.ReadValue(path, metadata, value);
+    }
+
+    // The value held back is newer than the persisted one, and is checked the same way.
+    ReturnErrorOnFailure(CopySpanToMutableSpan(ByteSpan(attribute->mValue.Get(), attribute->mValue.AllocatedSize()), value));
+    return ValidateReadValue(metadata, value.size(), value);
+}
+
+void WriteBehindAttributePersistenceProvider::StartBatch(const void * batch)
+{
+    mActiveBatch = batch;
+    mPersister.StartBatch(batch);
+}
+
+void WriteBehindAttributePersistenceProvider::SuspendBatch(const void * batch)
+{
+    if (mActiveBatch == batch)
+    {
+        mActiveBatch = nullptr;
+    }
+    mPersister.SuspendBatch(batch);
+}
+
+void WriteBehindAttributePersistenceProvider::EndBatch(const void * batch)
+{
+    if (mActiveBatch == batch)
+    {
+        mActiveBatch = nullptr;
+    }
+    mPersister.EndBatch(batch);
+}
+
+System::Clock::Timestamp WriteBehindAttributePersistenceProvider::GetFlushTime(const DirtyAttribute & attribute) const
+{
+    return std::min(attribute.mLastWriteTime + mConfig.mFlushInterval, attribute.mFirstWriteTime + mConfig.mMaxLatency);
+}
+
+WriteBehindAttributePersistenceProvider::DirtyAttribute *
+WriteBehindAttributePersistenceProvider::FindDirtyAttribute(const ConcreteAttributePath & path)
+{
+    for (size_t i = 0; i < mDirtyAttributeCount; i++)
+    {
+        if (mDirtyAttributes[i].mPath == path)
+        {
+            return &mDirtyAttributes[i];
+        }
+    }
+    return nullptr;
+}
+
+void WriteBehindAttributePersistenceProvider::RemoveDirtyAttribute(DirtyAttribute & attribute)
+{
+    // Fill the hole with the last dirty attribute.
+    attribute.mValue.Free();
+    attribute = std::move(mDirtyAttributes[--mDirtyAttributeCount]);
+}
+
+void WriteBehindAttributePersistenceProvider::PersistDirtyAttribute(DirtyAttribute & attribute)
+{
+    CHIP_ERROR err = mPersister.WriteValue(attribute.mPath, ByteSpan(attribute.mValue.Get(), attribute.mValue.AllocatedSize()));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement,
+                     "Failed to persist attribute endpoint=%u Cluster=" ChipLogFormatMEI " attribute=" ChipLogFormatMEI
+                     ": %" CHIP_ERROR_FORMAT,
+                     attribute.mPath.mEndpointId, ChipLogValueMEI(attribute.mPath.mClusterId),
+                     ChipLogValueMEI(attribute.mPath.mAttributeId), err.Format());
+    }
+    mStats.mPersistCount++;
+    RemoveDirtyAttribute(attribute);
+}
+
+void WriteBehindAttributePersistenceProvider::PersistDueAttributes(System::Clock::Timestamp now, bool all)
+{
+    bool batchStarted = false;
+
+    for (size_t i = 0; i < mDirtyAttributeCount;)
+    {
+        if (!all && GetFlushTime(mDirtyAttributes[i]) > now)
+        {
+            i++;
+            continue;
+        }
+
+        if (!batchStarted)
+        {
+            mPersister.StartBatch(this);
+            batchStarted = true;
+        }
+        // Replaces the attribute at i with the last one.
+        PersistDirtyAttribute(mDirtyAttributes[i]);
+    }
+
+    if (batchStarted)
+    {
+        mPersister.EndBatch(this);
+    }
+}
+
+void WriteBehindAttributePersistenceProvider::ScheduleFlush(System::Clock::Timestamp now)
+{
+    if (mDirtyAttributeCount == 0)
+    {
+        CancelFlush();
+        return;
+    }
+
+    System::Clock::Timestamp flushTime = GetFlushTime(mDirtyAttributes[0]);
+    for (size_t i = 1; i < mDirtyAttributeCount; i++)
+    {
+        flushTime = std::min(flushTime, GetFlushTime(mDirtyAttributes[i]));
+    }
+
+    const System::Clock::Timeout delay = (flushTime > now) ? (flushTime - now) : System::Clock::kZero;
+    CHIP_ERROR err                     = mSystemLayer->StartTimer(delay, OnFlushTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Without a timer, nothing would persist the dirty attributes.
+        ChipLogError(DataManagement, "Failed to schedule attribute persistence: %" CHIP_ERROR_FORMAT, err.Format());
+        PersistDueAttributes(now, true /* all */);
+        CancelFlush();
+        return;
+    }
+
+    mFlushScheduled     = true;
+    mScheduledFlushTime = flushTime;
+}
+
+void WriteBehindAttributePersistenceProvider::CancelFlush()
+{
+    VerifyOrReturn(mFlushScheduled);
+    mSystemLayer->CancelTimer(OnFlushTimer, this);
+    mFlushScheduled = false;
+}
+
+void WriteBehindAttributePersistenceProvider::OnFlushTimer(System::Layer * systemLayer, void * appState)
+{
+    auto * self                        = static_cast<WriteBehindAttributePersistenceProvider *>(appState);
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    self->mFlushScheduled = false;
+    self->PersistDueAttributes(now, false /* all */);
+    self->ScheduleFlush(now);
+}
+
+} // namespace app
+} // namespace chip
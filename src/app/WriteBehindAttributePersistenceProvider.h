@@ -0,0 +1,123 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Decorator class for the AttributePersistenceProvider implementation that
+ * writes attribute values behind, for all the attributes.
+ *
+ * A written value is held back, and the attribute is marked dirty, until the
+ * attribute has remained unchanged for the flush interval, or at most for the
+ * max latency since it became dirty if it keeps changing.  Dirty attributes
+ * due at the same time are passed on to the decorated provider as one batch.
+ *
+ * This generalizes DeferredAttributePersistenceProvider to all the attributes,
+ * so that attributes changing on every tick of a transition, such as the
+ * CurrentLevel attribute of the LevelControl cluster, are only persisted once
+ * the transition is over.
+ *
+ * Values written while a batch is in progress, i.e. by a write interaction,
+ * are not held back but passed on to the decorated provider right away, so
+ * that the client is only told about a successful write once it is persisted.
+ *
+ * Shutdown must be called before the System::Layer is shut down, to persist the
+ * attributes still dirty.
+ */
+class WriteBehindAttributePersistenceProvider : public AttributePersistenceProvider
+{
+public:
+    struct Config
+    {
+        System::Clock::Milliseconds32 mFlushInterval{ CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_FLUSH_INTERVAL_MS };
+        System::Clock::Milliseconds32 mMaxLatency{ CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_MAX_LATENCY_MS };
+    };
+
+    struct Stats
+    {
+        uint64_t mWriteCount   = 0; ///< Values written to this provider.
+        uint64_t mPersistCount = 0; ///< Values passed on to the decorated provider.
+    };
+
+    explicit WriteBehindAttributePersistenceProvider(AttributePersistenceProvider & persister) : mPersister(persister) {}
+
+    /*
+     * Until Init is called, values are passed on to the decorated provider right away.
+     */
+    CHIP_ERROR Init(System::Layer * systemLayer) { return Init(systemLayer, Config()); }
+    CHIP_ERROR Init(System::Layer * systemLayer, const Config & config);
+
+    /*
+     * Persist the attributes still dirty and stop holding back values.
+     */
+    void Shutdown();
+
+    /*
+     * Persist all the dirty attributes right away.
+     */
+    void Flush();
+
+    const Stats & GetStats() const { return mStats; }
+
+    // AttributePersistenceProvider implementation.
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & path, const ByteSpan & value) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & path, const EmberAfAttributeMetadata * metadata,
+                         MutableByteSpan & value) override;
+    void StartBatch(const void * batch) override;
+    void SuspendBatch(const void * batch) override;
+    void EndBatch(const void * batch) override;
+
+private:
+    struct DirtyAttribute
+    {
+        ConcreteAttributePath mPath;
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+        System::Clock::Timestamp mFirstWriteTime;
+        System::Clock::Timestamp mLastWriteTime;
+    };
+
+    System::Clock::Timestamp GetFlushTime(const DirtyAttribute & attribute) const;
+    DirtyAttribute * FindDirtyAttribute(const ConcreteAttributePath & path);
+    void RemoveDirtyAttribute(DirtyAttribute & attribute);
+    void PersistDirtyAttribute(DirtyAttribute & attribute);
+    void PersistDueAttributes(System::Clock::Timestamp now, bool all);
+    void ScheduleFlush(System::Clock::Timestamp now);
+    void CancelFlush();
+
+    static void OnFlushTimer(System::Layer * systemLayer, void * appState);
+
+    AttributePersistenceProvider & mPersister;
+    System::Layer * mSystemLayer = nullptr;
+    Config mConfig;
+    DirtyAttribute mDirtyAttributes[CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES];
+    size_t mDirtyAttributeCount = 0;
+    const void * mActiveBatch   = nullptr;
+    bool mFlushScheduled        = false;
+    System::Clock::Timestamp mScheduledFlushTime;
+    Stats mStats;
+};
+
+} // namespace app
+} // namespace chip
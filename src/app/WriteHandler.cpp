@@ -55,6 +55,7 @@ void WriteHandler::Close()
     // wasSuccessful here is safe: if it does anything, we were in fact not
     // successful.
     DeliverFinalListWriteEnd(false /* wasSuccessful */);
+    EndPersistenceBatch();
     mExchangeCtx.Release();
     mSuppressResponse = false;
     MoveToState(State::Uninitialized);
@@ -73,8 +74,21 @@ Status WriteHandler::HandleWriteRequestMessage(Messaging::ExchangeContext * apEx
     mWriteResponseBuilder.CreateWriteResponses();
     VerifyOrReturnError(mWriteResponseBuilder.GetError() == CHIP_NO_ERROR, Status::Failure);
 
+    StartPersistenceBatch();
     Status status = ProcessWriteRequest(std::move(aPayload), aIsTimedWrite);
 
+    // Persist the values written by the transaction before the response to its last chunk, so that the client is not told
+    // about a successful write before it is persisted.  In between chunks, the batch is suspended so that it only holds back
+    // the values written by this transaction.
+    if (status == Status::Success && mHasMoreChunks)
+    {
+        SuspendPersistenceBatch();
+    }
+    else
+    {
+        EndPersistenceBatch();
+    }
+
     // Do not send response on Group Write
     if (status == Status::Success && !apExchangeContext->IsGroupExchangeContext())
     {
@@ -190,6 +204,29 @@ exit:
     return err;
 }
 
+void WriteHandler::StartPersistenceBatch()
+{
+    if (mpPersistenceBatch == nullptr)
+    {
+        mpPersistenceBatch = GetAttributePersistenceProvider();
+        VerifyOrReturn(mpPersistenceBatch != nullptr);
+    }
+    mpPersistenceBatch->StartBatch(this);
+}
+
+void WriteHandler::SuspendPersistenceBatch()
+{
+    VerifyOrReturn(mpPersistenceBatch != nullptr);
+    mpPersistenceBatch->SuspendBatch(this);
+}
+
+void WriteHandler::EndPersistenceBatch()
+{
+    VerifyOrReturn(mpPersistenceBatch != nullptr);
+    mpPersistenceBatch->EndBatch(this);
+    mpPersistenceBatch = nullptr;
+}
+
 void WriteHandler::DeliverListWriteBegin(const ConcreteAttributePath & aPath)
 {
     if (auto * attrOverride = GetAttributeAccessOverride(aPath.mEndpointId, aPath.mClusterId))
@@ -18,6 +18,7 @@
 
 #pragma once
 #include <app/AttributeAccessToken.h>
+#include <app/AttributePersistenceProvider.h>
 #include <app/AttributePathParams.h>
 #include <app/MessageDef/WriteResponseMessage.h>
 #include <lib/core/CHIPCore.h>
@@ -150,6 +151,13 @@ private:
 
     CHIP_ERROR AddStatus(const ConcreteDataAttributePath & aPath, const StatusIB & aStatus);
 
+    // The attribute values persisted while processing the chunks of a write transaction are batched, so that the WriteResponse
+    // to each chunk does not wait on the storage and each attribute is persisted once, before the response to the last chunk.
+    // The batch is suspended in between chunks.
+    void StartPersistenceBatch();
+    void SuspendPersistenceBatch();
+    void EndPersistenceBatch();
+
 private:
     // ExchangeDelegate
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PayloadHeader & aPayloadHeader,
@@ -175,6 +183,8 @@ private:
     //  Where (1)-(3) will be consistent among the whole list write request, while (4) and (5) are not appliable to group writes.
     bool mAttributeWriteSuccessful                = false;
     Optional<AttributeAccessToken> mACLCheckCache = NullOptional;
+    // The provider a persistence batch was started on, if any.
+    AttributePersistenceProvider * mpPersistenceBatch = nullptr;
 };
 } // namespace app
 } // namespace chip
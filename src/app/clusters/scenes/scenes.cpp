@@ -282,7 +282,7 @@ bool emberAfScenesClusterRemoveSceneCallback(app::CommandHandler * commandObj, c
 
     app::ConcreteCommandPath path = { commandPath.mEndpointId, Scenes::Id, RemoveSceneResponse::Id };
     TLV::TLVWriter * writer       = nullptr;
-    SuccessOrExit(err = commandObj->PrepareCommand(path));
+    SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
     VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
     SuccessOrExit(err = writer->Put(TLV::ContextTag(1), groupId));
@@ -328,7 +328,7 @@ bool emberAfScenesClusterRemoveAllScenesCallback(app::CommandHandler * commandOb
 
     app::ConcreteCommandPath path = { commandPath.mEndpointId, Scenes::Id, RemoveAllScenesResponse::Id };
     TLV::TLVWriter * writer       = nullptr;
-    SuccessOrExit(err = commandObj->PrepareCommand(path));
+    SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
     VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
     SuccessOrExit(err = writer->Put(TLV::ContextTag(1), groupId));
@@ -355,7 +355,7 @@ bool emberAfScenesClusterStoreSceneCallback(app::CommandHandler * commandObj, co
 
     app::ConcreteCommandPath path = { commandPath.mEndpointId, Scenes::Id, StoreSceneResponse::Id };
     TLV::TLVWriter * writer       = nullptr;
-    SuccessOrExit(err = commandObj->PrepareCommand(path));
+    SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
     VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
     SuccessOrExit(err = writer->Put(TLV::ContextTag(1), groupId));
@@ -447,7 +447,7 @@ bool emberAfScenesClusterGetSceneMembershipCallback(app::CommandHandler * comman
     {
         app::ConcreteCommandPath path = { commandPath.mEndpointId, Scenes::Id, GetSceneMembershipResponse::Id };
         TLV::TLVWriter * writer       = nullptr;
-        SuccessOrExit(err = commandObj->PrepareCommand(path));
+        SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
         VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
         SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
         SuccessOrExit(
@@ -1093,7 +1093,7 @@ kickout:
         path = { commandPath.mEndpointId, Scenes::Id, EnhancedAddSceneResponse::Id };
     }
     TLV::TLVWriter * writer = nullptr;
-    SuccessOrExit(err = commandObj->PrepareCommand(path));
+    SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
     VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
     SuccessOrExit(err = writer->Put(TLV::ContextTag(1), groupId));
@@ -1148,7 +1148,7 @@ bool emberAfPluginScenesServerParseViewScene(app::CommandHandler * commandObj, c
         path = { commandPath.mEndpointId, Scenes::Id, EnhancedViewSceneResponse::Id };
     }
     TLV::TLVWriter * writer = nullptr;
-    SuccessOrExit(err = commandObj->PrepareCommand(path));
+    SuccessOrExit(err = commandObj->PrepareInvokeResponseCommand(commandPath, path));
     VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
     SuccessOrExit(err = writer->Put(TLV::ContextTag(1), groupId));
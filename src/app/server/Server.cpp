@@ -141,7 +141,12 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     // Set up attribute persistence before we try to bring up the data model
     // handler.
     SuccessOrExit(mAttributePersister.Init(mDeviceStorage));
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    SuccessOrExit(mWriteBehindAttributePersister.Init(&DeviceLayer::SystemLayer()));
+    SetAttributePersistenceProvider(&mWriteBehindAttributePersister);
+#else
     SetAttributePersistenceProvider(&mAttributePersister);
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
 
     {
         FabricTable::InitParams fabricTableInitParams;
@@ -234,8 +239,11 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
             { &sCritEventBuffer[0], sizeof(sCritEventBuffer), ::chip::app::PriorityLevel::Critical }
         };
 
+        const ::chip::app::LogStorageResources * storageResources =
+            (initParams.eventLogStorageResources != nullptr) ? initParams.eventLogStorageResources : &logStorageResources[0];
+
         chip::app::EventManagement::GetInstance().Init(&mExchangeMgr, CHIP_NUM_EVENT_LOGGING_BUFFERS, &sLoggingBuffer[0],
-                                                       &logStorageResources[0], &sGlobalEventIdCounter,
+                                                       storageResources, &sGlobalEventIdCounter,
                                                        std::chrono::duration_cast<System::Clock::Milliseconds64>(mInitTimestamp));
     }
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
@@ -454,6 +462,10 @@ void Server::ScheduleFactoryReset()
         // Delete all fabrics and emit Leave event.
         GetInstance().GetFabricTable().DeleteAllFabrics();
         PlatformMgr().HandleServerShuttingDown();
+#if CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
+        // Events kept in persistent storage must not survive the factory reset.
+        chip::app::EventManagement::GetInstance().ClearEvents();
+#endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
         ConfigurationMgr().InitiateFactoryReset();
     });
 }
@@ -477,6 +489,9 @@ void Server::Shutdown()
     mAccessControl.Finish();
     Access::ResetAccessControlToDefault();
     Credentials::SetGroupDataProvider(nullptr);
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    mWriteBehindAttributePersister.Shutdown();
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
     mAttributePersister.Shutdown();
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryShutdown();
@@ -24,10 +24,12 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/DefaultAttributePersistenceProvider.h>
+#include <app/EventManagement.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
 #include <app/TestEventTriggerDelegate.h>
+#include <app/WriteBehindAttributePersistenceProvider.h>
 #include <app/server/AclStorage.h>
 #include <app/server/AppDelegate.h>
 #include <app/server/CommissioningWindowManager.h>
@@ -130,6 +132,9 @@ struct ServerInitParams
     // Optional. Support test event triggers when provided. Must be initialized before being
     // provided.
     TestEventTriggerDelegate * testEventTriggerDelegate = nullptr;
+    // Optional. Storage for the event log, one per priority level (Debug, Info, Critical), in place of
+    // the statically allocated buffers. Must remain valid while the server runs.
+    const app::LogStorageResources * eventLogStorageResources = nullptr;
     // Operational keystore with access to the operational keys: MUST be injected.
     Crypto::OperationalKeystore * operationalKeystore = nullptr;
     // Operational certificate store with access to the operational certs in persisted storage:
@@ -579,6 +584,9 @@ private:
     Credentials::GroupDataProvider * mGroupsProvider;
     Crypto::SessionKeystore * mSessionKeystore;
     app::DefaultAttributePersistenceProvider mAttributePersister;
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    app::WriteBehindAttributePersistenceProvider mWriteBehindAttributePersister{ mAttributePersister };
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
     GroupDataProviderListener mListener;
     ServerFabricDelegate mFabricDelegate;
 
@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeUpdateIngestor.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr ClusterId kCluster = 8;
+
+// Records the updates applied; drains are run by the test.
+class RecordingIngestor : public AttributeUpdateIngestor
+{
+public:
+    std::vector<AttributeUpdate> mApplied;
+    std::atomic<unsigned> mDrainsScheduled{ 0 };
+    CHIP_ERROR mScheduleError = CHIP_NO_ERROR;
+
+protected:
+    void ApplyUpdate(AttributeUpdate & update) override { mApplied.push_back(update); }
+    CHIP_ERROR ScheduleDrain() override
+    {
+        mDrainsScheduled++;
+        return mScheduleError;
+    }
+};
+
+CHIP_ERROR UpdateUint8(AttributeUpdateIngestor::Producer & aProducer, EndpointId aEndpoint, uint8_t aValue)
+{
+    return aProducer.UpdateAttribute(ConcreteAttributePath(aEndpoint, kCluster, 0), 0x20, ByteSpan(&aValue, sizeof(aValue)));
+}
+
+void TestCoalescing(nlTestSuite * aSuite, void * aContext)
+{
+    RecordingIngestor ingestor;
+    AttributeUpdateIngestor::Producer producer;
+
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 1, 0) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(aSuite, ingestor.RegisterProducer(producer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.RegisterProducer(producer) == CHIP_ERROR_INCORRECT_STATE);
+
+    // A burst of updates schedules a single drain, and is applied once per attribute with the latest value.
+    for (uint8_t value = 1; value <= 10; value++)
+    {
+        NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 1, value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 2, static_cast<uint8_t>(value * 2)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, producer.MarkAttributeDirty(ConcreteAttributePath(1, kCluster, 0)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, producer.MarkAttributeDirty(ConcreteAttributePath(3, kCluster, 0)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 1);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.empty());
+
+    ingestor.Drain();
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 3);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[0].mPath.mEndpointId == 1);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[0].mHasValue && ingestor.mApplied[0].mType == 0x20);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[0].mValueSize == 1 && ingestor.mApplied[0].mValue[0] == 10);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[1].mPath.mEndpointId == 2);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[1].mValueSize == 1 && ingestor.mApplied[1].mValue[0] == 20);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[2].mPath.mEndpointId == 3);
+    NL_TEST_ASSERT(aSuite, !ingestor.mApplied[2].mHasValue);
+
+    // The next update schedules another drain.
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 1, 11) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 2);
+
+    // Unregistering applies the updates still buffered.
+    ingestor.UnregisterProducer(producer);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 4);
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 1, 12) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+void TestBufferFull(nlTestSuite * aSuite, void * aContext)
+{
+    RecordingIngestor ingestor;
+    AttributeUpdateIngestor::Producer producer;
+    uint8_t largeValue[CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE + 1] = {};
+
+    NL_TEST_ASSERT(aSuite, ingestor.RegisterProducer(producer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite,
+                   producer.UpdateAttribute(ConcreteAttributePath(0, kCluster, 0), 0x41, ByteSpan(largeValue)) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    for (EndpointId endpoint = 0; endpoint < CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE; endpoint++)
+    {
+        NL_TEST_ASSERT(aSuite, UpdateUint8(producer, endpoint, 1) == CHIP_NO_ERROR);
+    }
+
+    // Attributes already buffered can still be updated, others have to wait for the drain.
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 0, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE, 1) == CHIP_ERROR_NO_MEMORY);
+    ingestor.Drain();
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE, 1) == CHIP_NO_ERROR);
+
+    // A drain that could not be scheduled is scheduled again by the next update.
+    ingestor.Drain();
+    ingestor.mScheduleError = CHIP_ERROR_NO_MEMORY;
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 0, 3) == CHIP_ERROR_NO_MEMORY);
+    ingestor.mScheduleError = CHIP_NO_ERROR;
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer, 0, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 4);
+
+    ingestor.UnregisterProducer(producer);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE + 2);
+}
+
+// Buffers a newer value of every update it applies, as a producer thread would while the Matter thread drains.
+class UpdatingIngestor : public RecordingIngestor
+{
+public:
+    AttributeUpdateIngestor::Producer * mUpdatingProducer = nullptr;
+
+protected:
+    void ApplyUpdate(AttributeUpdate & update) override
+    {
+        RecordingIngestor::ApplyUpdate(update);
+        if (mUpdatingProducer != nullptr)
+        {
+            UpdateUint8(*mUpdatingProducer, update.mPath.mEndpointId, static_cast<uint8_t>(update.mValue[0] + 1));
+        }
+    }
+};
+
+void TestUpdateWhileDraining(nlTestSuite * aSuite, void * aContext)
+{
+    UpdatingIngestor ingestor;
+    AttributeUpdateIngestor::Producer producer1;
+    AttributeUpdateIngestor::Producer producer2;
+
+    NL_TEST_ASSERT(aSuite, ingestor.RegisterProducer(producer1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.RegisterProducer(producer2) == CHIP_NO_ERROR);
+
+    // The producers share a single drain, and updates of the same path by different producers are not coalesced.
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer1, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer1, 2, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, UpdateUint8(producer2, 2, 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 1);
+
+    // Producers are drained latest registered first.  The update producer1 buffers while producer2 is applied supersedes
+    // the one producer1 still buffered; the ones it buffers while it is applied go to its other buffer, and schedule
+    // another drain.
+    ingestor.mUpdatingProducer = &producer1;
+    ingestor.Drain();
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 3);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[0].mPath.mEndpointId == 2 && ingestor.mApplied[0].mValue[0] == 5);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[1].mPath.mEndpointId == 1 && ingestor.mApplied[1].mValue[0] == 1);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[2].mPath.mEndpointId == 2 && ingestor.mApplied[2].mValue[0] == 6);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 2);
+
+    ingestor.mUpdatingProducer = nullptr;
+    ingestor.Drain();
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 5);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[3].mPath.mEndpointId == 1 && ingestor.mApplied[3].mValue[0] == 2);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied[4].mPath.mEndpointId == 2 && ingestor.mApplied[4].mValue[0] == 7);
+    NL_TEST_ASSERT(aSuite, ingestor.mDrainsScheduled == 2);
+
+    ingestor.Drain();
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 5);
+
+    ingestor.UnregisterProducer(producer1);
+    ingestor.UnregisterProducer(producer2);
+    NL_TEST_ASSERT(aSuite, ingestor.mApplied.size() == 5);
+}
+
+} // namespace
+
+int TestAttributeUpdateIngestor()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestCoalescing", TestCoalescing),
+        NL_TEST_DEF("TestBufferFull", TestBufferFull),
+        NL_TEST_DEF("TestUpdateWhileDraining", TestUpdateWhileDraining),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "AttributeUpdateIngestor",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeUpdateIngestor)
@@ -0,0 +1,194 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClientSubscriptionManager.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using chip::app::ResubscribeRateLimiter;
+using chip::app::SubscriptionTimerWheel;
+using chip::System::Clock::Milliseconds32;
+using chip::System::Clock::Milliseconds64;
+using chip::System::Clock::Timestamp;
+
+namespace {
+
+struct TimerRecord
+{
+    SubscriptionTimerWheel * mpWheel = nullptr;
+    Timestamp mExpiredAt;
+    unsigned mExpiryCount = 0;
+    // If non-zero, the timer reschedules itself this far after its expiry.
+    Milliseconds32 mReschedule = Milliseconds32(0);
+    Timestamp mNow;
+};
+
+void OnTimerExpired(SubscriptionTimerWheel::Timer & aTimer, void * apContext)
+{
+    TimerRecord * record = static_cast<TimerRecord *>(apContext);
+    record->mExpiredAt   = record->mNow;
+    record->mExpiryCount++;
+    if (record->mReschedule.count() != 0)
+    {
+        record->mpWheel->Schedule(aTimer, record->mNow + record->mReschedule);
+    }
+}
+
+void Advance(SubscriptionTimerWheel & aWheel, TimerRecord * apRecords, size_t aRecordCount, Timestamp aNow)
+{
+    for (size_t i = 0; i < aRecordCount; i++)
+    {
+        apRecords[i].mNow = aNow;
+    }
+    aWheel.Advance(aNow);
+}
+
+void TestWheelExpiry(nlTestSuite * aSuite, void * aContext)
+{
+    SubscriptionTimerWheel wheel(Milliseconds32(100), 8);
+    TimerRecord records[3];
+    SubscriptionTimerWheel::Timer timers[3];
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        records[i].mpWheel = &wheel;
+        timers[i].Init(OnTimerExpired, &records[i]);
+    }
+
+    NL_TEST_ASSERT(aSuite, wheel.IsEmpty());
+
+    // Within the current turn of the wheel, on a tick boundary, and several turns away.
+    wheel.Schedule(timers[0], Timestamp(250));
+    wheel.Schedule(timers[1], Timestamp(300));
+    wheel.Schedule(timers[2], Timestamp(2050));
+    NL_TEST_ASSERT(aSuite, !wheel.IsEmpty());
+    NL_TEST_ASSERT(aSuite, timers[0].IsScheduled() && timers[0].GetDeadline() == Timestamp(250));
+
+    // Timers never expire before their deadline.
+    Advance(wheel, records, 3, Timestamp(249));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 0);
+
+    Advance(wheel, records, 3, Timestamp(300));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 1 && records[0].mExpiredAt == Timestamp(300));
+    NL_TEST_ASSERT(aSuite, records[1].mExpiryCount == 1 && records[1].mExpiredAt == Timestamp(300));
+    NL_TEST_ASSERT(aSuite, !timers[0].IsScheduled() && !timers[1].IsScheduled());
+
+    // The slot of the far timer comes up several times before it is due.
+    for (uint64_t now = 400; now < 2050; now += 100)
+    {
+        Advance(wheel, records, 3, Timestamp(now));
+        NL_TEST_ASSERT(aSuite, records[2].mExpiryCount == 0);
+    }
+
+    // Advancing by more than a turn at once still expires the timer, up to one tick late.
+    Advance(wheel, records, 3, Timestamp(5000));
+    NL_TEST_ASSERT(aSuite, records[2].mExpiryCount == 1);
+    NL_TEST_ASSERT(aSuite, wheel.IsEmpty());
+}
+
+void TestWheelCancelAndReschedule(nlTestSuite * aSuite, void * aContext)
+{
+    SubscriptionTimerWheel wheel(Milliseconds32(100), 4);
+    TimerRecord records[2];
+    SubscriptionTimerWheel::Timer timers[2];
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        records[i].mpWheel = &wheel;
+        timers[i].Init(OnTimerExpired, &records[i]);
+    }
+
+    wheel.Schedule(timers[0], Timestamp(100));
+    wheel.Cancel(timers[0]);
+    NL_TEST_ASSERT(aSuite, !timers[0].IsScheduled());
+    NL_TEST_ASSERT(aSuite, wheel.IsEmpty());
+
+    // Scheduling a scheduled timer moves it.
+    wheel.Schedule(timers[0], Timestamp(100));
+    wheel.Schedule(timers[0], Timestamp(600));
+    Advance(wheel, records, 2, Timestamp(500));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 0);
+    Advance(wheel, records, 2, Timestamp(600));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 1);
+
+    // A timer can reschedule itself from its callback, and is not expired again by the same Advance.
+    records[1].mReschedule = Milliseconds32(200);
+    wheel.Schedule(timers[1], Timestamp(700));
+    Advance(wheel, records, 2, Timestamp(700));
+    NL_TEST_ASSERT(aSuite, records[1].mExpiryCount == 1);
+    NL_TEST_ASSERT(aSuite, timers[1].IsScheduled() && timers[1].GetDeadline() == Timestamp(900));
+    Advance(wheel, records, 2, Timestamp(800));
+    NL_TEST_ASSERT(aSuite, records[1].mExpiryCount == 1);
+    Advance(wheel, records, 2, Timestamp(900));
+    NL_TEST_ASSERT(aSuite, records[1].mExpiryCount == 2);
+
+    // A deadline already past is scheduled on the next tick.
+    wheel.Cancel(timers[1]);
+    wheel.Schedule(timers[0], Timestamp(0));
+    Advance(wheel, records, 2, Timestamp(950));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 1);
+    Advance(wheel, records, 2, Timestamp(1000));
+    NL_TEST_ASSERT(aSuite, records[0].mExpiryCount == 2);
+    NL_TEST_ASSERT(aSuite, wheel.IsEmpty());
+}
+
+void TestRateLimiter(nlTestSuite * aSuite, void * aContext)
+{
+    ResubscribeRateLimiter limiter;
+    Milliseconds32 wait;
+
+    // 4 per second, in bursts of up to 2.
+    limiter.Init(4, 2, Timestamp(1000));
+    NL_TEST_ASSERT(aSuite, limiter.TryAcquire(Timestamp(1000), wait));
+    NL_TEST_ASSERT(aSuite, limiter.TryAcquire(Timestamp(1000), wait));
+    NL_TEST_ASSERT(aSuite, !limiter.TryAcquire(Timestamp(1000), wait));
+    NL_TEST_ASSERT(aSuite, wait == Milliseconds32(250));
+
+    // Part of a token has been refilled.
+    NL_TEST_ASSERT(aSuite, !limiter.TryAcquire(Timestamp(1100), wait));
+    NL_TEST_ASSERT(aSuite, wait == Milliseconds32(150));
+    NL_TEST_ASSERT(aSuite, limiter.TryAcquire(Timestamp(1250), wait));
+    NL_TEST_ASSERT(aSuite, !limiter.TryAcquire(Timestamp(1250), wait));
+
+    // The bucket does not fill up beyond the burst size.
+    NL_TEST_ASSERT(aSuite, limiter.TryAcquire(Timestamp(Milliseconds64(60000)), wait));
+    NL_TEST_ASSERT(aSuite, limiter.TryAcquire(Timestamp(Milliseconds64(60000)), wait));
+    NL_TEST_ASSERT(aSuite, !limiter.TryAcquire(Timestamp(Milliseconds64(60000)), wait));
+}
+
+} // namespace
+
+int TestClientSubscriptionManager()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestWheelExpiry", TestWheelExpiry),
+        NL_TEST_DEF("TestWheelCancelAndReschedule", TestWheelCancelAndReschedule),
+        NL_TEST_DEF("TestRateLimiter", TestRateLimiter),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "ClientSubscriptionManager",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestClientSubscriptionManager)
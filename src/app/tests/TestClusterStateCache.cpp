@@ -22,6 +22,7 @@
 #include "protocols/interaction_model/Constants.h"
 #include "system/SystemPacketBuffer.h"
 #include "system/TLVPacketBufferBackingStore.h"
+#include <algorithm>
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/ClusterStateCache.h>
 #include <app/data-model/DecodableList.h>
@@ -537,11 +538,117 @@ CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
 
 void RunAndValidateSequence(AttributeInstructionListType list)
 {
-    ForwardedDataCallbackValidator dataCallbackValidator;
-    CacheValidator client(list, dataCallbackValidator);
-    ClusterStateCache cache(client);
-    DataSeriesGenerator generator(&cache.GetBufferedCallback(), list);
-    generator.Generate(dataCallbackValidator);
+    for (auto storageMode : { ClusterStateCache::StorageMode::kMaps, ClusterStateCache::StorageMode::kFlat })
+    {
+        ForwardedDataCallbackValidator dataCallbackValidator;
+        CacheValidator client(list, dataCallbackValidator);
+        ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, storageMode);
+        DataSeriesGenerator generator(&cache.GetBufferedCallback(), list);
+        generator.Generate(dataCallbackValidator);
+    }
+}
+
+class NullCacheCallback : public ClusterStateCache::Callback
+{
+public:
+    void OnDone(ReadClient *) override {}
+};
+
+constexpr EndpointId kMemoryTestEndpointCount   = 4;
+constexpr AttributeId kMemoryTestAttributeCount = 50;
+
+// Report every attribute of the test endpoints, as octet strings whose length depends on the report.
+void GenerateOctetStringReport(ClusterStateCache & cache, uint8_t reportIndex)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    uint8_t value[16];
+    memset(value, reportIndex, sizeof(value));
+
+    callback.OnReportBegin();
+    for (EndpointId endpointId = 0; endpointId < kMemoryTestEndpointCount; endpointId++)
+    {
+        for (AttributeId attributeId = 0; attributeId < kMemoryTestAttributeCount; attributeId++)
+        {
+            ConcreteDataAttributePath path(endpointId, Clusters::UnitTesting::Id, attributeId);
+            path.mDataVersion.SetValue(reportIndex);
+
+            uint8_t buffer[32];
+            TLV::TLVWriter writer;
+            writer.Init(buffer);
+            NL_TEST_ASSERT(gSuite,
+                           DataModel::Encode(writer, TLV::AnonymousTag(), ByteSpan(value, 4u + (reportIndex % 3) * 6u)) ==
+                               CHIP_NO_ERROR);
+
+            TLV::TLVReader reader;
+            reader.Init(buffer, writer.GetLengthWritten());
+            NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+            callback.OnAttributeData(path, &reader, StatusIB());
+        }
+    }
+    callback.OnReportEnd();
+}
+
+/*
+ * Validates that both storage modes hold the same data, that the flat storage takes less memory, and that
+ * replacing values does not grow it without bound.
+ */
+void TestStorageModeMemoryUsage(nlTestSuite * apSuite, void * apContext)
+{
+    NullCacheCallback callback;
+    ClusterStateCache mapCache(callback, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kMaps);
+    ClusterStateCache flatCache(callback, Optional<EventNumber>::Missing(), true, ClusterStateCache::StorageMode::kFlat);
+    ClusterStateCache::MemoryUsage mapUsage;
+    ClusterStateCache::MemoryUsage flatUsage;
+    size_t maxFlatTotalBytes = 0;
+
+    for (uint8_t reportIndex = 1; reportIndex <= 30; reportIndex++)
+    {
+        GenerateOctetStringReport(mapCache, reportIndex);
+        GenerateOctetStringReport(flatCache, reportIndex);
+
+        flatCache.GetMemoryUsage(flatUsage);
+        maxFlatTotalBytes = std::max(maxFlatTotalBytes, flatUsage.mTotalBytes);
+    }
+
+    mapCache.GetMemoryUsage(mapUsage);
+    flatCache.GetMemoryUsage(flatUsage);
+    ChipLogProgress(DataManagement, "Maps: %u bytes, flat: %u bytes (at most %u), for %u bytes of data",
+                    static_cast<unsigned>(mapUsage.mTotalBytes), static_cast<unsigned>(flatUsage.mTotalBytes),
+                    static_cast<unsigned>(maxFlatTotalBytes), static_cast<unsigned>(flatUsage.mAttributeDataBytes));
+
+    NL_TEST_ASSERT(apSuite, mapUsage.mClusterCount == kMemoryTestEndpointCount);
+    NL_TEST_ASSERT(apSuite, flatUsage.mClusterCount == kMemoryTestEndpointCount);
+    NL_TEST_ASSERT(apSuite, mapUsage.mAttributeCount == kMemoryTestEndpointCount * kMemoryTestAttributeCount);
+    NL_TEST_ASSERT(apSuite, flatUsage.mAttributeCount == kMemoryTestEndpointCount * kMemoryTestAttributeCount);
+    NL_TEST_ASSERT(apSuite, flatUsage.mAttributeDataBytes == mapUsage.mAttributeDataBytes);
+    NL_TEST_ASSERT(apSuite, flatUsage.mTotalBytes < mapUsage.mTotalBytes);
+
+    // Replaced values are reclaimed, the arena never holds much more than the largest set of values.
+    NL_TEST_ASSERT(apSuite, maxFlatTotalBytes < mapUsage.mTotalBytes);
+
+    for (EndpointId endpointId = 0; endpointId < kMemoryTestEndpointCount; endpointId++)
+    {
+        for (AttributeId attributeId = 0; attributeId < kMemoryTestAttributeCount; attributeId++)
+        {
+            ConcreteAttributePath path(endpointId, Clusters::UnitTesting::Id, attributeId);
+            TLV::TLVReader mapReader;
+            TLV::TLVReader flatReader;
+            ByteSpan mapValue;
+            ByteSpan flatValue;
+
+            NL_TEST_ASSERT(apSuite, mapCache.Get(path, mapReader) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, flatCache.Get(path, flatReader) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, mapReader.Get(mapValue) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, flatReader.Get(flatValue) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, mapValue.data_equal(flatValue));
+            NL_TEST_ASSERT(apSuite, flatValue.size() == 4u + (30 % 3) * 6u && flatValue.data()[0] == 30);
+        }
+    }
+
+    Optional<DataVersion> version;
+    NL_TEST_ASSERT(apSuite, flatCache.GetVersion(ConcreteClusterPath(1, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, flatCache.GetVersion(ConcreteClusterPath(kMemoryTestEndpointCount, Clusters::UnitTesting::Id),
+                                                 version) == CHIP_ERROR_KEY_NOT_FOUND);
 }
 
 /*
@@ -618,6 +725,7 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestStorageModeMemoryUsage", TestStorageModeMemoryUsage),
     NL_TEST_SENTINEL()
 };
 
@@ -24,6 +24,7 @@
 
 #include <cinttypes>
 
+#include <app-common/zap-generated/cluster-objects.h>
 #include <app/AppConfig.h>
 #include <app/InteractionModelEngine.h>
 #include <app/data-model/Encode.h>
@@ -98,6 +99,15 @@ InteractionModel::Status ServerClusterCommandExists(const ConcreteCommandPath &
         return Status::UnsupportedEndpoint;
     }
 
+    // Scenes commands answered with a data response, as the Scenes server does.
+    if (aCommandPath.mClusterId == Clusters::Scenes::Id)
+    {
+        return (aCommandPath.mCommandId == Clusters::Scenes::Commands::StoreScene::Id ||
+                aCommandPath.mCommandId == Clusters::Scenes::Commands::RemoveScene::Id)
+            ? Status::Success
+            : Status::UnsupportedCommand;
+    }
+
     if (aCommandPath.mClusterId != kTestClusterId)
     {
         return Status::UnsupportedCluster;
@@ -111,12 +121,48 @@ InteractionModel::Status ServerClusterCommandExists(const ConcreteCommandPath &
     return Status::Success;
 }
 
+void DispatchScenesCommand(const ConcreteCommandPath & aCommandPath, chip::TLV::TLVReader & aReader, CommandHandler * apCommandObj)
+{
+    using namespace Clusters::Scenes;
+
+    // StoreScene and RemoveScene carry the same fields.
+    Commands::StoreScene::DecodableType commandData;
+    NL_TEST_ASSERT(gSuite, DataModel::Decode(aReader, commandData) == CHIP_NO_ERROR);
+
+    CommandId responseId = aCommandPath.mCommandId == Commands::StoreScene::Id ? Commands::StoreSceneResponse::Id
+                                                                               : Commands::RemoveSceneResponse::Id;
+    ConcreteCommandPath path = { aCommandPath.mEndpointId, Id, responseId };
+
+    // Every command of the batch targets this endpoint and cluster, so the response path alone does not tell which one is
+    // being answered.
+    NL_TEST_ASSERT(gSuite, apCommandObj->PrepareCommand(path) == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(gSuite, apCommandObj->PrepareInvokeResponseCommand(aCommandPath, path) == CHIP_NO_ERROR);
+    chip::TLV::TLVWriter * writer = apCommandObj->GetCommandDataIBTLVWriter();
+    NL_TEST_ASSERT(gSuite, writer != nullptr);
+    if (writer == nullptr)
+    {
+        return;
+    }
+    NL_TEST_ASSERT(gSuite, writer->Put(TLV::ContextTag(0), static_cast<uint8_t>(0)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer->Put(TLV::ContextTag(1), commandData.groupID) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, writer->Put(TLV::ContextTag(2), commandData.sceneID) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite, apCommandObj->FinishCommand() == CHIP_NO_ERROR);
+}
+
 void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, chip::TLV::TLVReader & aReader,
                                   CommandHandler * apCommandObj)
 {
     ChipLogDetail(Controller, "Received Cluster Command: Endpoint=%x Cluster=" ChipLogFormatMEI " Command=" ChipLogFormatMEI,
                   aCommandPath.mEndpointId, ChipLogValueMEI(aCommandPath.mClusterId), ChipLogValueMEI(aCommandPath.mCommandId));
 
+    if (aCommandPath.mClusterId == Clusters::Scenes::Id)
+    {
+        DispatchScenesCommand(aCommandPath, aReader, apCommandObj);
+        chip::isCommandDispatched = true;
+        return;
+    }
+
     // Duplicate what our normal command-field-decode code does, in terms of
     // checking for a struct and then entering it before getting the fields.
     if (aReader.GetType() != TLV::kTLVType_Structure)
@@ -161,7 +207,7 @@ void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, chip
         }
         else
         {
-            apCommandObj->PrepareCommand(aCommandPath);
+            apCommandObj->PrepareInvokeResponseCommand(aCommandPath, aCommandPath);
             chip::TLV::TLVWriter * writer = apCommandObj->GetCommandDataIBTLVWriter();
             writer->PutBoolean(chip::TLV::ContextTag(1), true);
             apCommandObj->FinishCommand();
@@ -205,6 +251,29 @@ public:
     CHIP_ERROR mError         = CHIP_NO_ERROR;
 } mockCommandSenderDelegate;
 
+class MockBatchCommandSenderCallback : public CommandSender::Callback
+{
+public:
+    void OnResponseWithCommandRef(chip::app::CommandSender * apCommandSender, const chip::app::ConcreteCommandPath & aPath,
+                                  uint16_t aCommandRef, const chip::app::StatusIB & aStatus, chip::TLV::TLVReader * aData) override
+    {
+        NL_TEST_ASSERT(gSuite, aCommandRef < ArraySize(responseCommandIds));
+        NL_TEST_ASSERT(gSuite, aStatus.IsSuccess());
+        if (aCommandRef < ArraySize(responseCommandIds))
+        {
+            responseCommandIds[aCommandRef] = aPath.mCommandId;
+        }
+        onResponseCalledTimes++;
+    }
+    void OnError(const chip::app::CommandSender * apCommandSender, CHIP_ERROR aError) override { onErrorCalledTimes++; }
+    void OnDone(chip::app::CommandSender * apCommandSender) override { onFinalCalledTimes++; }
+
+    CommandId responseCommandIds[2] = { kTestNonExistCommandId, kTestNonExistCommandId };
+    int onResponseCalledTimes       = 0;
+    int onErrorCalledTimes          = 0;
+    int onFinalCalledTimes          = 0;
+};
+
 class MockCommandHandlerCallback : public CommandHandler::Callback
 {
 public:
@@ -256,6 +325,8 @@ public:
     static void TestCommandSenderCommandSpecificResponseFlow(nlTestSuite * apSuite, void * apContext);
 
     static void TestCommandSenderAbruptDestruction(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandSenderBatchCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerBatchScenesCommands(nlTestSuite * apSuite, void * apContext);
 
     static size_t GetNumActiveHandlerObjects()
     {
@@ -532,8 +603,10 @@ void TestCommandInteraction::TestCommandSenderWithSendCommand(nlTestSuite * apSu
     ctx.DrainAndServiceIO();
 
     GenerateInvokeResponse(apSuite, apContext, buf, kTestCommandIdWithData);
-    err = commandSender.ProcessInvokeResponse(std::move(buf));
+    bool moreChunkedMessages = true;
+    err                      = commandSender.ProcessInvokeResponse(std::move(buf), moreChunkedMessages);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !moreChunkedMessages);
 }
 
 void TestCommandInteraction::TestCommandHandlerWithSendEmptyCommand(nlTestSuite * apSuite, void * apContext)
@@ -569,8 +642,10 @@ void TestCommandInteraction::TestCommandSenderWithProcessReceivedMsg(nlTestSuite
     System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
 
     GenerateInvokeResponse(apSuite, apContext, buf, kTestCommandIdWithData);
-    err = commandSender.ProcessInvokeResponse(std::move(buf));
+    bool moreChunkedMessages = true;
+    err                      = commandSender.ProcessInvokeResponse(std::move(buf), moreChunkedMessages);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !moreChunkedMessages);
 }
 
 void TestCommandInteraction::ValidateCommandHandlerWithSendCommand(nlTestSuite * apSuite, void * apContext, bool aNeedStatusCode)
@@ -1347,7 +1422,8 @@ void TestCommandInteraction::TestCommandHandlerRejectMultipleCommands(nlTestSuit
 
         commandSender.AllocateBuffer();
 
-        // CommandSender does not support sending multiple commands with public API, so we craft a message manaully.
+        // CommandSender always gives the commands of a batch distinct paths and CommandRefs, so we craft a message manually
+        // with two identical commands without CommandRef.
         for (int i = 0; i < 2; i++)
         {
             InvokeRequests::Builder & invokeRequests = commandSender.mInvokeRequestBuilder.GetInvokeRequests();
@@ -1389,6 +1465,81 @@ void TestCommandInteraction::TestCommandHandlerRejectMultipleCommands(nlTestSuit
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+void TestCommandInteraction::TestCommandSenderBatchCommands(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    sendResponse = true;
+
+    MockBatchCommandSenderCallback callback;
+    app::CommandSender commandSender(&callback, &ctx.GetExchangeManager());
+
+    // The first command gets a status response, the second one a data response.
+    err = commandSender.EnableBatchCommands();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdWithData);
+    AddInvokeRequestData(apSuite, apContext, &commandSender, kTestCommandIdCommandSpecificResponse);
+
+    // Batch mode can only be entered before the first command.
+    NL_TEST_ASSERT(apSuite, commandSender.EnableBatchCommands() == CHIP_ERROR_INCORRECT_STATE);
+
+    err = commandSender.SendCommandRequest(ctx.GetSessionBobToAlice());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite,
+                   callback.onResponseCalledTimes == 2 && callback.onFinalCalledTimes == 1 && callback.onErrorCalledTimes == 0);
+    NL_TEST_ASSERT(apSuite, callback.responseCommandIds[0] == kTestCommandIdWithData);
+    NL_TEST_ASSERT(apSuite, callback.responseCommandIds[1] == kTestCommandIdCommandSpecificResponse);
+
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCommandHandlerBatchScenesCommands(nlTestSuite * apSuite, void * apContext)
+{
+    using namespace Clusters::Scenes;
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    MockBatchCommandSenderCallback callback;
+    app::CommandSender commandSender(&callback, &ctx.GetExchangeManager());
+
+    // Two commands to the Scenes cluster of the same endpoint, each answered with a data response.
+    err = commandSender.EnableBatchCommands();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Commands::StoreScene::Type storeScene;
+    storeScene.groupID = 1;
+    storeScene.sceneID = 2;
+    err = commandSender.AddRequestData(
+        CommandPathParams(kTestEndpointId, 0, Id, Commands::StoreScene::Id, CommandPathFlags::kEndpointIdValid), storeScene);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Commands::RemoveScene::Type removeScene;
+    removeScene.groupID = 1;
+    removeScene.sceneID = 3;
+    err = commandSender.AddRequestData(
+        CommandPathParams(kTestEndpointId, 0, Id, Commands::RemoveScene::Id, CommandPathFlags::kEndpointIdValid), removeScene);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = commandSender.SendCommandRequest(ctx.GetSessionBobToAlice());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite,
+                   callback.onResponseCalledTimes == 2 && callback.onFinalCalledTimes == 1 && callback.onErrorCalledTimes == 0);
+    NL_TEST_ASSERT(apSuite, callback.responseCommandIds[0] == Commands::StoreSceneResponse::Id);
+    NL_TEST_ASSERT(apSuite, callback.responseCommandIds[1] == Commands::RemoveSceneResponse::Id);
+
+    NL_TEST_ASSERT(apSuite, GetNumActiveHandlerObjects() == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
 //
 // This test needs a special unit-test only API being exposed in ExchangeContext to be able to correctly simulate
@@ -1456,6 +1607,8 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestCommandSenderCommandSpecificResponseFlow", chip::app::TestCommandInteraction::TestCommandSenderCommandSpecificResponseFlow),
     NL_TEST_DEF("TestCommandSenderCommandFailureResponseFlow", chip::app::TestCommandInteraction::TestCommandSenderCommandFailureResponseFlow),
     NL_TEST_DEF("TestCommandSenderAbruptDestruction", chip::app::TestCommandInteraction::TestCommandSenderAbruptDestruction),
+    NL_TEST_DEF("TestCommandSenderBatchCommands", chip::app::TestCommandInteraction::TestCommandSenderBatchCommands),
+    NL_TEST_DEF("TestCommandHandlerBatchScenesCommands", chip::app::TestCommandInteraction::TestCommandHandlerBatchScenesCommands),
     NL_TEST_DEF("TestCommandHandlerInvalidMessageSync", chip::app::TestCommandInteraction::TestCommandHandlerInvalidMessageSync),
     NL_TEST_DEF("TestCommandHandlerInvalidMessageAsync", chip::app::TestCommandInteraction::TestCommandHandlerInvalidMessageAsync),
     NL_TEST_SENTINEL()
@@ -0,0 +1,192 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+class CountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    size_t mWriteCount = 0;
+
+protected:
+    CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size) override
+    {
+        mWriteCount++;
+        return TestPersistentStorageDelegate::SyncSetKeyValueInternal(key, value, size);
+    }
+};
+
+const EmberAfAttributeMetadata kMetadata = { .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)),
+                                             .attributeId   = 1,
+                                             .size          = sizeof(uint32_t),
+                                             .attributeType = ZCL_INT32U_ATTRIBUTE_TYPE,
+                                             .mask          = 0 };
+
+CHIP_ERROR WriteUint32(AttributePersistenceProvider & aProvider, const ConcreteAttributePath & aPath, uint32_t aValue)
+{
+    return aProvider.WriteValue(aPath, ByteSpan(reinterpret_cast<const uint8_t *>(&aValue), sizeof(aValue)));
+}
+
+CHIP_ERROR ReadUint32(AttributePersistenceProvider & aProvider, const ConcreteAttributePath & aPath, uint32_t & aValue)
+{
+    MutableByteSpan value(reinterpret_cast<uint8_t *>(&aValue), sizeof(aValue));
+    return aProvider.ReadValue(aPath, &kMetadata, value);
+}
+
+void TestBatchedWrites(nlTestSuite * aSuite, void * aContext)
+{
+    CountingStorageDelegate storage;
+    DefaultAttributePersistenceProvider provider;
+    const ConcreteAttributePath path1(1, 6, 1);
+    const ConcreteAttributePath path2(2, 6, 1);
+    int batch;
+    uint32_t value = 0;
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    // Outside of a batch, values are written right away.
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 1);
+
+    // Within a batch, values are held back but can still be read back.
+    provider.StartBatch(&batch);
+    for (uint32_t i = 2; i <= 10; i++)
+    {
+        NL_TEST_ASSERT(aSuite, WriteUint32(provider, path1, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 1);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path1, value) == CHIP_NO_ERROR && value == 10);
+
+    // Values remain held back while the batch is suspended, and can be added to once it is resumed.
+    provider.SuspendBatch(&batch);
+    provider.StartBatch(&batch);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path2, 20) == CHIP_NO_ERROR);
+    provider.SuspendBatch(&batch);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 1);
+
+    // Ending the batch persists the values, once per attribute.
+    provider.EndBatch(&batch);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 3);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path1, value) == CHIP_NO_ERROR && value == 10);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path2, value) == CHIP_NO_ERROR && value == 20);
+
+    // Ending a batch again is ignored.
+    provider.EndBatch(&batch);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path1, 11) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 4);
+}
+
+void TestBatchScope(nlTestSuite * aSuite, void * aContext)
+{
+    CountingStorageDelegate storage;
+    DefaultAttributePersistenceProvider provider;
+    const ConcreteAttributePath path1(1, 6, 1);
+    const ConcreteAttributePath path2(2, 6, 1);
+    const ConcreteAttributePath path3(3, 6, 1);
+    int batch1;
+    int batch2;
+    uint32_t value = 0;
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    provider.StartBatch(&batch1);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path2, 2) == CHIP_NO_ERROR);
+    provider.SuspendBatch(&batch1);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 0);
+
+    // While the batch is suspended, other values are written right away, including the ones superseding values held back.
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path3, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 1);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path2, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 2);
+
+    // Another batch does not hold back its values past its own end, nor does it end the first one.
+    provider.StartBatch(&batch2);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path3, 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, WriteUint32(provider, path1, 6) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 3);
+    provider.EndBatch(&batch2);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 4);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path1, value) == CHIP_NO_ERROR && value == 6);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path3, value) == CHIP_NO_ERROR && value == 5);
+
+    // The first batch has nothing left to persist.
+    provider.EndBatch(&batch1);
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == 4);
+    NL_TEST_ASSERT(aSuite, ReadUint32(provider, path2, value) == CHIP_NO_ERROR && value == 4);
+}
+
+void TestBatchOverflow(nlTestSuite * aSuite, void * aContext)
+{
+    CountingStorageDelegate storage;
+    DefaultAttributePersistenceProvider provider;
+    constexpr size_t kAttributeCount = CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES + 2;
+    uint32_t value                   = 0;
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&storage) == CHIP_NO_ERROR);
+
+    // Once the batch is full, the values of further attributes are written right away.
+    int batch;
+    provider.StartBatch(&batch);
+    for (EndpointId endpoint = 0; endpoint < kAttributeCount; endpoint++)
+    {
+        NL_TEST_ASSERT(aSuite, WriteUint32(provider, ConcreteAttributePath(endpoint, 6, 1), endpoint) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == kAttributeCount - CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES);
+
+    // Shutting down persists the values held back.
+    provider.Shutdown();
+    NL_TEST_ASSERT(aSuite, storage.mWriteCount == kAttributeCount);
+    for (EndpointId endpoint = 0; endpoint < kAttributeCount; endpoint++)
+    {
+        NL_TEST_ASSERT(aSuite, ReadUint32(provider, ConcreteAttributePath(endpoint, 6, 1), value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(aSuite, value == endpoint);
+    }
+}
+
+} // namespace
+
+int TestDefaultAttributePersistenceProvider()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestBatchedWrites", TestBatchedWrites),
+        NL_TEST_DEF("TestBatchScope", TestBatchScope),
+        NL_TEST_DEF("TestBatchOverflow", TestBatchOverflow),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "DefaultAttributePersistenceProvider",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDefaultAttributePersistenceProvider)
@@ -60,6 +60,37 @@ static uint8_t gInfoEventBuffer[128];
 static uint8_t gCritEventBuffer[128];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
+static uint8_t gPersistentDebugEventBuffer[128];
+static uint8_t gPersistentInfoEventBuffer[128];
+static uint8_t gPersistentCritEventBuffer[128];
+static chip::app::CircularEventBuffer gPersistentCircularEventBuffer[3];
+
+class TestEventBufferStore : public chip::app::CircularEventBufferStore
+{
+public:
+    CHIP_ERROR LoadState(uint32_t & aHeadOffset, uint32_t & aDataLength) override
+    {
+        VerifyOrReturnError(mSaved, CHIP_ERROR_NOT_FOUND);
+        aHeadOffset = mHeadOffset;
+        aDataLength = mDataLength;
+        return CHIP_NO_ERROR;
+    }
+
+    void SaveState(uint32_t aHeadOffset, uint32_t aDataLength) override
+    {
+        mSaved      = true;
+        mHeadOffset = aHeadOffset;
+        mDataLength = aDataLength;
+    }
+
+private:
+    bool mSaved          = false;
+    uint32_t mHeadOffset = 0;
+    uint32_t mDataLength = 0;
+};
+
+static TestEventBufferStore gEventBufferStores[3];
+
 class TestContext : public chip::Test::AppContext
 {
 public:
@@ -307,12 +338,135 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
+
+static void CheckLogReadOutWithInterleavedPaths(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::EventNumber eid;
+    chip::app::EventOptions options1;
+    chip::app::EventOptions options2;
+    TestEventGenerator testEventGenerator;
+
+    options1.mPath                       = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options1.mPriority                   = chip::app::PriorityLevel::Critical;
+    options2.mPath                       = { kTestEndpointId2, kLivenessClusterId, kLivenessChangeEvent };
+    options2.mPriority                   = chip::app::PriorityLevel::Critical;
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber firstEventNumber   = logMgmt.GetLastEventNumber();
+
+    for (int i = 0; i < 3; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options1, eid);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = logMgmt.LogEvent(&testEventGenerator, options2, eid);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    chip::app::ObjectList<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId2;
+    path.mValue.mClusterId  = kLivenessClusterId;
+
+    // Only the events of the second endpoint, logged at odd offsets from the first event, are expected.
+    CheckLogReadOut(apSuite, logMgmt, firstEventNumber, 3, &path);
+    CheckLogReadOut(apSuite, logMgmt, firstEventNumber + 2, 2, &path);
+    CheckLogReadOut(apSuite, logMgmt, firstEventNumber + 5, 1, &path);
+    CheckLogReadOut(apSuite, logMgmt, firstEventNumber + 6, 0, &path);
+
+    // Reading past the last event reports nothing, and resumes after the last event.
+    uint8_t backingStore[128];
+    chip::TLV::TLVWriter writer;
+    size_t eventCount                  = 0;
+    chip::EventNumber startEventNumber = firstEventNumber + 6;
+    writer.Init(backingStore);
+    err = logMgmt.FetchEventsSince(writer, &path, startEventNumber, eventCount, chip::Access::SubjectDescriptor{});
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCount == 0);
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == 0);
+    NL_TEST_ASSERT(apSuite, startEventNumber == logMgmt.GetLastEventNumber());
+}
+
+static void CreatePersistentEventManagement(TestContext * apContext, chip::MonotonicallyIncreasingCounter<chip::EventNumber> & aCounter)
+{
+    chip::app::LogStorageResources logStorageResources[] = {
+        { &gPersistentDebugEventBuffer[0], sizeof(gPersistentDebugEventBuffer), chip::app::PriorityLevel::Debug,
+          &gEventBufferStores[0] },
+        { &gPersistentInfoEventBuffer[0], sizeof(gPersistentInfoEventBuffer), chip::app::PriorityLevel::Info,
+          &gEventBufferStores[1] },
+        { &gPersistentCritEventBuffer[0], sizeof(gPersistentCritEventBuffer), chip::app::PriorityLevel::Critical,
+          &gEventBufferStores[2] },
+    };
+
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::app::EventManagement::CreateEventManagement(&apContext->GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gPersistentCircularEventBuffer, logStorageResources, &aCounter);
+}
+
+static void CheckLogEventsRestoredAfterRestart(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::EventNumber eid;
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> counter;
+    auto * ctx = static_cast<TestContext *>(apContext);
+
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Critical;
+
+    NL_TEST_ASSERT(apSuite, counter.Init(0) == CHIP_NO_ERROR);
+    CreatePersistentEventManagement(ctx, counter);
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // Enough events to be promoted to the critical buffer.
+    for (int i = 0; i < 5; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    chip::EventNumber lastEventNumber = eid;
+
+    chip::app::ObjectList<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+    CheckLogReadOut(apSuite, logMgmt, 0, 5, &path);
+
+    // Restart with an event number counter that was not persisted: the events are still there, and new events are
+    // numbered after them.
+    NL_TEST_ASSERT(apSuite, counter.Init(0) == CHIP_NO_ERROR);
+    CreatePersistentEventManagement(ctx, counter);
+    CheckLogReadOut(apSuite, logMgmt, 0, 5, &path);
+
+    err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eid > lastEventNumber);
+    CheckLogReadOut(apSuite, logMgmt, 0, 6, &path);
+
+    // Cleared events, e.g. on factory reset, are not restored.
+    logMgmt.ClearEvents();
+    CreatePersistentEventManagement(ctx, counter);
+
+    uint8_t backingStore[256];
+    chip::TLV::TLVWriter writer;
+    chip::EventNumber startEventNumber = 0;
+    size_t eventCount                  = 0;
+    writer.Init(backingStore);
+    err = logMgmt.FetchEventsSince(writer, &path, startEventNumber, eventCount, chip::Access::SubjectDescriptor{});
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(apSuite, eventCount == 0);
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == 0);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 
 const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
-                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent), NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+                          NL_TEST_DEF("CheckLogReadOutWithInterleavedPaths", CheckLogReadOutWithInterleavedPaths),
+                          NL_TEST_DEF("CheckLogEventsRestoredAfterRestart", CheckLogEventsRestoredAfterRestart),
+                          NL_TEST_SENTINEL() };
 
 // clang-format off
 nlTestSuite sSuite =
@@ -0,0 +1,326 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/WriteBehindAttributePersistenceProvider.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <map>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::System::Clock::Literals;
+using chip::System::Clock::Timestamp;
+
+namespace {
+
+// Records the values persisted, in the order they are persisted.
+class RecordingPersistenceProvider : public AttributePersistenceProvider
+{
+public:
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override
+    {
+        mWrites.push_back(aPath);
+        mValues[aPath.mEndpointId] = std::vector<uint8_t>(aValue.begin(), aValue.end());
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override
+    {
+        auto value = mValues.find(aPath.mEndpointId);
+        VerifyOrReturnError(value != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        return CopySpanToMutableSpan(ByteSpan(value->second.data(), value->second.size()), aValue);
+    }
+
+    void StartBatch(const void * aBatch) override { mActiveBatch = aBatch; }
+    void SuspendBatch(const void * aBatch) override { mActiveBatch = nullptr; }
+    void EndBatch(const void * aBatch) override
+    {
+        mActiveBatch = nullptr;
+        mBatchCount++;
+    }
+
+    std::vector<ConcreteAttributePath> mWrites;
+    std::map<EndpointId, std::vector<uint8_t>> mValues;
+    const void * mActiveBatch = nullptr;
+    unsigned mBatchCount      = 0;
+};
+
+// System::Layer with a single timer, fired on demand.
+class MockTimerLayer : public System::Layer
+{
+public:
+    CHIP_ERROR Init() override { return CHIP_NO_ERROR; }
+    void Shutdown() override {}
+    bool IsInitialized() const override { return true; }
+
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        mDeadline = System::SystemClock().GetMonotonicTimestamp() + aDelay;
+        mCallback = aComplete;
+        mAppState = aAppState;
+        return CHIP_NO_ERROR;
+    }
+
+    void CancelTimer(System::TimerCompleteCallback aOnComplete, void * aAppState) override { mCallback = nullptr; }
+    CHIP_ERROR ScheduleWork(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    bool IsTimerStarted() const { return mCallback != nullptr; }
+    Timestamp GetDeadline() const { return mDeadline; }
+
+    // Fire the timer if it is due at aNow.
+    void AdvanceTo(System::Clock::Internal::MockClock & aClock, Timestamp aNow)
+    {
+        aClock.SetMonotonic(aNow);
+        if (mCallback != nullptr && mDeadline <= aNow)
+        {
+            System::TimerCompleteCallback callback = mCallback;
+            mCallback                              = nullptr;
+            callback(this, mAppState);
+        }
+    }
+
+private:
+    Timestamp mDeadline;
+    System::TimerCompleteCallback mCallback = nullptr;
+    void * mAppState                        = nullptr;
+};
+
+const EmberAfAttributeMetadata kUint8Metadata = { .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)),
+                                                  .attributeId   = 0,
+                                                  .size          = sizeof(uint8_t),
+                                                  .attributeType = ZCL_INT8U_ATTRIBUTE_TYPE,
+                                                  .mask          = 0 };
+
+CHIP_ERROR WriteUint8(AttributePersistenceProvider & aProvider, EndpointId aEndpoint, uint8_t aValue)
+{
+    return aProvider.WriteValue(ConcreteAttributePath(aEndpoint, 8, 0), ByteSpan(&aValue, sizeof(aValue)));
+}
+
+class ScopedMockClock
+{
+public:
+    ScopedMockClock() : mRealClock(System::SystemClock()) { System::Clock::Internal::SetSystemClockForTesting(&mClock); }
+    ~ScopedMockClock() { System::Clock::Internal::SetSystemClockForTesting(&mRealClock); }
+
+    System::Clock::Internal::MockClock mClock;
+
+private:
+    System::Clock::ClockBase & mRealClock;
+};
+
+void TestTransitionIsPersistedOnce(nlTestSuite * aSuite, void * aContext)
+{
+    ScopedMockClock clock;
+    MockTimerLayer layer;
+    RecordingPersistenceProvider persister;
+    WriteBehindAttributePersistenceProvider provider(persister);
+    WriteBehindAttributePersistenceProvider::Config config;
+    uint8_t value = 0;
+    MutableByteSpan valueSpan(&value, sizeof(value));
+
+    config.mFlushInterval = 1000_ms32;
+    config.mMaxLatency    = 60000_ms32;
+    NL_TEST_ASSERT(aSuite, provider.Init(&layer, config) == CHIP_NO_ERROR);
+
+    // A 10 second transition updating the level every 100ms.
+    for (uint8_t step = 0; step < 100; step++)
+    {
+        layer.AdvanceTo(clock.mClock, Timestamp(step * 100));
+        NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, step) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, persister.mWrites.empty());
+
+    // The latest value is readable while it is held back.
+    NL_TEST_ASSERT(aSuite, provider.ReadValue(ConcreteAttributePath(1, 8, 0), &kUint8Metadata, valueSpan) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, value == 99);
+
+    // The value is persisted once the flush interval elapsed after the last update.
+    layer.AdvanceTo(clock.mClock, Timestamp(10800));
+    NL_TEST_ASSERT(aSuite, persister.mWrites.empty());
+    layer.AdvanceTo(clock.mClock, Timestamp(10900));
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 1);
+    NL_TEST_ASSERT(aSuite, persister.mValues[1] == std::vector<uint8_t>{ 99 });
+    NL_TEST_ASSERT(aSuite, !layer.IsTimerStarted());
+
+    // 100 writes of the attribute resulted in a single write to the storage.
+    NL_TEST_ASSERT(aSuite, provider.GetStats().mWriteCount == 100);
+    NL_TEST_ASSERT(aSuite, provider.GetStats().mPersistCount == 1);
+}
+
+void TestMaxLatency(nlTestSuite * aSuite, void * aContext)
+{
+    ScopedMockClock clock;
+    MockTimerLayer layer;
+    RecordingPersistenceProvider persister;
+    WriteBehindAttributePersistenceProvider provider(persister);
+    WriteBehindAttributePersistenceProvider::Config config;
+
+    config.mFlushInterval = 1000_ms32;
+    config.mMaxLatency    = 5000_ms32;
+    NL_TEST_ASSERT(aSuite, provider.Init(&layer, config) == CHIP_NO_ERROR);
+
+    // An attribute that never settles is still persisted every max latency.
+    for (uint32_t now = 0; now < 12000; now += 500)
+    {
+        layer.AdvanceTo(clock.mClock, Timestamp(now));
+        NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, static_cast<uint8_t>(now / 500)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 2);
+
+    // Attributes due together are persisted in one batch.
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 2, 0) == CHIP_NO_ERROR);
+    layer.AdvanceTo(clock.mClock, Timestamp(12500));
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 4);
+    NL_TEST_ASSERT(aSuite, persister.mBatchCount == 3);
+    NL_TEST_ASSERT(aSuite, persister.mActiveBatch == nullptr);
+}
+
+void TestBatchesAndShutdown(nlTestSuite * aSuite, void * aContext)
+{
+    ScopedMockClock clock;
+    MockTimerLayer layer;
+    RecordingPersistenceProvider persister;
+    WriteBehindAttributePersistenceProvider provider(persister);
+
+    // Until initialized, values are passed on right away.
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 1);
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&layer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 2, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 1);
+
+    // Values written within a batch supersede the ones held back and are passed on right away.
+    int batch;
+    provider.StartBatch(&batch);
+    NL_TEST_ASSERT(aSuite, persister.mActiveBatch == &batch);
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, 3) == CHIP_NO_ERROR);
+    provider.EndBatch(&batch);
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 2);
+    NL_TEST_ASSERT(aSuite, persister.mValues[1] == std::vector<uint8_t>{ 3 });
+
+    // Shutting down persists the attributes still dirty.
+    provider.Shutdown();
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 3);
+    NL_TEST_ASSERT(aSuite, persister.mValues[2] == std::vector<uint8_t>{ 2 });
+    NL_TEST_ASSERT(aSuite, !layer.IsTimerStarted());
+}
+
+void TestDirtyTableFull(nlTestSuite * aSuite, void * aContext)
+{
+    ScopedMockClock clock;
+    MockTimerLayer layer;
+    RecordingPersistenceProvider persister;
+    WriteBehindAttributePersistenceProvider provider(persister);
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&layer) == CHIP_NO_ERROR);
+
+    // Once the table is full, the attribute due first is persisted to make room.
+    for (EndpointId endpoint = 0; endpoint <= CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES; endpoint++)
+    {
+        layer.AdvanceTo(clock.mClock, Timestamp(endpoint));
+        NL_TEST_ASSERT(aSuite, WriteUint8(provider, endpoint, 1) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == 1);
+    NL_TEST_ASSERT(aSuite, persister.mWrites[0].mEndpointId == 0);
+
+    provider.Flush();
+    NL_TEST_ASSERT(aSuite, persister.mWrites.size() == CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES + 1);
+}
+
+void TestReadPendingValues(nlTestSuite * aSuite, void * aContext)
+{
+    ScopedMockClock clock;
+    MockTimerLayer layer;
+    RecordingPersistenceProvider persister;
+    WriteBehindAttributePersistenceProvider provider(persister);
+    const ConcreteAttributePath path(1, 8, 0);
+    const EmberAfAttributeMetadata stringMetadata = { .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)),
+                                                      .attributeId   = 0,
+                                                      .size          = 4,
+                                                      .attributeType = ZCL_CHAR_STRING_ATTRIBUTE_TYPE,
+                                                      .mask          = 0 };
+    const EmberAfAttributeMetadata uint16Metadata = { .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)),
+                                                      .attributeId   = 0,
+                                                      .size          = sizeof(uint16_t),
+                                                      .attributeType = ZCL_INT16U_ATTRIBUTE_TYPE,
+                                                      .mask          = 0 };
+    uint8_t buffer[8];
+
+    NL_TEST_ASSERT(aSuite, provider.Init(&layer) == CHIP_NO_ERROR);
+
+    // A pending string longer than the attribute allows is not returned.
+    const uint8_t longString[] = { 5, 'h', 'e', 'l', 'l', 'o' };
+    NL_TEST_ASSERT(aSuite, provider.WriteValue(path, ByteSpan(longString)) == CHIP_NO_ERROR);
+    MutableByteSpan value(buffer, stringMetadata.size);
+    NL_TEST_ASSERT(aSuite, provider.ReadValue(path, &stringMetadata, value) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Nor is a pending string shorter than its length prefix says.
+    const uint8_t truncatedString[] = { 3, 'h', 'i' };
+    NL_TEST_ASSERT(aSuite, provider.WriteValue(path, ByteSpan(truncatedString)) == CHIP_NO_ERROR);
+    value = MutableByteSpan(buffer, stringMetadata.size);
+    NL_TEST_ASSERT(aSuite, provider.ReadValue(path, &stringMetadata, value) == CHIP_ERROR_INCORRECT_STATE);
+
+    // A valid pending string is returned with its actual size.
+    const uint8_t shortString[] = { 2, 'h', 'i' };
+    NL_TEST_ASSERT(aSuite, provider.WriteValue(path, ByteSpan(shortString)) == CHIP_NO_ERROR);
+    value = MutableByteSpan(buffer, stringMetadata.size);
+    NL_TEST_ASSERT(aSuite, provider.ReadValue(path, &stringMetadata, value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, value.data_equal(ByteSpan(shortString)));
+
+    // Other pending values must have the size of the attribute.
+    NL_TEST_ASSERT(aSuite, WriteUint8(provider, 1, 1) == CHIP_NO_ERROR);
+    value = MutableByteSpan(buffer, uint16Metadata.size);
+    NL_TEST_ASSERT(aSuite, provider.ReadValue(path, &uint16Metadata, value) == CHIP_ERROR_INCORRECT_STATE);
+
+    // None of these reads persisted anything.
+    NL_TEST_ASSERT(aSuite, persister.mWrites.empty());
+    provider.Shutdown();
+}
+
+} // namespace
+
+int TestWriteBehindAttributePersistenceProvider()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestTransitionIsPersistedOnce", TestTransitionIsPersistedOnce),
+        NL_TEST_DEF("TestMaxLatency", TestMaxLatency),
+        NL_TEST_DEF("TestBatchesAndShutdown", TestBatchesAndShutdown),
+        NL_TEST_DEF("TestDirtyTableFull", TestDirtyTableFull),
+        NL_TEST_DEF("TestReadPendingValues", TestReadPendingValues),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "WriteBehindAttributePersistenceProvider",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestWriteBehindAttributePersistenceProvider)
@@ -0,0 +1,47 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/EmberAttributeUpdateIngestor.h>
+
+#include <app/reporting/reporting.h>
+#include <app/util/af.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+void EmberAttributeUpdateIngestor::ApplyUpdate(AttributeUpdate & update)
+{
+    if (!update.mHasValue)
+    {
+        MatterReportingAttributeChangeCallback(update.mPath);
+        return;
+    }
+
+    EmberAfStatus status = emberAfWriteAttribute(update.mPath.mEndpointId, update.mPath.mClusterId, update.mPath.mAttributeId,
+                                                 update.mValue, update.mType);
+    if (status != EMBER_ZCL_STATUS_SUCCESS)
+    {
+        ChipLogError(DataManagement,
+                     "Failed to apply update of attribute endpoint=%u Cluster=" ChipLogFormatMEI " attribute=" ChipLogFormatMEI
+                     ": 0x%02x",
+                     update.mPath.mEndpointId, ChipLogValueMEI(update.mPath.mClusterId), ChipLogValueMEI(update.mPath.mAttributeId),
+                     status);
+    }
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,40 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributeUpdateIngestor.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * AttributeUpdateIngestor applying the updates to the ember attribute store.
+ *
+ * An update carrying a value, of the EmberAfAttributeType given as its type,
+ * is written with emberAfWriteAttribute, which marks the attribute dirty for
+ * reporting.  An attribute only marked dirty, e.g. one stored by the
+ * application, is passed on to MatterReportingAttributeChangeCallback.
+ * Either way, an attribute updated many times between two drains is written
+ * and reported once.
+ */
+class EmberAttributeUpdateIngestor : public AttributeUpdateIngestor
+{
+protected:
+    void ApplyUpdate(AttributeUpdate & update) override;
+};
+
+} // namespace app
+} // namespace chip
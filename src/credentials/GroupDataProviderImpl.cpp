@@ -832,6 +832,7 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionIndex();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
@@ -1349,6 +1350,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1417,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1450,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1527,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1599,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1701,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionIndex();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1842,9 +1850,117 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
+bool GroupDataProviderImpl::LoadGroupSessionIndex()
+{
+    if (mGroupSessionIndexState == GroupSessionIndexState::kStale)
+    {
+        CHIP_ERROR err = BuildGroupSessionIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            InvalidateGroupSessionIndex();
+            // Storage errors may be transient, so only remember that the data does not fit.
+            if (err == CHIP_ERROR_NO_MEMORY)
+            {
+                mGroupSessionIndexState = GroupSessionIndexState::kOverflow;
+            }
+        }
+    }
+    return mGroupSessionIndexState == GroupSessionIndexState::kValid;
+}
+
+CHIP_ERROR GroupDataProviderImpl::BuildGroupSessionIndex()
+{
+    FabricList fabric_list;
+    ReturnErrorOnFailure(fabric_list.Load(mStorage));
+
+    mGroupSessionIndexCount = 0;
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        ReturnErrorOnFailure(fabric.Load(mStorage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            ReturnErrorOnFailure(mapping.Load(mStorage));
+
+            KeySetData keyset;
+            if (!keyset.Find(mStorage, fabric, mapping.keyset_id))
+            {
+                continue;
+            }
+
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                VerifyOrReturnError(mGroupSessionIndexCount < ArraySize(mGroupSessionIndex), CHIP_ERROR_NO_MEMORY);
+
+                const Crypto::GroupOperationalCredentials & creds = keyset.operational_keys[k];
+
+                // Insertion sort by session id. Equal ids keep the storage order, which is the order
+                // used when iterating storage directly.
+                size_t pos = mGroupSessionIndexCount++;
+                while (pos > 0 && mGroupSessionIndex[pos - 1].session_id > creds.hash)
+                {
+                    mGroupSessionIndex[pos] = mGroupSessionIndex[pos - 1];
+                    pos--;
+                }
+
+                GroupSessionIndexEntry & entry = mGroupSessionIndex[pos];
+                entry.session_id               = creds.hash;
+                entry.fabric_index             = fabric.fabric_index;
+                entry.group_id                 = mapping.group_id;
+                entry.security_policy          = keyset.policy;
+                memcpy(entry.encryption_key, creds.encryption_key, sizeof(entry.encryption_key));
+                memcpy(entry.privacy_key, creds.privacy_key, sizeof(entry.privacy_key));
+            }
+        }
+    }
+
+    mGroupSessionIndexState = GroupSessionIndexState::kValid;
+    return CHIP_NO_ERROR;
+}
+
+void GroupDataProviderImpl::InvalidateGroupSessionIndex()
+{
+    Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessionIndex), sizeof(mGroupSessionIndex));
+    mGroupSessionIndexCount = 0;
+    mGroupSessionIndexState = GroupSessionIndexState::kStale;
+    // Iterators created against the previous contents stop at their next step.
+    mGroupSessionIndexGeneration++;
+}
+
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    if (provider.LoadGroupSessionIndex())
+    {
+        // Binary search for the first candidate with the given session id.
+        size_t low  = 0;
+        size_t high = provider.mGroupSessionIndexCount;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (provider.mGroupSessionIndex[mid].session_id < session_id)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        mUseIndex        = true;
+        mIndexPosition   = low;
+        mIndexGeneration = provider.mGroupSessionIndexGeneration;
+        return;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,9 +1973,23 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
-    FabricData fabric(mFirstFabric);
     size_t count = 0;
 
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    if (mUseIndex)
+    {
+        VerifyOrReturnValue(mIndexGeneration == mProvider.mGroupSessionIndexGeneration, 0);
+        for (size_t i = mIndexPosition;
+             i < mProvider.mGroupSessionIndexCount && mProvider.mGroupSessionIndex[i].session_id == mSessionId; ++i)
+        {
+            count++;
+        }
+        return count;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
+    FabricData fabric(mFirstFabric);
+
     for (size_t i = 0; i < mFabricTotal; i++, fabric.fabric_index = fabric.next)
     {
         if (CHIP_NO_ERROR != fabric.Load(mProvider.mStorage))
@@ -1898,6 +2028,25 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    if (mUseIndex)
+    {
+        VerifyOrReturnError(mIndexGeneration == mProvider.mGroupSessionIndexGeneration, false);
+        VerifyOrReturnError(mIndexPosition < mProvider.mGroupSessionIndexCount, false);
+
+        const GroupSessionIndexEntry & entry = mProvider.mGroupSessionIndex[mIndexPosition];
+        VerifyOrReturnError(entry.session_id == mSessionId, false);
+        mIndexPosition++;
+
+        mGroupKeyContext.Initialize(entry.encryption_key, mSessionId, entry.privacy_key);
+        output.fabric_index    = entry.fabric_index;
+        output.group_id        = entry.group_id;
+        output.security_policy = entry.security_policy;
+        output.keyContext      = &mGroupKeyContext;
+        return true;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
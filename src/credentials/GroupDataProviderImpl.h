@@ -242,10 +242,57 @@ protected:
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
         GroupKeyContext mGroupKeyContext;
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+        bool mUseIndex            = false;
+        size_t mIndexPosition     = 0;
+        uint32_t mIndexGeneration = 0;
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
     };
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    /**
+     * Operational group key candidate for a group session id, as kept in the session index.
+     */
+    struct GroupSessionIndexEntry
+    {
+        uint16_t session_id            = 0;
+        FabricIndex fabric_index       = kUndefinedFabricIndex;
+        GroupId group_id               = kUndefinedGroupId;
+        SecurityPolicy security_policy = SecurityPolicy::kTrustFirst;
+        Crypto::Aes128KeyByteArray encryption_key;
+        Crypto::Aes128KeyByteArray privacy_key;
+    };
+
+    enum class GroupSessionIndexState : uint8_t
+    {
+        kStale,    ///< Must be rebuilt from storage before use
+        kValid,    ///< Holds every candidate, sorted by session id
+        kOverflow, ///< Storage holds more candidates than the index can; it cannot be used
+    };
+
+    /**
+     * Make sure the session index reflects the persisted key sets and group-key maps.
+     *
+     * @return true if the index may be used to look up group sessions.
+     */
+    bool LoadGroupSessionIndex();
+    CHIP_ERROR BuildGroupSessionIndex();
+
+    /**
+     * Discard the session index. Must be called whenever key sets or group-key maps change.
+     */
+    void InvalidateGroupSessionIndex();
+
+    GroupSessionIndexEntry mGroupSessionIndex[CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE];
+    size_t mGroupSessionIndexCount                 = 0;
+    uint32_t mGroupSessionIndexGeneration          = 0;
+    GroupSessionIndexState mGroupSessionIndexState = GroupSessionIndexState::kStale;
+#else
+    void InvalidateGroupSessionIndex() {}
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
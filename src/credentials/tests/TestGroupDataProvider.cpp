@@ -1188,6 +1188,33 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
         NL_TEST_ASSERT(apSuite, count == total);
         it->Release();
     }
+
+    //
+    // Key changes must be reflected by later session lookups
+    //
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeys(kFabric2));
+
+    it = provider->IterateGroupSessions(session_id);
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        NL_TEST_ASSERT(apSuite, 0 == it->Count());
+        NL_TEST_ASSERT(apSuite, !it->Next(session));
+        it->Release();
+    }
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1));
+
+    it = provider->IterateGroupSessions(session_id);
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        NL_TEST_ASSERT(apSuite, expected.size() == it->Count());
+        NL_TEST_ASSERT(apSuite, it->Next(session));
+        NL_TEST_ASSERT(apSuite, session.fabric_index == kFabric2 && session.group_id == kGroup2);
+        it->Release();
+    }
 }
 
 } // namespace TestGroups
@@ -91,6 +91,17 @@
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+ *
+ * The number of events a lock-free ring in front of the chip Platform event queue can hold on POSIX platforms, before
+ * events spill into the mutex-protected queue.  Must be a power of two, or zero, the default, to only use the
+ * mutex-protected queue.  The Linux platform sets it to 256.
+ */
+#ifndef CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+#define CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE 0
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
  *
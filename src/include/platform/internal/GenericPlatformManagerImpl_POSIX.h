@@ -104,6 +104,8 @@ private:
     void ProcessDeviceEvents();
 
     DeviceSafeQueue mChipEventQueue;
+    // Set once an event posted has woken the CHIP thread up, until it processes the events.
+    std::atomic<bool> mChipEventQueueWakePending{ false };
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
 };
@@ -135,16 +135,25 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
 {
     mChipEventQueue.Push(*event);
 
-    SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    // Only the first event posted since the CHIP thread last started processing events needs to wake it up, the following
+    // ones will be processed along with it.
+    if (!mChipEventQueueWakePending.exchange(true, std::memory_order_acq_rel))
+    {
+        SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    }
     return CHIP_NO_ERROR;
 }
 
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.Empty())
+    // Clear the pending wake up before draining the queue, so that an event posted after the queue was seen empty wakes the
+    // CHIP thread up again.
+    mChipEventQueueWakePending.exchange(false, std::memory_order_acq_rel);
+
+    ChipDeviceEvent event;
+    while (mChipEventQueue.TryPopFront(event))
     {
-        const ChipDeviceEvent event = mChipEventQueue.PopFront();
         Impl()->DispatchEvent(&event);
     }
 }
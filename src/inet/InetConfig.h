@@ -213,6 +213,21 @@
 #define INET_CONFIG_TCP_SEND_QUEUE_POLL_INTERVAL_MSEC      500
 #endif // INET_CONFIG_TCP_SEND_QUEUE_POLL_INTERVAL_MSEC
 
+/**
+ *  @def INET_CONFIG_TCP_SEND_MAX_IOV
+ *
+ *  @brief
+ *    The maximum number of send queue buffers that a sockets based
+ *    TCP endpoint hands to the kernel in a single gather write.
+ *
+ *  @details
+ *    Queued buffers are written with one sendmsg() call instead of one
+ *    send() call per buffer. A value of 1 restores the per-buffer behavior.
+ */
+#ifndef INET_CONFIG_TCP_SEND_MAX_IOV
+#define INET_CONFIG_TCP_SEND_MAX_IOV                       16
+#endif // INET_CONFIG_TCP_SEND_MAX_IOV
+
 /**
  *  @def INET_CONFIG_DEFAULT_TCP_USER_TIMEOUT_MSEC
  *
@@ -272,4 +287,26 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams that the socket-based implementation of
+ *    UDP endpoints receives with a single system call.
+ *
+ *  @details
+ *    A readable UDP endpoint first receives a single datagram with recvmsg().
+ *    When this is greater than one and more datagrams are queued, it then
+ *    receives up to this many at once with recvmmsg(), which only Linux
+ *    provides. The packet buffers for such a batch are allocated when it is
+ *    received, and the ones left unused are released right after.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+#if defined(__linux__) && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE 8
+#else
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE 1
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+
 // clang-format on
@@ -41,6 +41,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/macOS:
@@ -483,9 +484,36 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
 
     while (!mSendQueue.IsNull())
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        // Gather as many queued buffers as possible into a single write, so that a burst of
+        // small messages costs one system call rather than one per buffer. The total is
+        // bounded so that the amount sent still fits the OnDataSent length argument.
+        struct iovec sendIOV[INET_CONFIG_TCP_SEND_MAX_IOV];
+        size_t iovCount  = 0;
+        uint16_t sendLen = 0;
+
+        System::PacketBufferHandle buf = mSendQueue.Retain();
+        while (!buf.IsNull() && iovCount < ArraySize(sendIOV))
+        {
+            uint16_t bufLen = buf->DataLength();
+            if (iovCount > 0 && bufLen > UINT16_MAX - sendLen)
+            {
+                break;
+            }
+
+            sendIOV[iovCount].iov_base = buf->Start();
+            sendIOV[iovCount].iov_len  = bufLen;
+            iovCount++;
+            sendLen = static_cast<uint16_t>(sendLen + bufLen);
+            buf     = buf->Next();
+        }
+        buf = nullptr;
+
+        struct msghdr msgHeader;
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov    = sendIOV;
+        msgHeader.msg_iovlen = iovCount;
 
-        ssize_t lenSentRaw = send(mSocket, mSendQueue->Start(), bufLen, sendFlags);
+        ssize_t lenSentRaw = sendmsg(mSocket, &msgHeader, sendFlags);
 
         if (lenSentRaw == -1)
         {
@@ -496,33 +524,39 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
             break;
         }
 
-        if (lenSentRaw < 0 || lenSentRaw > bufLen)
+        if (lenSentRaw < 0 || lenSentRaw > sendLen)
         {
             err = CHIP_ERROR_INCORRECT_STATE;
             break;
         }
 
-        // Cast is safe because bufLen is uint16_t.
+        // Cast is safe because sendLen is uint16_t.
         uint16_t lenSent = static_cast<uint16_t>(lenSentRaw);
 
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
+        // Release every buffer that was written completely, then trim the one that was
+        // written partially (if any).
+        uint16_t lenRemaining = lenSent;
+        while (!mSendQueue.IsNull() && mSendQueue->DataLength() <= lenRemaining)
         {
-            mSendQueue->ConsumeHead(lenSent);
+            lenRemaining = static_cast<uint16_t>(lenRemaining - mSendQueue->DataLength());
+            mSendQueue.FreeHead();
         }
-        else
+
+        if (lenRemaining > 0)
         {
-            mSendQueue.FreeHead();
-            if (mSendQueue.IsNull())
+            mSendQueue->ConsumeHead(lenRemaining);
+        }
+
+        if (mSendQueue.IsNull())
+        {
+            // Do not wait for ability to write on this endpoint.
+            err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
+            if (err != CHIP_NO_ERROR)
             {
-                // Do not wait for ability to write on this endpoint.
-                err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
-                if (err != CHIP_NO_ERROR)
-                {
-                    break;
-                }
+                break;
             }
         }
 
@@ -558,7 +592,7 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        if (lenSent < sendLen)
         {
             break;
         }
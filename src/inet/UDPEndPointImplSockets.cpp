@@ -85,6 +85,28 @@ namespace Inet {
 
 namespace {
 
+// Size of the buffer receiving the control messages of a datagram, e.g. its IP_PKTINFO/IPV6_PKTINFO.
+constexpr size_t kControlDataSize = 256;
+
+// Set up a message header to receive a datagram into the buffer.
+void InitReceiveHeader(struct msghdr & msgHeader, struct iovec & msgIOV, SockAddr & peerSockAddr,
+                       uint8_t (&controlData)[kControlDataSize], const System::PacketBufferHandle & buffer)
+{
+    msgIOV.iov_base = buffer->Start();
+    msgIOV.iov_len  = buffer->AvailableDataLength();
+
+    memset(&peerSockAddr, 0, sizeof(peerSockAddr));
+
+    memset(&msgHeader, 0, sizeof(msgHeader));
+
+    msgHeader.msg_name       = &peerSockAddr;
+    msgHeader.msg_namelen    = sizeof(peerSockAddr);
+    msgHeader.msg_iov        = &msgIOV;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = controlData;
+    msgHeader.msg_controllen = sizeof(controlData);
+}
+
 CHIP_ERROR IPv6Bind(int socket, const IPAddress & address, uint16_t port, InterfaceId interface)
 {
     struct sockaddr_in6 sa;
@@ -562,36 +584,42 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    // The application may close, or free, the endpoint while handling a message.
+    Retain();
+
+    // Most readiness events carry a single datagram, so batch buffers are only allocated when more datagrams are
+    // queued once the first one has been received. FIONREAD gives the size of the next datagram, or 0 if there is
+    // none; an empty datagram is left for the next event.
+    int pendingLength = 0;
+    if (ReceiveMessage() && mState == State::kListening && OnMessageReceived != nullptr &&
+        ioctl(mSocket, FIONREAD, &pendingLength) == 0 && pendingLength > 0)
+    {
+        ReceiveMessageBatch();
+    }
+
+    Release();
+#else  // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE <= 1
+    ReceiveMessage();
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE <= 1
+}
+
+bool UDPEndPointImplSockets::ReceiveMessage()
+{
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
 
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
-
     lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
 
     if (!lBuffer.IsNull())
     {
         struct iovec msgIOV;
         SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
+        uint8_t controlData[kControlDataSize];
         struct msghdr msgHeader;
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
-
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
-
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        InitReceiveHeader(msgHeader, msgIOV, lPeerSockAddr, controlData, lBuffer);
 
         ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
 
@@ -606,62 +634,7 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetReceivedPacketInfo(msgHeader, lPacketInfo);
         }
     }
     else
@@ -673,15 +646,147 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
     {
         lBuffer.RightSize();
         OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        return true;
     }
-    else
+
+    if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+    {
+        OnReceiveError(this, lStatus, nullptr);
+    }
+    return false;
+}
+
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+void UDPEndPointImplSockets::ReceiveMessageBatch()
+{
+    constexpr unsigned int kBatchSize = INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE;
+
+    struct mmsghdr msgHeaders[kBatchSize];
+    struct iovec msgIOVs[kBatchSize];
+    SockAddr peerSockAddrs[kBatchSize];
+    uint8_t controlData[kBatchSize][kControlDataSize];
+
+    // The buffers left unused by recvmmsg() are released on return.
+    System::PacketBufferHandle buffers[kBatchSize];
+    unsigned int bufferCount = 0;
+    for (; bufferCount < kBatchSize; bufferCount++)
+    {
+        buffers[bufferCount] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (buffers[bufferCount].IsNull())
+        {
+            break;
+        }
+
+        memset(&msgHeaders[bufferCount], 0, sizeof(msgHeaders[bufferCount]));
+        InitReceiveHeader(msgHeaders[bufferCount].msg_hdr, msgIOVs[bufferCount], peerSockAddrs[bufferCount],
+                          controlData[bufferCount], buffers[bufferCount]);
+    }
+
+    if (bufferCount == 0)
     {
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
+    }
+
+    const int received = recvmmsg(mSocket, msgHeaders, bufferCount, MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        CHIP_ERROR lStatus = CHIP_ERROR_POSIX(errno);
         if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
         {
             OnReceiveError(this, lStatus, nullptr);
         }
+        return;
+    }
+
+    // The remaining datagrams are dropped if the application closes the endpoint while handling one.
+    for (int i = 0; i < received && mState == State::kListening && OnMessageReceived != nullptr; i++)
+    {
+        System::PacketBufferHandle lBuffer = std::move(buffers[i]);
+        struct msghdr & msgHeader          = msgHeaders[i].msg_hdr;
+        CHIP_ERROR lStatus                 = CHIP_NO_ERROR;
+        IPPacketInfo lPacketInfo;
+
+        if ((msgHeader.msg_flags & MSG_TRUNC) != 0 || msgHeaders[i].msg_len > lBuffer->AvailableDataLength())
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            lStatus = GetReceivedPacketInfo(msgHeader, lPacketInfo);
+        }
+
+        if (lStatus == CHIP_NO_ERROR)
+        {
+            lBuffer.RightSize();
+            OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
     }
 }
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+
+CHIP_ERROR UDPEndPointImplSockets::GetReceivedPacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo)
+{
+    packetInfo.Clear();
+    packetInfo.DestPort  = mBoundPort;
+    packetInfo.Interface = mBoundIntfId;
+
+    const SockAddr & peerSockAddr = *static_cast<const SockAddr *>(msgHeader.msg_name);
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
 
 #if IP_MULTICAST_LOOP || IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
@@ -57,6 +57,11 @@ private:
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+    CHIP_ERROR GetReceivedPacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo);
+    bool ReceiveMessage();
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    void ReceiveMessageBatch();
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
@@ -360,6 +360,92 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+struct UDPReceiveState
+{
+    uint32_t mReceivedCount   = 0;
+    uint32_t mOutOfOrderCount = 0;
+    uint32_t mErrorCount      = 0;
+};
+
+static void HandleUDPMessageReceived(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * state = static_cast<UDPReceiveState *>(endPoint->mAppState);
+    uint32_t index;
+    if (msg->DataLength() != sizeof(index))
+    {
+        state->mErrorCount++;
+        return;
+    }
+    memcpy(&index, msg->Start(), sizeof(index));
+    if (index != state->mReceivedCount)
+    {
+        state->mOutOfOrderCount++;
+    }
+    state->mReceivedCount++;
+}
+
+static void HandleUDPReceiveError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo)
+{
+    static_cast<UDPReceiveState *>(endPoint->mAppState)->mErrorCount++;
+}
+
+// Test that a burst of datagrams sent over the loopback interface is received completely and in order.
+static void TestInetUDPReceiveBurst(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kBurstSize = 64;
+    constexpr uint32_t kBursts    = 20;
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    UDPReceiveState state;
+
+    CHIP_ERROR err = gUDP.NewEndPoint(&receiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = gUDP.NewEndPoint(&sender);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    if (receiver == nullptr || sender == nullptr)
+    {
+        return;
+    }
+
+    IPAddress loopback;
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+    err = receiver->Bind(IPAddressType::kIPv6, loopback, 0);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = receiver->Listen(HandleUDPMessageReceived, HandleUDPReceiveError, &state);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = sender->Bind(IPAddressType::kIPv6, IPAddress::Any, 0);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    const uint16_t destPort = receiver->GetBoundPort();
+    uint32_t sentCount      = 0;
+    for (uint32_t burst = 0; burst < kBursts && err == CHIP_NO_ERROR; burst++)
+    {
+        // The socket receive buffer holds the whole burst, which is then received before the next one is sent.
+        for (uint32_t i = 0; i < kBurstSize && err == CHIP_NO_ERROR; i++, sentCount++)
+        {
+            PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&sentCount, sizeof(sentCount));
+            NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+            err = sender->SendTo(loopback, destPort, std::move(buffer));
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+
+        for (int i = 0; i < 100 && state.mReceivedCount + state.mErrorCount < sentCount; i++)
+        {
+            ServiceEvents(10);
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, state.mReceivedCount == kBursts * kBurstSize);
+    NL_TEST_ASSERT(inSuite, state.mOutOfOrderCount == 0);
+    NL_TEST_ASSERT(inSuite, state.mErrorCount == 0);
+
+    receiver->Free();
+    sender->Free();
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
@@ -451,6 +537,9 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPReceiveBurst", TestInetUDPReceiveBurst),
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
 #endif
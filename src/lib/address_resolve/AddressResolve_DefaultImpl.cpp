@@ -224,6 +224,8 @@ CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallba
 CHIP_ERROR Resolver::Init(System::Layer * systemLayer)
 {
     mSystemLayer = systemLayer;
+    mTimerArmed  = false;
+    mStatistics  = LookupStatistics();
     Dnssd::Resolver::Instance().SetOperationalDelegate(this);
     return CHIP_NO_ERROR;
 }
@@ -305,6 +307,7 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     // final result, handle either success or failure
     const PeerId peerId     = current->GetRequest().GetPeerId();
     NodeListener * listener = current->GetListener();
+    RecordLookupCompletion(*current, action.Type() == NodeLookupResult::kLookupSuccess);
     mActiveLookups.Erase(current);
 
     Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
@@ -326,8 +329,34 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     }
 }
 
+void Resolver::RecordLookupCompletion(const NodeLookupHandle & handle, bool success)
+{
+    if (!success)
+    {
+        mStatistics.failureCount++;
+        return;
+    }
+
+    const System::Clock::Milliseconds64 latency = std::chrono::duration_cast<System::Clock::Milliseconds64>(
+        mTimeSource.GetMonotonicTimestamp() - handle.GetRequestStartTime());
+
+    mStatistics.successCount++;
+    mStatistics.totalSuccessLatency += latency;
+    if (latency > mStatistics.maxSuccessLatency)
+    {
+        mStatistics.maxSuccessLatency = latency;
+    }
+
+    ChipLogDetail(Discovery, "Node lookup completed in %" PRIu64 " ms (average %" PRIu64 " ms over %" PRIu32 " lookups)",
+                  static_cast<uint64_t>(latency.count()), static_cast<uint64_t>(mStatistics.AverageSuccessLatency().count()),
+                  mStatistics.successCount);
+}
+
 void Resolver::HandleTimer()
 {
+    // Timer has fired, a new one must be armed if lookups are still active
+    mTimerArmed = false;
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
@@ -353,6 +382,7 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
         }
 
         NodeListener * listener = current->GetListener();
+        RecordLookupCompletion(*current, /* success = */ false);
         mActiveLookups.Erase(current);
 
         Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
@@ -367,8 +397,6 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
 
 void Resolver::ReArmTimer()
 {
-    mSystemLayer->CancelTimer(&OnResolveTimer, static_cast<void *>(this));
-
     System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
 
     System::Clock::Timeout nextTimeout = kInvalidTimeout;
@@ -388,11 +416,27 @@ void Resolver::ReArmTimer()
         // Generally this is only expected when no active lookups exist
         ChipLogProgress(Discovery, "Discovery does not require any more timeouts");
 #endif
+        mSystemLayer->CancelTimer(&OnResolveTimer, static_cast<void *>(this));
+        mTimerArmed = false;
+        return;
+    }
+
+    if (mTimerArmed && (mTimerDeadline == now + nextTimeout))
+    {
+        // Closest deadline did not change, existing timer is still correct
         return;
     }
 
+    mSystemLayer->CancelTimer(&OnResolveTimer, static_cast<void *>(this));
+    mTimerArmed = false;
+
     CHIP_ERROR err = mSystemLayer->StartTimer(nextTimeout, &OnResolveTimer, static_cast<void *>(this));
-    if (err != CHIP_NO_ERROR)
+    if (err == CHIP_NO_ERROR)
+    {
+        mTimerArmed    = true;
+        mTimerDeadline = now + nextTimeout;
+    }
+    else
     {
         ChipLogError(Discovery, "Timer schedule error %s assumed permanent", err.AsString());
 
@@ -403,6 +447,7 @@ void Resolver::ReArmTimer()
             const PeerId peerId     = it->GetRequest().GetPeerId();
             NodeListener * listener = it->GetListener();
 
+            RecordLookupCompletion(*it, /* success = */ false);
             mActiveLookups.Erase(it);
             it = mActiveLookups.begin();
 
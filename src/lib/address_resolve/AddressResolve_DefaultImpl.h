@@ -64,6 +64,28 @@ struct NodeLookupResults
 #endif // CHIP_DETAIL_LOGGING
 };
 
+/// Aggregated statistics of completed node lookups.
+///
+/// Latency is measured from the start of a lookup until its final
+/// result is reported to the listener.
+struct LookupStatistics
+{
+    uint32_t successCount = 0;
+    uint32_t failureCount = 0;
+
+    System::Clock::Milliseconds64 totalSuccessLatency = System::Clock::kZero;
+    System::Clock::Milliseconds64 maxSuccessLatency   = System::Clock::kZero;
+
+    System::Clock::Milliseconds64 AverageSuccessLatency() const
+    {
+        if (successCount == 0)
+        {
+            return System::Clock::kZero;
+        }
+        return totalSuccessLatency / successCount;
+    }
+};
+
 /// Action to take when some resolve data
 /// has been received by an active lookup
 class NodeLookupAction
@@ -129,6 +151,9 @@ class NodeLookupHandle : public NodeLookupHandleBase
 public:
     const NodeLookupRequest & GetRequest() const { return mRequest; }
 
+    /// Time at which the current lookup was started (see `ResetForLookup`)
+    System::Clock::Timestamp GetRequestStartTime() const { return mRequestStartTime; }
+
     /// Sets up a request for a new lookup.
     /// Resets internal state (i.e. best address so far)
     void ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request);
@@ -181,6 +206,11 @@ public:
     void OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData) override;
     void OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error) override;
 
+    /// Statistics on all the lookups completed since `Init` or the last
+    /// `ResetStatistics` call.
+    const LookupStatistics & GetStatistics() const { return mStatistics; }
+    void ResetStatistics() { mStatistics = LookupStatistics(); }
+
 private:
     static void OnResolveTimer(System::Layer * layer, void * context) { static_cast<Resolver *>(context)->HandleTimer(); }
 
@@ -200,9 +230,18 @@ private:
     /// be used after calling this method.
     void HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current);
 
+    /// Updates statistics for a lookup that is about to report its final result
+    void RecordLookupCompletion(const NodeLookupHandle & handle, bool success);
+
     System::Layer * mSystemLayer = nullptr;
     Time::TimeSource<Time::Source::kSystem> mTimeSource;
     IntrusiveList<NodeLookupHandle> mActiveLookups;
+    LookupStatistics mStatistics;
+
+    // Deadline of the currently armed timer, to avoid re-arming the timer
+    // when active lookups change without changing the closest deadline.
+    bool mTimerArmed = false;
+    System::Clock::Timestamp mTimerDeadline;
 };
 
 } // namespace Impl
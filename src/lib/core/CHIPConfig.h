@@ -718,6 +718,9 @@
  *  @brief
  *    Maximum number of Peer within a fabric that can send group data message to a device.
  *
+ *    When more peers send group messages, the message counter of the least
+ *    recently seen peer is forgotten.
+ *
  *  // TODO: Determine a better value for this
  */
 #ifndef CHIP_CONFIG_MAX_GROUP_DATA_PEERS
@@ -790,6 +793,7 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *    The following definitions sets the maximum number of corresponding interaction model object pool size.
  *
  *      * #CHIP_IM_MAX_NUM_COMMAND_HANDLER
+ *      * #CHIP_CONFIG_MAX_PATHS_PER_INVOKE
  *      * #CHIP_IM_MAX_NUM_READS
  *      * #CHIP_IM_MAX_NUM_SUBSCRIPTIONS
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
@@ -800,6 +804,13 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
+ *      * #CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES
+ *      * #CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+ *      * #CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES
+ *      * #CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_FLUSH_INTERVAL_MS
+ *      * #CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_MAX_LATENCY_MS
+ *      * #CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE
+ *      * #CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
  *
  *  @{
  */
@@ -813,6 +824,16 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_NUM_COMMAND_HANDLER 4
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+ *
+ * @brief The maximum number of commands a single Invoke Request may carry, each of which must then have a CommandRef.  The
+ * CommandHandler keeps a CommandRef per command, so this sizes a table in every CommandHandler.
+ */
+#ifndef CHIP_CONFIG_MAX_PATHS_PER_INVOKE
+#define CHIP_CONFIG_MAX_PATHS_PER_INVOKE 10
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_SUBSCRIPTIONS
  *
@@ -902,6 +923,82 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_NUM_TIMED_HANDLER 8
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES
+ *
+ * @brief The maximum number of attribute values DefaultAttributePersistenceProvider holds back while a write transaction
+ *        is in progress, to persist them once when it ends.  Values written once this many attributes are held back are
+ *        persisted right away.
+ *
+ *        Only the values written by the transaction itself are held back.  They are persisted before the response to
+ *        the last chunk of the transaction, but the responses to the intermediate chunks are sent before the values they
+ *        carry are persisted: if the device loses power in the middle of a chunked write, values already acknowledged
+ *        may be lost, as the transaction as a whole was never acknowledged.
+ */
+#ifndef CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES
+#define CHIP_CONFIG_MAX_BATCHED_ATTRIBUTE_WRITES 8
+#endif
+
+/**
+ * @def CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+ *
+ * @brief If enabled, the Server persists attribute values through a WriteBehindAttributePersistenceProvider, which holds
+ *        back the values of attributes that change often, such as during level or color transitions, and persists them
+ *        once they settle.  The values written by a write interaction are still persisted right away.
+ */
+#ifndef CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+#define CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES
+ *
+ * @brief The maximum number of attributes a WriteBehindAttributePersistenceProvider holds back at once.  Once this many
+ *        attributes are held back, the one due first is persisted to make room for another.
+ */
+#ifndef CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES
+#define CHIP_CONFIG_MAX_WRITE_BEHIND_ATTRIBUTES 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_FLUSH_INTERVAL_MS
+ *
+ * @brief The default time, in milliseconds, an attribute must go unchanged before a WriteBehindAttributePersistenceProvider
+ *        persists it.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_FLUSH_INTERVAL_MS
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_FLUSH_INTERVAL_MS 5000
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_MAX_LATENCY_MS
+ *
+ * @brief The default maximum time, in milliseconds, a WriteBehindAttributePersistenceProvider holds back the value of an
+ *        attribute that keeps changing.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_MAX_LATENCY_MS
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_MAX_LATENCY_MS 30000
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE
+ *
+ * @brief The number of distinct attribute paths an AttributeUpdateIngestor producer can buffer until the Matter thread
+ *        drains them.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_UPDATE_PRODUCER_BUFFER_SIZE 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
+ *
+ * @brief The size, in bytes, of the largest attribute value an AttributeUpdateIngestor producer can buffer.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE 16
+#endif
+
 /**
  * @def CONFIG_BUILD_FOR_HOST_UNIT_TEST
  *
@@ -1046,6 +1143,22 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+ *
+ * @brief Number of group operational keys kept in an in-RAM index, keyed by
+ *        group session id, to find the decryption candidates of incoming
+ *        groupcast messages without reading persistent storage.
+ *
+ * The index holds one entry per (group-key map entry, epoch key) pair across
+ * all fabrics, and is rebuilt lazily after any key set or group-key map
+ * change. If the configured data does not fit, candidates are read from
+ * storage as usual. A value of 0 disables the index.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+#define CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE 0
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1175,6 +1288,22 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of events, per priority buffer, described by an in-RAM
+ *   index of event number, path, fabric and encoded size.
+ *
+ * The index lets event reports skip events that are older than the
+ * requested event number, or that do not match the interested paths or
+ * fabric, without decoding their TLV.  When a buffer holds more events than
+ * the index can describe, the oldest ones are read by walking the TLV as
+ * usual.  A value of 0 disables the index.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 0
+#endif /* CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1298,6 +1427,61 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+ *
+ * @brief Maximum number of resolve/browse attempts that the minmdns resolver
+ *        tracks (and retries) concurrently.
+ *
+ *        When more resolves are requested than this limit allows, the oldest
+ *        pending attempt is dropped. Controllers that resolve many nodes at
+ *        the same time (e.g. on startup) should increase this value.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+#define CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS 4
+#endif // CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS
+ *
+ * @brief Delay, in milliseconds, between a new resolve/browse request and
+ *        the mDNS query being sent.
+ *
+ *        Requests made within this delay (e.g. a burst of resolves on
+ *        startup) are sent together in as few packets as possible.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS
+#define CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS 5
+#endif // CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+ *
+ * @brief Number of operational node resolutions that the minmdns resolver
+ *        keeps cached, based on the TTL of the received records.
+ *
+ *        Cached results are learned from all received mDNS responses and
+ *        allow node resolves to complete without sending any mDNS queries.
+ *        A value of 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS
+ *
+ * @brief Default number of concurrent connections supported by a heap
+ *        backed TCP transport (Transport::HeapTCP).
+ *
+ *        The connection table is allocated once, when the transport is
+ *        constructed, so this only affects memory use on platforms that
+ *        instantiate that transport.
+ */
+#ifndef CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS
+#define CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS 4
+#endif // CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -139,6 +139,21 @@ protected:
      */
     void GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_t & outBufLen) const;
 
+    /**
+     * @brief
+     *   Set the position and the length of the data held in the queue, e.g. when the backing store
+     *   already holds TLV elements written before a restart.
+     *
+     * @param[in] inHead   The start of the data; must fall within the backing store.
+     *
+     * @param[in] inLength Length of the data, in bytes; must not exceed the size of the backing store.
+     */
+    void SetQueueState(uint8_t * inHead, uint32_t inLength)
+    {
+        mQueueHead   = inHead;
+        mQueueLength = inLength;
+    }
+
 private:
     uint8_t * mQueue;
     uint32_t mQueueSize;
@@ -40,6 +40,24 @@ using namespace chip::Encoding;
 
 static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
 
+// Number of bytes of the length/value field of each element type, indexed by the type bits of the control byte, so that
+// the head of an element can be sized with two table lookups.  Reserved element types map to kInvalidElementTypeSize.
+static constexpr uint8_t kInvalidElementTypeSize = 0xFF;
+
+static const uint8_t sLenOrValSizes[] = {
+    1, 2, 4, 8, // Int8 .. Int64
+    1, 2, 4, 8, // UInt8 .. UInt64
+    0, 0,       // BooleanFalse, BooleanTrue
+    4, 8,       // FloatingPointNumber32, FloatingPointNumber64
+    1, 2, 4, 8, // UTF8String_1ByteLength .. UTF8String_8ByteLength
+    1, 2, 4, 8, // ByteString_1ByteLength .. ByteString_8ByteLength
+    0, 0, 0, 0, // Null, Structure, Array, List
+    0,          // EndOfContainer
+    kInvalidElementTypeSize, kInvalidElementTypeSize, kInvalidElementTypeSize, kInvalidElementTypeSize,
+    kInvalidElementTypeSize, kInvalidElementTypeSize, kInvalidElementTypeSize,
+};
+static_assert(sizeof(sLenOrValSizes) == kTLVTypeMask + 1, "Every element type must have a length/value field size");
+
 void TLVReader::Init(const uint8_t * data, size_t dataLen)
 {
     // TODO: Maybe we can just make mMaxLen and mLenRead size_t instead?
@@ -663,6 +681,14 @@ CHIP_ERROR TLVReader::SkipData()
 
     if (TLVTypeHasLength(elemType))
     {
+        // Data held entirely by the current buffer, as is always the case for contiguous readers, is skipped at once.
+        if (mElemLenOrVal <= static_cast<uint64_t>(mBufEnd - mReadPoint))
+        {
+            mReadPoint += mElemLenOrVal;
+            mLenRead += static_cast<uint32_t>(mElemLenOrVal);
+            return CHIP_NO_ERROR;
+        }
+
         err = ReadData(nullptr, static_cast<uint32_t>(mElemLenOrVal));
         if (err != CHIP_NO_ERROR)
             return err;
@@ -717,12 +743,14 @@ CHIP_ERROR TLVReader::ReadElement()
     CHIP_ERROR err;
     uint8_t stagingBuf[17]; // 17 = 1 control byte + 8 tag bytes + 8 length/value bytes
     const uint8_t * p;
-    TLVElementType elemType;
 
     // Make sure we have input data. Return CHIP_END_OF_TLV if no more data is available.
-    err = EnsureData(CHIP_END_OF_TLV);
-    if (err != CHIP_NO_ERROR)
-        return err;
+    if (mReadPoint == mBufEnd)
+    {
+        err = EnsureData(CHIP_END_OF_TLV);
+        if (err != CHIP_NO_ERROR)
+            return err;
+    }
 
     if (mReadPoint == nullptr)
     {
@@ -731,26 +759,17 @@ CHIP_ERROR TLVReader::ReadElement()
     // Get the element's control byte.
     mControlByte = *mReadPoint;
 
-    // Extract the element type from the control byte. Fail if it's invalid.
-    elemType = ElementType();
-    if (!IsValidTLVType(elemType))
+    // Determine the number of bytes in the length/value field from the element type. Fail if the type is invalid.
+    uint8_t valOrLenBytes = sLenOrValSizes[mControlByte & kTLVTypeMask];
+    if (valOrLenBytes == kInvalidElementTypeSize)
         return CHIP_ERROR_INVALID_TLV_ELEMENT;
 
     // Extract the tag control from the control byte.
     TLVTagControl tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
 
-    // Determine the number of bytes in the element's tag, if any.
-    uint8_t tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
-
-    // Extract the size of length/value field from the control byte.
-    TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
-
-    // Determine the number of bytes in the length/value field.
-    uint8_t valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
-
     // Determine the number of bytes in the element's 'head'. This includes: the control byte, the tag bytes (if present), the
     // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes.
-    uint8_t elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
+    uint8_t elemHeadBytes = static_cast<uint8_t>(1 + sTagSizes[tagControl >> kTLVTagControlShift] + valOrLenBytes);
 
     // If the head of the element overlaps the end of the input buffer, read the bytes into the staging buffer
     // and arrange to parse them from there. Otherwise read them directly from the input buffer.
@@ -771,27 +790,33 @@ CHIP_ERROR TLVReader::ReadElement()
     // Skip over the control byte.
     p++;
 
-    // Read the tag field, if present.
-    mElemTag = ReadTag(tagControl, p);
+    // Read the tag field, if present. Interaction Model messages use nearly only context and anonymous tags, so
+    // decode those here.
+    if (tagControl == TLVTagControl::ContextSpecific)
+        mElemTag = ContextTag(Read8(p));
+    else if (tagControl == TLVTagControl::Anonymous)
+        mElemTag = AnonymousTag();
+    else
+        mElemTag = ReadTag(tagControl, p);
 
     // Read the length/value field, if present.
-    switch (lenOrValFieldSize)
+    switch (valOrLenBytes)
     {
-    case kTLVFieldSize_0Byte:
+    case 0:
         mElemLenOrVal = 0;
         break;
-    case kTLVFieldSize_1Byte:
+    case 1:
         mElemLenOrVal = Read8(p);
         break;
-    case kTLVFieldSize_2Byte:
+    case 2:
         mElemLenOrVal = LittleEndian::Read16(p);
         break;
-    case kTLVFieldSize_4Byte:
+    case 4:
         mElemLenOrVal = LittleEndian::Read32(p);
         break;
-    case kTLVFieldSize_8Byte:
+    case 8:
         mElemLenOrVal = LittleEndian::Read64(p);
-        VerifyOrReturnError(!TLVTypeHasLength(elemType) || (mElemLenOrVal <= UINT32_MAX), CHIP_ERROR_NOT_IMPLEMENTED);
+        VerifyOrReturnError(!TLVTypeHasLength(ElementType()) || (mElemLenOrVal <= UINT32_MAX), CHIP_ERROR_NOT_IMPLEMENTED);
         break;
     }
 
@@ -951,33 +976,16 @@ CHIP_ERROR TLVReader::EnsureData(CHIP_ERROR noDataErr)
  */
 CHIP_ERROR TLVReader::GetElementHeadLength(uint8_t & elemHeadBytes) const
 {
-    uint8_t tagBytes;
-    uint8_t valOrLenBytes;
-    TLVTagControl tagControl;
-    TLVFieldSize lenOrValFieldSize;
-    TLVElementType elemType = ElementType();
-
     // Verify element is of valid TLVType.
-    VerifyOrReturnError(IsValidTLVType(elemType), CHIP_ERROR_INVALID_TLV_ELEMENT);
-
-    // Extract the tag control from the control byte.
-    tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
-
-    // Determine the number of bytes in the element's tag, if any.
-    tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
-
-    // Extract the size of length/value field from the control byte.
-    lenOrValFieldSize = GetTLVFieldSize(elemType);
-
-    // Determine the number of bytes in the length/value field.
-    valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
+    uint8_t valOrLenBytes = sLenOrValSizes[mControlByte & kTLVTypeMask];
+    VerifyOrReturnError(valOrLenBytes != kInvalidElementTypeSize, CHIP_ERROR_INVALID_TLV_ELEMENT);
 
     // Determine the number of bytes in the element's 'head'. This includes: the
     // control byte, the tag bytes (if present), the length bytes (if present),
     // and for elements that don't have a length (e.g. integers), the value
     // bytes.
-    VerifyOrReturnError(CanCastTo<uint8_t>(1 + tagBytes + valOrLenBytes), CHIP_ERROR_INTERNAL);
-    elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
+    TLVTagControl tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
+    elemHeadBytes            = static_cast<uint8_t>(1 + sTagSizes[tagControl >> kTLVTagControlShift] + valOrLenBytes);
 
     return CHIP_NO_ERROR;
 }
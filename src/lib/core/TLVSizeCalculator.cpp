@@ -0,0 +1,46 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/TLVSizeCalculator.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace TLV {
+
+void TLVSizeCalculator::Init(uint32_t maxLen)
+{
+    // The scratch store always provides a buffer.
+    CHIP_ERROR err = TLVWriter::Init(mScratchStore, maxLen);
+    VerifyOrDie(err == CHIP_NO_ERROR);
+}
+
+CHIP_ERROR TLVSizeCalculator::ScratchBackingStore::OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    return GetNewBuffer(writer, bufStart, bufLen);
+}
+
+CHIP_ERROR TLVSizeCalculator::ScratchBackingStore::GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    bufStart = mScratch;
+    bufLen   = sizeof(mScratch);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace TLV
+} // namespace chip
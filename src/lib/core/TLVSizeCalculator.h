@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *      This file defines a TLVWriter that computes the length of a TLV
+ *      encoding without storing it.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLV.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * A TLVWriter that computes the length of an encoding without keeping it.  The data written goes to a small scratch
+ * buffer, which is reused as many times as needed.
+ *
+ * Anything that encodes to a TLVWriter, such as the DataModel::Encode functions, can thus find out the length of its
+ * encoding, or whether it fits in some space, before writing it for real.  The length is given by GetLengthWritten().
+ *
+ * @note ReserveBuffer() cannot reserve more than the space left in the scratch buffer.
+ */
+class TLVSizeCalculator : public TLVWriter
+{
+public:
+    TLVSizeCalculator() { Init(); }
+
+    /**
+     * Start computing a new length.  As with a TLVWriter over a buffer of maxLen bytes, writing fails with
+     * CHIP_ERROR_BUFFER_TOO_SMALL once the length would exceed maxLen.
+     */
+    void Init(uint32_t maxLen = UINT32_MAX);
+
+private:
+    class ScratchBackingStore : public TLVBackingStore
+    {
+    public:
+        CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override { return CHIP_NO_ERROR; }
+
+    private:
+        // Large enough for any element head, so that only string data spans scratch buffers.
+        uint8_t mScratch[64];
+    };
+
+    ScratchBackingStore mScratchStore;
+};
+
+} // namespace TLV
+} // namespace chip
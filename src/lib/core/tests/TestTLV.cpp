@@ -31,6 +31,7 @@
 #include <lib/core/TLVCircularBuffer.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/core/TLVSizeCalculator.h>
 #include <lib/core/TLVUtilities.h>
 
 #include <lib/support/CHIPMem.h>
@@ -4591,6 +4592,81 @@ static void CheckTLVScopedBuffer(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+static void CheckElementHeads(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t sTagBytes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+    // Every control byte, followed by enough zeros for the largest element head (and zero lengths for strings).
+    for (uint16_t controlByte = 0; controlByte <= UINT8_MAX; controlByte++)
+    {
+        uint8_t encoding[17] = { static_cast<uint8_t>(controlByte) };
+        ContiguousBufferTLVReader reader;
+        reader.Init(encoding);
+        reader.ImplicitProfileId = TestProfile_1;
+
+        TLVElementType elemType = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        uint8_t tagControl      = static_cast<uint8_t>(controlByte & kTLVTagControlMask);
+        CHIP_ERROR err          = reader.Next();
+
+        if (!IsValidTLVType(elemType) || elemType == TLVElementType::EndOfContainer)
+        {
+            NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_TLV_ELEMENT);
+        }
+        else if (tagControl == static_cast<uint8_t>(TLVTagControl::ContextSpecific))
+        {
+            NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_TLV_TAG);
+        }
+        else
+        {
+            uint32_t headBytes = 1u + sTagBytes[tagControl >> kTLVTagControlShift] + TLVFieldSizeToBytes(GetTLVFieldSize(elemType));
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, reader.GetControlByte() == controlByte);
+            NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == headBytes);
+        }
+    }
+}
+
+static CHIP_ERROR WriteSizeCalculatorTestData(TLVWriter & writer)
+{
+    static const char sLongString[] = "A string longer than the scratch buffer of a TLVSizeCalculator, so that its data spans "
+                                      "several scratch buffers while the length of the encoding is computed.";
+    TLVType outerContainer;
+    TLVType innerContainer;
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerContainer));
+    ReturnErrorOnFailure(writer.Put(ContextTag(1), static_cast<uint8_t>(42)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<int64_t>(-1234567890123)));
+    ReturnErrorOnFailure(writer.PutBoolean(ProfileTag(TestProfile_1, 70000), true));
+    ReturnErrorOnFailure(writer.PutString(ContextTag(3), sLongString));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(4), kTLVType_Array, innerContainer));
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        ReturnErrorOnFailure(writer.Put(AnonymousTag(), ByteSpan(reinterpret_cast<const uint8_t *>(sLongString), i)));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(innerContainer));
+    ReturnErrorOnFailure(writer.PutNull(CommonTag(5)));
+    ReturnErrorOnFailure(writer.EndContainer(outerContainer));
+    return writer.Finalize();
+}
+
+static void CheckTLVSizeCalculator(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[1024];
+    TLVWriter writer;
+    writer.Init(buf);
+    NL_TEST_ASSERT_SUCCESS(inSuite, WriteSizeCalculatorTestData(writer));
+
+    TLVSizeCalculator calculator;
+    NL_TEST_ASSERT_SUCCESS(inSuite, WriteSizeCalculatorTestData(calculator));
+    NL_TEST_ASSERT(inSuite, calculator.GetLengthWritten() == writer.GetLengthWritten());
+
+    // The computation fails exactly like writing to a buffer that is too small.
+    calculator.Init(writer.GetLengthWritten());
+    NL_TEST_ASSERT_SUCCESS(inSuite, WriteSizeCalculatorTestData(calculator));
+    calculator.Init(writer.GetLengthWritten() - 1);
+    NL_TEST_ASSERT(inSuite, WriteSizeCalculatorTestData(calculator) == CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
 // Test Suite
 
 /**
@@ -4628,6 +4704,8 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV Reader Fuzz Test",           TLVReaderFuzzTest),
     NL_TEST_DEF("CHIP TLV GetStringView Test",         CheckGetStringView),
     NL_TEST_DEF("CHIP TLV GetByteView Test",           CheckGetByteView),
+    NL_TEST_DEF("CHIP TLV Element Heads Test",         CheckElementHeads),
+    NL_TEST_DEF("CHIP TLV Size Calculator Test",       CheckTLVSizeCalculator),
     NL_TEST_DEF("Int Min/Max Test",                    TestIntMinMax),
 
     NL_TEST_SENTINEL()
@@ -145,10 +145,14 @@ SerializedQNameIterator StoredServerName::Get() const
     return SerializedQNameIterator(BytesRange(mNameBuffer, mNameBuffer + sizeof(mNameBuffer)), mNameBuffer);
 }
 
-CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQNameIterator name, const mdns::Minimal::SrvRecord & srv)
+CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQNameIterator name, uint64_t ttlSeconds,
+                                                 const mdns::Minimal::SrvRecord & srv)
 {
     AutoInactiveResetter inactiveReset(*this);
 
+    mTtlSeconds = kMaxTtlSeconds;
+    UpdateTtl(ttlSeconds);
+
     ReturnErrorOnFailure(mRecordName.Set(name));
     ReturnErrorOnFailure(mTargetHostName.Set(srv.GetName()));
     mCommonResolutionData.port = srv.GetPort();
@@ -254,6 +258,7 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             MATTER_TRACE_EVENT_INSTANT("TXT not applicable");
             return CHIP_NO_ERROR;
         }
+        UpdateTtl(data.GetTtlSeconds());
         return OnTxtRecord(data, packetRange);
     case QType::A: {
         if (data.GetName() != mTargetHostName.Get())
@@ -269,6 +274,8 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
+        UpdateTtl(data.GetTtlSeconds());
+
         return OnIpAddress(interface, addr);
 #else
 #if CHIP_MINMDNS_HIGH_VERBOSITY
@@ -291,6 +298,8 @@ CHIP_ERROR IncrementalResolver::OnRecord(Inet::InterfaceId interface, const Reso
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
 
+        UpdateTtl(data.GetTtlSeconds());
+
         return OnIpAddress(interface, addr);
     }
     case QType::SRV: // SRV handled on creation, ignored for 'additional data'
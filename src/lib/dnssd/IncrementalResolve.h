@@ -96,8 +96,12 @@ public:
     /// Start parsing a new record. SRV records are the records we are mainly
     /// interested on, after which TXT and A/AAAA are looked for.
     ///
+    /// [ttlSeconds] is the TTL of the SRV record and bounds the value returned by
+    /// `GetTtlSeconds`.
+    ///
     /// If this function returns with error, the object will be in an inactive state.
-    CHIP_ERROR InitializeParsing(mdns::Minimal::SerializedQNameIterator name, const mdns::Minimal::SrvRecord & srv);
+    CHIP_ERROR InitializeParsing(mdns::Minimal::SerializedQNameIterator name, uint64_t ttlSeconds,
+                                 const mdns::Minimal::SrvRecord & srv);
 
     /// Notify that a new record is being processed.
     /// Will handle filtering and processing of data to determine if the entry is relevant for
@@ -130,6 +134,10 @@ public:
     ///           as this object is valid and InitializeParsing is not called again.
     mdns::Minimal::SerializedQNameIterator GetRecordName() const { return mRecordName.Get(); }
 
+    /// Smallest TTL of all the records (SRV, TXT, A/AAAA) that contributed to the
+    /// currently parsed data. Determines how long the parsed data may be cached.
+    uint32_t GetTtlSeconds() const { return mTtlSeconds; }
+
     /// Take the current value of the object and clear it once returned.
     ///
     /// Object must be in `IsActiveCommissionParse()` for this to succeed.
@@ -151,6 +159,7 @@ public:
     {
         mCommonResolutionData.Reset();
         mSpecificResolutionData = ParsedRecordSpecificData();
+        mTtlSeconds             = kMaxTtlSeconds;
     }
 
 private:
@@ -167,12 +176,24 @@ private:
     /// Prerequisite: IP address belongs to the right nost name
     CHIP_ERROR OnIpAddress(Inet::InterfaceId interface, const Inet::IPAddress & addr);
 
+    /// Lowers the tracked TTL to `ttlSeconds` if smaller than the current value
+    void UpdateTtl(uint64_t ttlSeconds)
+    {
+        if (ttlSeconds < mTtlSeconds)
+        {
+            mTtlSeconds = static_cast<uint32_t>(ttlSeconds);
+        }
+    }
+
     using ParsedRecordSpecificData = Variant<OperationalNodeData, CommissionNodeData>;
 
+    static constexpr uint32_t kMaxTtlSeconds = UINT32_MAX;
+
     StoredServerName mRecordName;     // Record name for what is parsed (SRV/PTR/TXT)
     StoredServerName mTargetHostName; // `Target` for the SRV record
     CommonResolutionData mCommonResolutionData;
     ParsedRecordSpecificData mSpecificResolutionData;
+    uint32_t mTtlSeconds = kMaxTtlSeconds;
 };
 
 } // namespace Dnssd
@@ -0,0 +1,240 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/PeerId.h>
+#include <lib/dnssd/Resolver.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Dnssd {
+
+/// Bounded cache of operational node resolutions.
+///
+/// Entries are learned from any complete operational SRV/TXT/AAAA record set
+/// observed by the resolver (including unsolicited announcements and answers
+/// to queries issued by other nodes) and are kept for the smallest TTL of the
+/// records that were used to build them.
+///
+/// When full, the least recently used entry is evicted. Expired entries are
+/// never returned and are reused first.
+///
+/// Receiving a record with a TTL of 0 (a "goodbye" record as per RFC 6762)
+/// evicts the corresponding entry.
+template <size_t kCacheSize>
+class OperationalResolveCache
+{
+public:
+    static_assert(kCacheSize > 0, "Cache must contain at least one entry");
+
+    /// Maximum time a record is kept, regardless of the advertised TTL.
+    ///
+    /// Operational records are advertised with a 120 second TTL, this limit
+    /// guards against peers advertising excessive values.
+    static constexpr uint32_t kMaxTtlSeconds = 60 * 60;
+
+    OperationalResolveCache(System::Clock::ClockBase * clock) : mClock(clock) {}
+
+    /// Add or replace the resolution data for `data.operationalData.peerId`,
+    /// valid for `ttlSeconds`.
+    ///
+    /// A `ttlSeconds` of 0 removes any cached data for the peer.
+    void Insert(const ResolvedNodeData & data, uint32_t ttlSeconds)
+    {
+        const PeerId & peerId = data.operationalData.peerId;
+
+        if (ttlSeconds == 0)
+        {
+            Remove(peerId);
+            return;
+        }
+
+        if (ttlSeconds > kMaxTtlSeconds)
+        {
+            ttlSeconds = kMaxTtlSeconds;
+        }
+
+        const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+        Entry * entry                       = FindEntry(peerId);
+
+        if (entry == nullptr)
+        {
+            entry = FindFreeOrExpiredEntry(now);
+        }
+
+        if (entry == nullptr)
+        {
+            entry = &mEntries[0];
+            for (auto & candidate : mEntries)
+            {
+                if (candidate.lastUsed < entry->lastUsed)
+                {
+                    entry = &candidate;
+                }
+            }
+        }
+
+        entry->data            = data;
+        entry->expiryTime      = now + System::Clock::Seconds32(ttlSeconds);
+        entry->lastUsed        = now;
+        entry->inUse           = true;
+        entry->deliveryPending = false;
+    }
+
+    /// Fetch a non-expired resolution for the given peer.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND if no fresh data exists.
+    CHIP_ERROR Lookup(const PeerId & peerId, ResolvedNodeData & outData)
+    {
+        Entry * entry = FindFreshEntry(peerId);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+
+        entry->lastUsed = mClock->GetMonotonicTimestamp();
+        outData         = entry->data;
+        return CHIP_NO_ERROR;
+    }
+
+    /// Mark that the fresh cached data for `peerId` should be handed out by a
+    /// later call to `TakePendingDelivery`.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND if no fresh data exists.
+    CHIP_ERROR MarkDeliveryPending(const PeerId & peerId)
+    {
+        Entry * entry = FindFreshEntry(peerId);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+
+        entry->lastUsed        = mClock->GetMonotonicTimestamp();
+        entry->deliveryPending = true;
+        return CHIP_NO_ERROR;
+    }
+
+    /// Clear a delivery request set by `MarkDeliveryPending`.
+    void CancelDeliveryPending(const PeerId & peerId)
+    {
+        Entry * entry = FindEntry(peerId);
+        if (entry != nullptr)
+        {
+            entry->deliveryPending = false;
+        }
+    }
+
+    /// Fetch one entry marked by `MarkDeliveryPending` and clear its pending
+    /// state.
+    ///
+    /// Returns false if no (non-expired) entries are pending delivery.
+    bool TakePendingDelivery(ResolvedNodeData & outData)
+    {
+        const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse || !entry.deliveryPending)
+            {
+                continue;
+            }
+
+            entry.deliveryPending = false;
+            if (entry.expiryTime <= now)
+            {
+                continue;
+            }
+
+            outData = entry.data;
+            return true;
+        }
+
+        return false;
+    }
+
+    /// Remove any cached data for the given peer.
+    void Remove(const PeerId & peerId)
+    {
+        Entry * entry = FindEntry(peerId);
+        if (entry != nullptr)
+        {
+            entry->inUse           = false;
+            entry->deliveryPending = false;
+        }
+    }
+
+    /// Remove all cached data.
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry.inUse           = false;
+            entry.deliveryPending = false;
+        }
+    }
+
+private:
+    struct Entry
+    {
+        ResolvedNodeData data;
+        System::Clock::Timestamp expiryTime = System::Clock::kZero;
+        System::Clock::Timestamp lastUsed   = System::Clock::kZero;
+        bool inUse                          = false;
+        bool deliveryPending                = false;
+    };
+
+    Entry * FindEntry(const PeerId & peerId)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse && (entry.data.operationalData.peerId == peerId))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    Entry * FindFreshEntry(const PeerId & peerId)
+    {
+        Entry * entry = FindEntry(peerId);
+        if ((entry != nullptr) && (entry->expiryTime <= mClock->GetMonotonicTimestamp()))
+        {
+            entry->inUse           = false;
+            entry->deliveryPending = false;
+            return nullptr;
+        }
+        return entry;
+    }
+
+    Entry * FindFreeOrExpiredEntry(System::Clock::Timestamp now)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse || (entry.expiryTime <= now))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    System::Clock::ClockBase * mClock;
+    Entry mEntries[kCacheSize];
+};
+
+} // namespace Dnssd
+} // namespace chip
@@ -23,6 +23,7 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/OperationalResolveCache.h>
 #include <lib/dnssd/ResolverProxy.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
@@ -215,7 +216,7 @@ void PacketParser::ParseSRVResource(const ResourceData & data)
             continue;
         }
 
-        CHIP_ERROR err = resolver.InitializeParsing(data.GetName(), srv);
+        CHIP_ERROR err = resolver.InitializeParsing(data.GetName(), data.GetTtlSeconds(), srv);
         if (err != CHIP_NO_ERROR)
         {
             // Receiving records that we do not need to parse is normal:
@@ -265,7 +266,12 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() :
+        mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+        ,
+        mResolveCache(&chip::System::SystemClock())
+#endif
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -293,11 +299,38 @@ private:
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
 
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    OperationalResolveCache<CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE> mResolveCache;
+
+    /// Reports cached resolutions requested via ResolveNodeId.
+    ///
+    /// Reporting is deferred so that callers of ResolveNodeId always receive
+    /// results asynchronously, same as for network resolution.
+    void DeliverCachedResolves();
+    static void DeliverCachedResolvesCallback(System::Layer *, void * self);
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+    /// Schedules sending of all pending queries after a short delay, so that
+    /// queries requested in quick succession share packets.
+    CHIP_ERROR ScheduleSendPendingQueries();
+
+    /// Adds the query for `attempt` to the packet being built in `builder`.
+    ///
+    /// If the packet has no more space for the query, the packet is sent
+    /// and the query is placed into a newly allocated packet.
+    CHIP_ERROR AddPendingQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
+
+    /// Sends the packet being built in `builder` (if any).
+    ///
+    /// `unicastResponse` selects if the packet contains queries that ask for
+    /// unicast responses (first sends) or multicast responses (retries).
+    CHIP_ERROR SendQueryPacket(QueryBuilder & builder, bool unicastResponse);
+
     /// Prepare a query for the given schedule attempt
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
@@ -311,6 +344,8 @@ private:
     void AdvancePendingResolverStates();
 
     static void RetryCallback(System::Layer *, void * self);
+    static void SendPendingQueriesCallback(System::Layer *, void * self);
+    bool mSendPendingQueriesScheduled = false;
 
     CHIP_ERROR BrowseNodes(DiscoveryType type, DiscoveryFilter subtype);
     template <typename... Args>
@@ -389,12 +424,19 @@ void MinMdnsResolver::AdvancePendingResolverStates()
         else if (resolver->IsActiveOperationalParse())
         {
             ResolvedNodeData nodeData;
+            [[maybe_unused]] const uint32_t ttlSeconds = resolver->GetTtlSeconds();
 
             CHIP_ERROR err = resolver->Take(nodeData);
             if (err != CHIP_NO_ERROR)
             {
                 ChipLogError(Discovery, "Failed to take discovery result: %" CHIP_ERROR_FORMAT, err.Format());
             }
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+            else
+            {
+                mResolveCache.Insert(nodeData, ttlSeconds);
+            }
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
 
             mActiveResolves.Complete(nodeData.operationalData.peerId);
             if (mOperationalDelegate != nullptr)
@@ -448,6 +490,20 @@ bool MinMdnsResolver::IsInitialized()
 
 void MinMdnsResolver::Shutdown()
 {
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(&SendPendingQueriesCallback, this);
+    }
+    mSendPendingQueriesScheduled = false;
+
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(&DeliverCachedResolvesCallback, this);
+    }
+    mResolveCache.Clear();
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
 }
 
@@ -574,8 +630,57 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::AddPendingQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt)
+{
+    if (builder.HasPacket())
+    {
+        if (BuildQuery(builder, attempt) == CHIP_NO_ERROR)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        // Query did not fit: send out what was accumulated so far and
+        // try again with an empty packet.
+        ReturnErrorOnFailure(SendQueryPacket(builder, attempt.firstSend));
+    }
+
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    builder.Reset(std::move(buffer));
+    builder.Header().SetMessageId(0);
+
+    CHIP_ERROR err = BuildQuery(builder, attempt);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not leave a packet without any queries in the builder
+        System::PacketBufferHandle unused = builder.ReleasePacket();
+    }
+    return err;
+}
+
+CHIP_ERROR MinMdnsResolver::SendQueryPacket(QueryBuilder & builder, bool unicastResponse)
+{
+    if (!builder.HasPacket())
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    if (unicastResponse)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort);
+    }
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // Pending queries are coalesced into as few packets as possible. First
+    // sends request unicast responses and are sent separately from retries.
+    QueryBuilder unicastResponseBuilder;
+    QueryBuilder multicastResponseBuilder;
+
     while (true)
     {
         Optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -585,24 +690,13 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
-
-        ReturnErrorOnFailure(BuildQuery(builder, resolve.Value()));
-
-        if (resolve.Value().firstSend)
-        {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
-        }
-        else
-        {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
-        }
+        QueryBuilder & builder = resolve.Value().firstSend ? unicastResponseBuilder : multicastResponseBuilder;
+        ReturnErrorOnFailure(AddPendingQuery(builder, resolve.Value()));
     }
 
+    ReturnErrorOnFailure(SendQueryPacket(unicastResponseBuilder, /* unicastResponse = */ true));
+    ReturnErrorOnFailure(SendQueryPacket(multicastResponseBuilder, /* unicastResponse = */ false));
+
     ExpireIncrementalResolvers();
 
     return ScheduleRetries();
@@ -656,21 +750,63 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 {
     mActiveResolves.MarkPending(filter, type);
 
-    return SendAllPendingQueries();
+    return ScheduleSendPendingQueries();
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    if ((mSystemLayer != nullptr) && (mResolveCache.MarkDeliveryPending(peerId) == CHIP_NO_ERROR))
+    {
+        ChipLogDetail(Discovery, "Using cached resolve data for " ChipLogFormatX64 ":" ChipLogFormatX64,
+                      ChipLogValueX64(peerId.GetCompressedFabricId()), ChipLogValueX64(peerId.GetNodeId()));
+
+        CHIP_ERROR err = mSystemLayer->StartTimer(System::Clock::kZero, &DeliverCachedResolvesCallback, this);
+        if (err == CHIP_NO_ERROR)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        // Fall back to a network resolve
+        mResolveCache.CancelDeliveryPending(peerId);
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+
     mActiveResolves.MarkPending(peerId);
 
-    return SendAllPendingQueries();
+    return ScheduleSendPendingQueries();
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+    mResolveCache.CancelDeliveryPending(peerId);
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+
     mActiveResolves.NodeIdResolutionNoLongerNeeded(peerId);
 }
 
+#if CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+void MinMdnsResolver::DeliverCachedResolves()
+{
+    ResolvedNodeData nodeData;
+
+    while (mResolveCache.TakePendingDelivery(nodeData))
+    {
+        if (mOperationalDelegate == nullptr)
+        {
+            continue;
+        }
+        mOperationalDelegate->OnOperationalNodeResolved(nodeData);
+    }
+}
+
+void MinMdnsResolver::DeliverCachedResolvesCallback(System::Layer *, void * self)
+{
+    static_cast<MinMdnsResolver *>(self)->DeliverCachedResolves();
+}
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE > 0
+
 CHIP_ERROR MinMdnsResolver::ScheduleRetries()
 {
     ReturnErrorCodeIf(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
@@ -691,6 +827,31 @@ void MinMdnsResolver::RetryCallback(System::Layer *, void * self)
     reinterpret_cast<MinMdnsResolver *>(self)->SendAllPendingQueries();
 }
 
+CHIP_ERROR MinMdnsResolver::ScheduleSendPendingQueries()
+{
+    ReturnErrorCodeIf(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // An already scheduled send will pick up the newly pending query as well.
+    VerifyOrReturnError(!mSendPendingQueriesScheduled, CHIP_NO_ERROR);
+
+    ReturnErrorOnFailure(mSystemLayer->StartTimer(System::Clock::Milliseconds32(CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS),
+                                                  &SendPendingQueriesCallback, this));
+    mSendPendingQueriesScheduled = true;
+    return CHIP_NO_ERROR;
+}
+
+void MinMdnsResolver::SendPendingQueriesCallback(System::Layer *, void * self)
+{
+    MinMdnsResolver * resolver             = reinterpret_cast<MinMdnsResolver *>(self);
+    resolver->mSendPendingQueriesScheduled = false;
+
+    CHIP_ERROR err = resolver->SendAllPendingQueries();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to send pending mDNS queries: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
 MinMdnsResolver gResolver;
 
 } // namespace
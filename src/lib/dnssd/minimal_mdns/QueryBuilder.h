@@ -33,8 +33,9 @@ public:
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
-        mPacket = std::move(packet);
-        mHeader = HeaderRef(mPacket->Start());
+        mPacket       = std::move(packet);
+        mHeader       = HeaderRef(mPacket->Start());
+        mQueryBuildOk = true;
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -60,6 +61,10 @@ public:
 
     HeaderRef & Header() { return mHeader; }
 
+    /// Returns true if a packet is currently being built, i.e. after a
+    /// `Reset` and before `ReleasePacket`.
+    bool HasPacket() const { return !mPacket.IsNull(); }
+
     QueryBuilder & AddQuery(const Query & query)
     {
         if (!mQueryBuildOk)
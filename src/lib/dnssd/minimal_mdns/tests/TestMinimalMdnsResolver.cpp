@@ -0,0 +1,125 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/Resolver.h>
+
+#include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/minimal_mdns/Server.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace mdns::Minimal;
+
+const PeerId kPeerId1 = PeerId().SetCompressedFabricId(0xBEEFBEEFF00DF00D).SetNodeId(0x1111222233334444);
+const PeerId kPeerId2 = PeerId().SetCompressedFabricId(0x5555666677778888).SetNodeId(0x1212343456567878);
+
+/// Server replacement that only counts the query packets handed to it.
+class QueryCountingServer : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                                   ServerBase::EndpointInfoPoolType::Interface>,
+                            public ServerBase
+{
+public:
+    QueryCountingServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    using ServerBase::BroadcastSend;
+    using ServerBase::BroadcastUnicastQuery;
+
+    CHIP_ERROR BroadcastUnicastQuery(chip::System::PacketBufferHandle && data, uint16_t port) override
+    {
+        mQueryPacketCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR BroadcastSend(chip::System::PacketBufferHandle && data, uint16_t port) override
+    {
+        mQueryPacketCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetQueryPacketCount() const { return mQueryPacketCount; }
+
+private:
+    size_t mQueryPacketCount = 0;
+};
+
+struct TestContext
+{
+    chip::Test::IOContext * ioContext;
+    QueryCountingServer * server;
+};
+
+void BackToBackResolvesShareOneQuery(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    auto & resolver   = Resolver::Instance();
+
+    NL_TEST_ASSERT(inSuite, resolver.ResolveNodeId(kPeerId1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.ResolveNodeId(kPeerId2) == CHIP_NO_ERROR);
+
+    // Nothing goes out until the coalescing delay expires.
+    NL_TEST_ASSERT(inSuite, ctx.server->GetQueryPacketCount() == 0);
+
+    ctx.ioContext->DriveIOUntil(System::Clock::Milliseconds32(CHIP_CONFIG_MINMDNS_QUERY_COALESCING_DELAY_MS + 1000),
+                                [&]() { return ctx.server->GetQueryPacketCount() > 0; });
+
+    // Both resolves went out in the same packet.
+    NL_TEST_ASSERT(inSuite, ctx.server->GetQueryPacketCount() == 1);
+
+    resolver.NodeIdResolutionNoLongerNeeded(kPeerId1);
+    resolver.NodeIdResolutionNoLongerNeeded(kPeerId2);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("BackToBackResolvesShareOneQuery", BackToBackResolvesShareOneQuery), //
+    NL_TEST_SENTINEL()                                                               //
+};
+
+} // namespace
+
+int TestMinimalMdnsResolver()
+{
+    chip::Platform::MemoryInit();
+    chip::Test::IOContext context;
+    context.Init();
+    QueryCountingServer server;
+    GlobalMinimalMdnsServer::Instance().Server().Shutdown();
+    GlobalMinimalMdnsServer::Instance().SetReplacementServer(&server);
+
+    auto & resolver = Resolver::Instance();
+    resolver.Init(context.GetUDPEndPointManager());
+
+    TestContext testContext = { &context, &server };
+    nlTestSuite theSuite    = { "MinimalMdnsResolver", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, &testContext);
+
+    resolver.Shutdown();
+    server.Shutdown();
+    GlobalMinimalMdnsServer::Instance().SetReplacementServer(nullptr);
+    context.Shutdown();
+    chip::Platform::MemoryShutdown();
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMinimalMdnsResolver)
@@ -180,7 +180,7 @@ void TestInactiveResetOnInitError(nlTestSuite * inSuite, void * inContext)
     PreloadSrvRecord(inSuite, srvRecord);
 
     // test host name is not a 'matter' name
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestHostName.Serialized(), srvRecord) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestHostName.Serialized(), 120, srvRecord) != CHIP_NO_ERROR);
 
     NL_TEST_ASSERT(inSuite, !resolver.IsActive());
     NL_TEST_ASSERT(inSuite, !resolver.IsActiveCommissionParse());
@@ -196,7 +196,7 @@ void TestStartOperational(nlTestSuite * inSuite, void * inContext)
     SrvRecord srvRecord;
     PreloadSrvRecord(inSuite, srvRecord);
 
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestOperationalName.Serialized(), srvRecord) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestOperationalName.Serialized(), 120, srvRecord) == CHIP_NO_ERROR);
 
     NL_TEST_ASSERT(inSuite, resolver.IsActive());
     NL_TEST_ASSERT(inSuite, !resolver.IsActiveCommissionParse());
@@ -215,7 +215,7 @@ void TestStartCommissionable(nlTestSuite * inSuite, void * inContext)
     SrvRecord srvRecord;
     PreloadSrvRecord(inSuite, srvRecord);
 
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionableNode.Serialized(), srvRecord) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionableNode.Serialized(), 120, srvRecord) == CHIP_NO_ERROR);
 
     NL_TEST_ASSERT(inSuite, resolver.IsActive());
     NL_TEST_ASSERT(inSuite, resolver.IsActiveCommissionParse());
@@ -234,7 +234,7 @@ void TestStartCommissioner(nlTestSuite * inSuite, void * inContext)
     SrvRecord srvRecord;
     PreloadSrvRecord(inSuite, srvRecord);
 
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionerNode.Serialized(), srvRecord) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionerNode.Serialized(), 120, srvRecord) == CHIP_NO_ERROR);
 
     NL_TEST_ASSERT(inSuite, resolver.IsActive());
     NL_TEST_ASSERT(inSuite, resolver.IsActiveCommissionParse());
@@ -253,7 +253,7 @@ void TestParseOperational(nlTestSuite * inSuite, void * inContext)
     SrvRecord srvRecord;
     PreloadSrvRecord(inSuite, srvRecord);
 
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestOperationalName.Serialized(), srvRecord) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestOperationalName.Serialized(), 300, srvRecord) == CHIP_NO_ERROR);
 
     // once initialized, parsing should be ready however no IP address is available
     NL_TEST_ASSERT(inSuite, resolver.IsActiveOperationalParse());
@@ -303,6 +303,9 @@ void TestParseOperational(nlTestSuite * inSuite, void * inContext)
     // Resolver should have all data
     NL_TEST_ASSERT(inSuite, !resolver.GetMissingRequiredInformation().HasAny());
 
+    // Cacheability is bounded by the smallest TTL of the records used (AAAA)
+    NL_TEST_ASSERT(inSuite, resolver.GetTtlSeconds() == IPResourceRecord::kDefaultTtl);
+
     // At this point taking value should work. Once taken, the resolver is reset.
     ResolvedNodeData nodeData;
     NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
@@ -333,7 +336,7 @@ void TestParseCommissionable(nlTestSuite * inSuite, void * inContext)
     SrvRecord srvRecord;
     PreloadSrvRecord(inSuite, srvRecord);
 
-    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionableNode.Serialized(), srvRecord) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.InitializeParsing(kTestCommissionableNode.Serialized(), 120, srvRecord) == CHIP_NO_ERROR);
 
     // once initialized, parsing should be ready however no IP address is available
     NL_TEST_ASSERT(inSuite, resolver.IsActiveCommissionParse());
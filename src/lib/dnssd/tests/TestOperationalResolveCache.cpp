@@ -0,0 +1,166 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/OperationalResolveCache.h>
+
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using chip::Dnssd::OperationalResolveCache;
+using chip::Dnssd::ResolvedNodeData;
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    PeerId peerId;
+    return peerId.SetNodeId(nodeId).SetCompressedFabricId(123);
+}
+
+ResolvedNodeData MakeNodeData(NodeId nodeId, uint16_t port)
+{
+    ResolvedNodeData data;
+    data.operationalData.peerId = MakePeerId(nodeId);
+    data.resolutionData.port    = port;
+    data.resolutionData.numIPs  = 1;
+    Inet::IPAddress::FromString("fe80::1234", data.resolutionData.ipAddress[0]);
+    return data;
+}
+
+void TestInsertLookup(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalResolveCache<4> cache(&mockClock);
+    ResolvedNodeData data;
+
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_ERROR_NOT_FOUND);
+
+    cache.Insert(MakeNodeData(1, 5540), 120);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, data.operationalData.peerId == MakePeerId(1));
+    NL_TEST_ASSERT(inSuite, data.resolutionData.port == 5540);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(2), data) == CHIP_ERROR_NOT_FOUND);
+
+    // Re-inserting replaces data
+    cache.Insert(MakeNodeData(1, 1234), 120);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, data.resolutionData.port == 1234);
+
+    cache.Remove(MakePeerId(1));
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_ERROR_NOT_FOUND);
+}
+
+void TestExpiry(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalResolveCache<4> cache(&mockClock);
+    ResolvedNodeData data;
+
+    mockClock.AdvanceMonotonic(1234_ms32);
+
+    cache.Insert(MakeNodeData(1, 5540), 10);
+    cache.Insert(MakeNodeData(2, 5540), 20);
+
+    mockClock.AdvanceMonotonic(9999_ms32);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(2), data) == CHIP_NO_ERROR);
+
+    mockClock.AdvanceMonotonic(1_ms32);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(2), data) == CHIP_NO_ERROR);
+
+    mockClock.AdvanceMonotonic(10000_ms32);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(2), data) == CHIP_ERROR_NOT_FOUND);
+
+    // A TTL of 0 is a goodbye and removes existing data
+    cache.Insert(MakeNodeData(3, 5540), 120);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(3), data) == CHIP_NO_ERROR);
+    cache.Insert(MakeNodeData(3, 5540), 0);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(3), data) == CHIP_ERROR_NOT_FOUND);
+}
+
+void TestLRU(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalResolveCache<3> cache(&mockClock);
+    ResolvedNodeData data;
+
+    cache.Insert(MakeNodeData(1, 5540), 120);
+    mockClock.AdvanceMonotonic(10_ms32);
+    cache.Insert(MakeNodeData(2, 5540), 120);
+    mockClock.AdvanceMonotonic(10_ms32);
+    cache.Insert(MakeNodeData(3, 5540), 120);
+    mockClock.AdvanceMonotonic(10_ms32);
+
+    // Using 1 makes 2 the least recently used
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_NO_ERROR);
+    mockClock.AdvanceMonotonic(10_ms32);
+
+    cache.Insert(MakeNodeData(4, 5540), 120);
+
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(1), data) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(2), data) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(3), data) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(MakePeerId(4), data) == CHIP_NO_ERROR);
+}
+
+void TestPendingDelivery(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    OperationalResolveCache<4> cache(&mockClock);
+    ResolvedNodeData data;
+
+    NL_TEST_ASSERT(inSuite, cache.MarkDeliveryPending(MakePeerId(1)) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, !cache.TakePendingDelivery(data));
+
+    cache.Insert(MakeNodeData(1, 5540), 120);
+    cache.Insert(MakeNodeData(2, 5540), 120);
+    cache.Insert(MakeNodeData(3, 5540), 1);
+
+    NL_TEST_ASSERT(inSuite, cache.MarkDeliveryPending(MakePeerId(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.MarkDeliveryPending(MakePeerId(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.MarkDeliveryPending(MakePeerId(3)) == CHIP_NO_ERROR);
+    cache.CancelDeliveryPending(MakePeerId(2));
+
+    // Entry 3 expires before delivery and is skipped
+    mockClock.AdvanceMonotonic(1000_ms32);
+
+    NL_TEST_ASSERT(inSuite, cache.TakePendingDelivery(data));
+    NL_TEST_ASSERT(inSuite, data.operationalData.peerId == MakePeerId(1));
+    NL_TEST_ASSERT(inSuite, !cache.TakePendingDelivery(data));
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestInsertLookup", TestInsertLookup),       //
+    NL_TEST_DEF("TestExpiry", TestExpiry),                   //
+    NL_TEST_DEF("TestLRU", TestLRU),                         //
+    NL_TEST_DEF("TestPendingDelivery", TestPendingDelivery), //
+    NL_TEST_SENTINEL()                                       //
+};
+
+} // namespace
+
+int TestOperationalResolveCache()
+{
+    nlTestSuite theSuite = { "OperationalResolveCache", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestOperationalResolveCache)
@@ -107,6 +107,21 @@ public:
         return err;
     }
 
+    /**
+     *  @brief
+     *  Advance the value of the counter by the given amount.
+     *
+     *  @param[in] aValue  The amount to add to the counter.
+     *
+     *  @return A CHIP error code if something fails, CHIP_NO_ERROR otherwise
+     */
+    virtual CHIP_ERROR AdvanceBy(T aValue)
+    {
+        mCounterValue = static_cast<T>(mCounterValue + aValue);
+
+        return CHIP_NO_ERROR;
+    }
+
     /**
      *  @brief
      *  Get the current value of the counter.
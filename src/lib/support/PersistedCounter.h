@@ -137,6 +137,30 @@ public:
         return CHIP_NO_ERROR;
     }
 
+    /**
+     *  @brief
+     *  Advance the counter by the given amount, writing to persisted storage
+     *  at most once, if the new value is past the current epoch.
+     *
+     *  @param[in] aValue  The amount to add to the counter.
+     *
+     *  @return Any error returned by a write to persisted storage.
+     */
+    CHIP_ERROR AdvanceBy(T aValue) override
+    {
+        VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(mKey.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+        ReturnErrorOnFailure(MonotonicallyIncreasingCounter<T>::AdvanceBy(aValue));
+
+        if (MonotonicallyIncreasingCounter<T>::GetValue() >= mNextEpoch)
+        {
+            // Persist the start of the epoch following the new value.
+            ReturnErrorOnFailure(PersistNextEpochStart(MonotonicallyIncreasingCounter<T>::GetValue() + mEpoch));
+        }
+        return CHIP_NO_ERROR;
+    }
+
 private:
     /**
      *  @brief
@@ -129,16 +129,53 @@ Loop StaticAllocatorBitmap::ForEachActiveObjectInner(void * context, Lambda lamb
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
-HeapObjectListNode * HeapObjectList::FindNode(void * object) const
+namespace {
+
+#if __SANITIZE_ADDRESS__
+// Free the blocks of released objects right away, so that ASAN can catch use-after-free.
+constexpr size_t kMaxCachedBlocks = 0;
+#else
+constexpr size_t kMaxCachedBlocks = CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS;
+#endif
+
+} // namespace
+
+void * HeapObjectList::AllocateBlock(size_t blockSize)
 {
-    for (HeapObjectListNode * p = mNext; p != this; p = p->mNext)
+    if (mCachedBlocks == nullptr)
     {
-        if (p->mObject == object)
-        {
-            return p;
-        }
+        return Platform::MemoryAlloc(blockSize);
     }
-    return nullptr;
+
+    HeapObjectListNode * block = mCachedBlocks;
+    mCachedBlocks              = block->mNext;
+    mCachedBlockCount--;
+    return block;
+}
+
+void HeapObjectList::ReleaseBlock(void * block)
+{
+    if (mCachedBlockCount >= kMaxCachedBlocks)
+    {
+        Platform::MemoryFree(block);
+        return;
+    }
+
+    HeapObjectListNode * node = static_cast<HeapObjectListNode *>(block);
+    node->mNext               = mCachedBlocks;
+    mCachedBlocks             = node;
+    mCachedBlockCount++;
+}
+
+void HeapObjectList::ReleaseCachedBlocks()
+{
+    while (mCachedBlocks != nullptr)
+    {
+        HeapObjectListNode * next = mCachedBlocks->mNext;
+        Platform::MemoryFree(mCachedBlocks);
+        mCachedBlocks = next;
+    }
+    mCachedBlockCount = 0;
 }
 
 Loop HeapObjectList::ForEachNode(void * context, Lambda lambda)
@@ -169,7 +206,7 @@ Loop HeapObjectList::ForEachNode(void * context, Lambda lambda)
             if (p->mObject == nullptr)
             {
                 p->Remove();
-                Platform::Delete(p);
+                ReleaseBlock(p);
             }
             p = next;
         }
@@ -29,6 +29,7 @@
 #include <lib/support/Iterators.h>
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
@@ -149,9 +150,17 @@ struct HeapObjectListNode
     HeapObjectListNode * mPrev;
 };
 
+/**
+ * List of the objects of a HeapObjectPool.
+ *
+ * Each node is at the start of a heap block that also holds its object, so that finding the node of an object takes constant
+ * time.  Up to CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS blocks of released objects are kept for reuse, so that a pool whose
+ * usage is steady does not allocate from the heap, even when it keeps going back to no objects.
+ */
 struct HeapObjectList : HeapObjectListNode
 {
     HeapObjectList() { mNext = mPrev = this; }
+    ~HeapObjectList() { ReleaseCachedBlocks(); }
 
     void Append(HeapObjectListNode * node)
     {
@@ -161,7 +170,16 @@ struct HeapObjectList : HeapObjectListNode
         mPrev        = node;
     }
 
-    HeapObjectListNode * FindNode(void * object) const;
+    /**
+     * Allocate a block of blockSize bytes, starting with a node.  All the blocks of a list must have the same size.
+     */
+    void * AllocateBlock(size_t blockSize);
+
+    /**
+     * Release a block allocated by AllocateBlock, whose node has been removed from the list.
+     */
+    void ReleaseBlock(void * block);
+    void ReleaseCachedBlocks();
 
     using Lambda = Loop (*)(void *, void *);
     Loop ForEachNode(void * context, Lambda lambda);
@@ -172,6 +190,9 @@ struct HeapObjectList : HeapObjectListNode
 
     size_t mIterationDepth         = 0;
     bool mHaveDeferredNodeRemovals = false;
+    // Blocks kept for reuse, linked through the mNext of their node.
+    HeapObjectListNode * mCachedBlocks = nullptr;
+    size_t mCachedBlockCount           = 0;
 };
 
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -342,19 +363,18 @@ public:
     template <typename... Args>
     T * CreateObject(Args &&... args)
     {
-        T * object = Platform::New<T>(std::forward<Args>(args)...);
-        if (object != nullptr)
+        void * storage = mObjects.AllocateBlock(sizeof(ObjectBlock));
+        if (storage == nullptr)
         {
-            auto node = Platform::New<internal::HeapObjectListNode>();
-            if (node != nullptr)
-            {
-                node->mObject = object;
-                mObjects.Append(node);
-                IncreaseUsage();
-                return object;
-            }
+            return nullptr;
         }
-        return nullptr;
+
+        ObjectBlock * block  = new (storage) ObjectBlock;
+        T * object           = new (block->mObject) T(std::forward<Args>(args)...);
+        block->mNode.mObject = object;
+        mObjects.Append(&block->mNode);
+        IncreaseUsage();
+        return object;
     }
 
     /*
@@ -373,20 +393,20 @@ public:
     {
         if (object != nullptr)
         {
-            internal::HeapObjectListNode * node = mObjects.FindNode(object);
+            ObjectBlock * block = BlockOf(object);
             // Releasing an object that is not allocated indicates likely memory
             // corruption; better to safe-crash than proceed at this point.
-            VerifyOrDie(node != nullptr);
+            VerifyOrDie(block->mNode.mObject == object);
 
-            node->mObject = nullptr;
-            Platform::Delete(object);
+            block->mNode.mObject = nullptr;
+            object->~T();
 
             // The node needs to be released immediately if we are not in the middle of iteration.
             // Otherwise cleanup is deferred until all iteration on this pool completes and it's safe to release nodes.
             if (mObjects.mIterationDepth == 0)
             {
-                node->Remove();
-                Platform::Delete(node);
+                block->mNode.Remove();
+                mObjects.ReleaseBlock(block);
             }
             else
             {
@@ -397,7 +417,12 @@ public:
         }
     }
 
-    void ReleaseAll() { mObjects.ForEachNode(this, ReleaseObject); }
+    void ReleaseAll()
+    {
+        mObjects.ForEachNode(this, ReleaseObject);
+        // Blocks whose removal is still deferred by an enclosing iteration are cached when it ends.
+        mObjects.ReleaseCachedBlocks();
+    }
 
     /**
      * @brief
@@ -431,6 +456,19 @@ public:
     }
 
 private:
+    // The node of an object and the object itself are allocated together.
+    struct ObjectBlock
+    {
+        internal::HeapObjectListNode mNode;
+        alignas(T) uint8_t mObject[sizeof(T)];
+    };
+    static_assert(alignof(ObjectBlock) <= alignof(std::max_align_t), "Heap blocks are not aligned enough for T");
+
+    static ObjectBlock * BlockOf(T * object)
+    {
+        return reinterpret_cast<ObjectBlock *>(reinterpret_cast<uint8_t *>(object) - offsetof(ObjectBlock, mObject));
+    }
+
     static Loop ReleaseObject(void * context, void * object)
     {
         static_cast<HeapObjectPool *>(context)->ReleaseObject(static_cast<T *>(object));
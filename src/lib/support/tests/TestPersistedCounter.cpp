@@ -173,6 +173,33 @@ static void CheckWriteNextCounterStart(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, value == 0x20000);
 }
 
+static void CheckAdvanceBy(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistedCounterContext * context = static_cast<TestPersistedCounterContext *>(inContext);
+
+    InitializePersistedStorage(context);
+
+    chip::PersistedCounter<uint64_t> counter, counter2;
+
+    CHIP_ERROR err = counter.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x10000);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Advancing within the current epoch does not change the next starting value.
+    err = counter.AdvanceBy(0x100);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x100);
+
+    // Advancing across several epochs at once persists a starting value past the new value.
+    err = counter.AdvanceBy(0x34000);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x34100);
+
+    // Now we "reboot", and we should start past the advanced value.
+    err = counter2.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x10000);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter2.GetValue() == 0x44100);
+}
+
 // Test Suite
 
 /**
@@ -182,6 +209,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Out of box Test", CheckOOB),                                 //
     NL_TEST_DEF("Reboot Test", CheckReboot),                                  //
     NL_TEST_DEF("Write Next Counter Start Test", CheckWriteNextCounterStart), //
+    NL_TEST_DEF("Advance By Test", CheckAdvanceBy),                           //
     NL_TEST_SENTINEL()                                                        //
 };
 
@@ -407,6 +407,66 @@ void TestPoolInterfaceDynamic(nlTestSuite * inSuite, void * inContext)
 }
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TestHeapBlockReuse(nlTestSuite * inSuite, void * inContext)
+{
+    struct alignas(16) S
+    {
+        S(uint64_t value) : mValue(value) {}
+        uint64_t mValue;
+    };
+
+    constexpr size_t kSize = CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS + 4;
+    ObjectPool<S, kSize, ObjectPoolMem::kHeap> pool;
+    S * objects[kSize];
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        objects[i] = pool.CreateObject(i);
+        NL_TEST_ASSERT(inSuite, objects[i] != nullptr);
+        NL_TEST_ASSERT(inSuite, reinterpret_cast<uintptr_t>(objects[i]) % alignof(S) == 0);
+    }
+
+    // Objects can be released in any order, the others are unaffected.
+    for (size_t i = 0; i < kSize; i += 2)
+    {
+        pool.ReleaseObject(objects[i]);
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == kSize / 2);
+    for (size_t i = 1; i < kSize; i += 2)
+    {
+        NL_TEST_ASSERT(inSuite, objects[i]->mValue == i);
+    }
+
+    // The most recently released block is reused first, unless blocks are not cached because of ASAN.
+    S * object = pool.CreateObject(100);
+#if !__SANITIZE_ADDRESS__
+    NL_TEST_ASSERT(inSuite, object == objects[kSize - 2]);
+#endif
+    NL_TEST_ASSERT(inSuite, object->mValue == 100);
+    pool.ReleaseObject(object);
+
+    // Blocks stay cached once the pool is empty, so that a pool going back and forth to no objects does not allocate.
+    for (size_t i = 1; i < kSize; i += 2)
+    {
+        pool.ReleaseObject(objects[i]);
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+    object = pool.CreateObject(101);
+    pool.ReleaseObject(object);
+    S * reused = pool.CreateObject(102);
+#if !__SANITIZE_ADDRESS__
+    NL_TEST_ASSERT(inSuite, reused == object);
+#endif
+    NL_TEST_ASSERT(inSuite, reused->mValue == 102);
+    pool.ReleaseObject(reused);
+
+    pool.ReleaseAll();
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 int Setup(void * inContext)
 {
     return ::chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
@@ -437,6 +497,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF_FN(TestCreateReleaseStructDynamic),
     NL_TEST_DEF_FN(TestForEachActiveObjectDynamic),
     NL_TEST_DEF_FN(TestPoolInterfaceDynamic),
+    NL_TEST_DEF_FN(TestHeapBlockReuse),
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     NL_TEST_SENTINEL()
     // clang-format on
@@ -259,8 +259,12 @@ void ExchangeContext::DoClose(bool clearRetransTable)
     // Closure of an exchange context is based on ref counting. The Protocol, when it calls DoClose(), indicates that
     // it is done with the exchange context and the message layer sets all callbacks to NULL and does not send anything
     // received on the exchange context up to higher layers.  At this point, the message layer needs to handle the
-    // remaining work to be done on that exchange, (e.g. send all pending acks) before truly cleaning it up.
-    FlushAcks();
+    // remaining work to be done on that exchange, (e.g. send all pending acks) before truly cleaning it up.  When coalescing
+    // acks, the reliable message manager holds the pending ack instead.
+    if (!mExchangeMgr->GetReliableMessageMgr()->HoldAck(this))
+    {
+        FlushAcks();
+    }
 
     // In case the protocol wants a harder release of the EC right away, such as calling Abort(), exchange
     // needs to clear the MRP retransmission table immediately.
@@ -328,6 +332,7 @@ ExchangeContext::ExchangeContext(ExchangeManager * em, uint16_t ExchangeId, cons
     mFlags.Set(Flags::kFlagInitiator, Initiator);
     mFlags.Set(Flags::kFlagEphemeralExchange, isEphemeralExchange);
     mDelegate = delegate;
+    mExchangeMgr->AddToExchangeIndex(*this);
 
     //
     // If we're an initiator and we just created this exchange, we obviously did so to send a message. Let's go ahead and
@@ -372,6 +377,7 @@ ExchangeContext::~ExchangeContext()
     // the boolean parameter passed to DoClose() should not matter.
 
     DoClose(false);
+    mExchangeMgr->RemoveFromExchangeIndex(*this);
     mExchangeMgr = nullptr;
 
 #if defined(CHIP_EXCHANGE_CONTEXT_DETAIL_LOGGING)
@@ -515,6 +521,15 @@ void ExchangeContext::NotifyResponseTimeout(bool aCloseIfNeeded)
     }
 }
 
+void ExchangeContext::OnQueuedMessageSendFailure()
+{
+    // SendMessage succeeded when the message was queued, so the response timer is running; the response will never come.
+    VerifyOrReturn(IsResponseExpected());
+
+    CancelResponseTimer();
+    NotifyResponseTimeout(/* aCloseIfNeeded = */ true);
+}
+
 CHIP_ERROR ExchangeContext::HandleMessage(uint32_t messageCounter, const PayloadHeader & payloadHeader, MessageFlags msgFlags,
                                           PacketBufferHandle && msgBuf)
 {
@@ -62,6 +62,7 @@ class DLL_EXPORT ExchangeContext : public ReliableMessageContext,
 {
     friend class ExchangeManager;
     friend class ExchangeContextDeletor;
+    friend class ReliableMessageMgr;
 
 public:
     typedef System::Clock::Timeout Timeout; // Type used to express the timeout in this ExchangeContext
@@ -248,6 +249,8 @@ private:
     ExchangeSessionHolder mSession; // The connection state
     uint16_t mExchangeId;           // Assigned exchange ID.
 
+    ExchangeContext * mNextInExchangeIndex = nullptr; // Next exchange in the same bucket of the exchange manager index.
+
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
      *  message had the kExpectResponse flag set in its sendFlags).
@@ -279,6 +282,13 @@ private:
      */
     void NotifyResponseTimeout(bool aCloseIfNeeded);
 
+    /**
+     * Called by the reliable message manager when a message of this exchange
+     * that waited in its send queue could not be sent.  If a response to the
+     * message was expected, notify our delegate of the timeout right away.
+     */
+    void OnQueuedMessageSendFailure();
+
     CHIP_ERROR StartResponseTimer();
 
     void CancelResponseTimer();
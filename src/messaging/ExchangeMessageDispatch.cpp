@@ -51,14 +51,38 @@ CHIP_ERROR ExchangeMessageDispatch::SendMessage(SessionManager * sessionManager,
     PayloadHeader payloadHeader;
     payloadHeader.SetExchangeID(exchangeId).SetMessageType(protocol, type).SetInitiator(isInitiator);
 
+    bool isReliable = IsReliableTransmissionAllowed() && reliableMessageContext->AutoRequestAck() &&
+        reliableMessageContext->GetReliableMessageMgr() != nullptr && isReliableTransmission;
+
+    // Queue the message if the send window of the session is full.  Its pending acknowledgment, if any, is left to be sent
+    // standalone or piggybacked when the message is dequeued.
+    ReliableMessageMgr::SendPriority priority = ReliableMessageMgr::SendPriority::kNormal;
+    if (protocol == Protocols::SecureChannel::Id && type == to_underlying(Protocols::SecureChannel::MsgType::StatusReport))
+    {
+        priority = ReliableMessageMgr::SendPriority::kHigh;
+    }
+    if (isReliable && reliableMessageContext->GetReliableMessageMgr()->ShouldQueueMessage(session, priority))
+    {
+        payloadHeader.SetNeedsAck(true);
+        return reliableMessageContext->GetReliableMessageMgr()->QueueMessage(reliableMessageContext, payloadHeader,
+                                                                             std::move(message), priority);
+    }
+
     // If there is a pending acknowledgment piggyback it on this message.
+    uint32_t coalescedAckMessageCounter;
     if (reliableMessageContext->HasPiggybackAckPending())
     {
         payloadHeader.SetAckMessageCounter(reliableMessageContext->TakePendingPeerAckMessageCounter());
     }
+    // Otherwise piggyback the one another exchange of the session has pending, if coalescing acks.
+    else if (IsReliableTransmissionAllowed() && reliableMessageContext->GetReliableMessageMgr() != nullptr &&
+             reliableMessageContext->GetReliableMessageMgr()->TakeCoalescedAck(session, reliableMessageContext,
+                                                                               coalescedAckMessageCounter))
+    {
+        payloadHeader.SetAckMessageCounter(coalescedAckMessageCounter);
+    }
 
-    if (IsReliableTransmissionAllowed() && reliableMessageContext->AutoRequestAck() &&
-        reliableMessageContext->GetReliableMessageMgr() != nullptr && isReliableTransmission)
+    if (isReliable)
     {
         auto * reliableMessageMgr = reliableMessageContext->GetReliableMessageMgr();
 
@@ -29,6 +29,7 @@
 #define __STDC_LIMIT_MACROS
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <inttypes.h>
 #include <stddef.h>
@@ -82,6 +83,7 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
         // then re-initializes without removing registered handlers.
         handler.Reset();
     }
+    mUMHandlerCount = 0;
 
     sessionManager->SetMessageDelegate(this);
 
@@ -142,28 +144,28 @@ CHIP_ERROR ExchangeManager::UnregisterUnsolicitedMessageHandlerForType(Protocols
 
 CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
 {
-    UnsolicitedMessageHandlerSlot * selected = nullptr;
-
-    for (auto & umh : UMHandlerPool)
+    UnsolicitedMessageHandlerSlot * umh = FindUMH(protocolId, msgType);
+    if (umh != nullptr)
     {
-        if (!umh.IsInUse())
-        {
-            if (selected == nullptr)
-                selected = &umh;
-        }
-        else if (umh.Matches(protocolId, msgType))
-        {
-            umh.Handler = handler;
-            return CHIP_NO_ERROR;
-        }
+        umh->Handler = handler;
+        return CHIP_NO_ERROR;
     }
 
-    if (selected == nullptr)
+    if (mUMHandlerCount == ArraySize(UMHandlerPool))
         return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
 
-    selected->Handler     = handler;
-    selected->ProtocolId  = protocolId;
-    selected->MessageType = msgType;
+    // Shift the slots sorting after the new handler to keep the in-use slots sorted.
+    const uint64_t key = UnsolicitedMessageHandlerSlot::Key(protocolId, msgType);
+    size_t index       = mUMHandlerCount;
+    for (; index > 0 && UMHandlerPool[index - 1].Key() > key; index--)
+    {
+        UMHandlerPool[index] = UMHandlerPool[index - 1];
+    }
+
+    UMHandlerPool[index].Handler     = handler;
+    UMHandlerPool[index].ProtocolId  = protocolId;
+    UMHandlerPool[index].MessageType = msgType;
+    mUMHandlerCount++;
 
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -172,17 +174,72 @@ CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgTyp
 
 CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
 {
-    for (auto & umh : UMHandlerPool)
+    UnsolicitedMessageHandlerSlot * umh = FindUMH(protocolId, msgType);
+    if (umh == nullptr)
+        return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+
+    std::copy(umh + 1, &UMHandlerPool[mUMHandlerCount], umh);
+    UMHandlerPool[--mUMHandlerCount].Reset();
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+
+    return CHIP_NO_ERROR;
+}
+
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    const uint64_t key = UnsolicitedMessageHandlerSlot::Key(protocolId, msgType);
+    auto * end         = &UMHandlerPool[mUMHandlerCount];
+    auto * umh         = std::lower_bound(&UMHandlerPool[0], end, key,
+                                  [](const UnsolicitedMessageHandlerSlot & slot, uint64_t value) { return slot.Key() < value; });
+    return (umh != end && umh->Key() == key) ? umh : nullptr;
+}
+
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMHForMessage(const PayloadHeader & payloadHeader)
+{
+    // Prefer handlers that can explicitly handle the message type over handlers that handle all messages for a protocol.
+    UnsolicitedMessageHandlerSlot * umh = FindUMH(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType());
+    if (umh == nullptr || !umh->IsInUse())
     {
-        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
-        {
-            umh.Reset();
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
-            return CHIP_NO_ERROR;
-        }
+        umh = FindUMH(payloadHeader.GetProtocolID(), kAnyMessageType);
+    }
+    return (umh != nullptr && umh->IsInUse()) ? umh : nullptr;
+}
+
+size_t ExchangeManager::GetExchangeIndexBucket(uint16_t exchangeId, bool isInitiator)
+{
+    // Exchange ids are allocated sequentially, so their low bits spread the exchanges evenly.
+    return ((static_cast<size_t>(exchangeId) << 1) | (isInitiator ? 1 : 0)) & (kExchangeIndexSize - 1);
+}
+
+void ExchangeManager::AddToExchangeIndex(ExchangeContext & ec)
+{
+    ExchangeContext *& head = mExchangeIndex[GetExchangeIndexBucket(ec.GetExchangeId(), ec.IsInitiator())];
+    ec.mNextInExchangeIndex = head;
+    head                    = &ec;
+}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext & ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[GetExchangeIndexBucket(ec.GetExchangeId(), ec.IsInitiator())];
+    while (*link != nullptr && *link != &ec)
+    {
+        link = &(*link)->mNextInExchangeIndex;
     }
+    VerifyOrDie(*link == &ec);
+    *link                   = ec.mNextInExchangeIndex;
+    ec.mNextInExchangeIndex = nullptr;
+}
 
-    return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    // A message sent by an initiator belongs to a responder exchange, and vice versa.
+    ExchangeContext * ec = mExchangeIndex[GetExchangeIndexBucket(payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator())];
+    while (ec != nullptr && !ec->MatchExchange(session, packetHeader, payloadHeader))
+    {
+        ec = ec->mNextInExchangeIndex;
+    }
+    return ec;
 }
 
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
@@ -238,23 +295,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -277,24 +325,8 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     // unsolicited messages must be marked as being from an initiator.
     if (!msgFlags.Has(MessageFlagValues::kDuplicateMessage) && payloadHeader.IsInitiator())
     {
-        // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
-        // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
-
-        for (auto & umh : UMHandlerPool)
-        {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
-        }
+        // Search for an unsolicited message handler that can handle the message.
+        matchingUMH = FindUMHForMessage(payloadHeader);
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
     // an ack to the peer.
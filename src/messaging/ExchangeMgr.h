@@ -42,6 +42,18 @@ class ExchangeDelegate;
 
 static constexpr int16_t kAnyMessageType = -1;
 
+namespace detail {
+constexpr size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace detail
+
 /**
  *  @brief
  *    This class is used to manage ExchangeContexts with other CHIP nodes.
@@ -212,6 +224,15 @@ private:
             return ProtocolId == aProtocolId && MessageType == aMessageType;
         }
 
+        // Key the in-use slots are sorted by.  The wildcard handler of a protocol sorts before its handlers for specific
+        // message types.
+        static constexpr uint64_t Key(Protocols::Id aProtocolId, int16_t aMessageType)
+        {
+            return (static_cast<uint64_t>(aProtocolId.ToFullyQualifiedSpecForm()) << 16) |
+                static_cast<uint16_t>(aMessageType - kAnyMessageType);
+        }
+        constexpr uint64_t Key() const { return Key(ProtocolId, MessageType); }
+
         Protocols::Id ProtocolId;
         // Message types are normally 8-bit unsigned ints, but we use
         // kAnyMessageType, which is negative, to represent a wildcard handler,
@@ -222,21 +243,39 @@ private:
         UnsolicitedMessageHandler * Handler;
     };
 
+    // The exchange index has a bucket for every exchange context the pool can hold, for each role.
+    static constexpr size_t kExchangeIndexSize = detail::RoundUpToPowerOfTwo(2 * CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS);
+
     uint16_t mNextExchangeId;
     uint16_t mNextKeyId;
     State mState;
 
     FabricIndex mFabricIndex = 0;
 
+    // Active exchange contexts, chained through ExchangeContext::mNextInExchangeIndex and hashed on the exchange id and the
+    // initiator flag, which are fixed for the lifetime of an exchange.  The session of an exchange can change, so it is only
+    // compared when matching an incoming message.  Declared before mContextPool so that it outlives the exchange contexts.
+    ExchangeContext * mExchangeIndex[kExchangeIndexSize] = {};
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
 
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
+    // The in-use slots are kept at the front of the pool, sorted by UnsolicitedMessageHandlerSlot::Key().
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    size_t mUMHandlerCount = 0;
 
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
+    UnsolicitedMessageHandlerSlot * FindUMH(Protocols::Id protocolId, int16_t msgType);
+    UnsolicitedMessageHandlerSlot * FindUMHForMessage(const PayloadHeader & payloadHeader);
+
+    static size_t GetExchangeIndexBucket(uint16_t exchangeId, bool isInitiator);
+    void AddToExchangeIndex(ExchangeContext & ec);
+    void RemoveFromExchangeIndex(ExchangeContext & ec);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
 
     void OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader, const SessionHandle & session,
                            DuplicateMessage isDuplicate, System::PacketBufferHandle && msgBuf) override;
@@ -158,8 +158,7 @@ CHIP_ERROR ReliableMessageContext::HandleNeedsAckInner(uint32_t messageCounter,
 
     // Replace the Pending ack message counter.
     SetPendingPeerAckMessageCounter(messageCounter);
-    using namespace System::Clock::Literals;
-    mNextAckTime = System::SystemClock().GetMonotonicTimestamp() + CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT;
+    mNextAckTime = System::SystemClock().GetMonotonicTimestamp() + GetReliableMessageMgr()->GetAckTimeout();
     return CHIP_NO_ERROR;
 }
 
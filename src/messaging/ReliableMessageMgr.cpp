@@ -21,6 +21,7 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
 
@@ -43,18 +44,24 @@ namespace chip {
 namespace Messaging {
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0), firstSendTime(0), sendCount(0), queueTime(0), queueSequence(0),
+    priority(SendPriority::kNormal)
 {
     ec->SetMessageNotAcked(true);
 }
 
 ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
 {
+    if (IsQueued())
+    {
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumQueuedMessages);
+    }
     ec->SetMessageNotAcked(false);
 }
 
 ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
-    mContextPool(contextPool), mSystemLayer(nullptr)
+    mContextPool(contextPool), mSystemLayer(nullptr), mAckCoalescingWindow(CHIP_CONFIG_RMP_ACK_COALESCING_WINDOW),
+    mAdaptiveRetransTimeout(CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT), mSendWindow(CHIP_CONFIG_MRP_SEND_WINDOW)
 {}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
@@ -73,6 +80,7 @@ void ReliableMessageMgr::Shutdown()
         mRetransTable.ReleaseObject(entry);
         return Loop::Continue;
     });
+    mHeldAcks.ReleaseAll();
 
     mSystemLayer = nullptr;
 }
@@ -83,6 +91,11 @@ void ReliableMessageMgr::TicklessDebugDumpRetransTable(const char * log)
     ChipLogDetail(ExchangeManager, log);
 
     mRetransTable.ForEachActiveObject([&](auto * entry) {
+        if (entry->IsQueued())
+        {
+            ChipLogDetail(ExchangeManager, "EC:" ChipLogFormatExchange " Queued", ChipLogValueExchange(&entry->ec.Get()));
+            return Loop::Continue;
+        }
         ChipLogDetail(ExchangeManager,
                       "EC:" ChipLogFormatExchange " MessageCounter:" ChipLogFormatMessageCounter " NextRetransTimeCtr:%" PRIu64,
                       ChipLogValueExchange(&entry->ec.Get()), entry->retainedBuf.GetMessageCounter(),
@@ -115,6 +128,15 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
+    mHeldAcks.ForEachActiveObject([&](auto * heldAck) {
+        if (heldAck->ackTime <= now)
+        {
+            SendHeldAck(*heldAck);
+            mHeldAcks.ReleaseObject(heldAck);
+        }
+        return Loop::Continue;
+    });
+
     // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->nextRetransTime > now)
@@ -161,15 +183,26 @@ void ReliableMessageMgr::ExecuteActions()
                       " Send Cnt %d",
                       messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
 
-        // Choose active/idle timeout from PeerActiveMode of session per 4.11.2.1. Retransmissions.
-        System::Clock::Timestamp baseTimeout = entry->ec->GetSessionHandle()->GetMRPBaseTimeout();
+        System::Clock::Timestamp baseTimeout = GetRetransBaseTimeout(entry->ec->GetSessionHandle());
         System::Clock::Timestamp backoff     = ReliableMessageMgr::GetBackoff(baseTimeout, entry->sendCount);
         entry->nextRetransTime               = System::SystemClock().GetMonotonicTimestamp() + backoff;
+
+        // The backoff above already accounts for the retransmission of this message, the estimator backs off the next ones.
+        if (entry->sendCount == 1)
+        {
+            entry->ec->GetSessionHandle()->GetRoundTripTimeEstimator().OnRetransmission();
+        }
         SendFromRetransTable(entry);
 
         return Loop::Continue;
     });
 
+    // Messages in flight may have failed, opening send windows.
+    if (mSendWindow > 0 || mSendQueueReady)
+    {
+        SendQueuedMessages();
+    }
+
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
 
@@ -270,28 +303,62 @@ System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp
     return mrpBackoffTime;
 }
 
-void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
+System::Clock::Timestamp ReliableMessageMgr::GetRetransBaseTimeout(const SessionHandle & session) const
 {
     // Choose active/idle timeout from PeerActiveMode of session per 4.11.2.1. Retransmissions.
-    System::Clock::Timestamp baseTimeout = entry->ec->GetSessionHandle()->GetMRPBaseTimeout();
+    System::Clock::Timestamp baseTimeout = session->GetMRPBaseTimeout();
+    VerifyOrReturnValue(mAdaptiveRetransTimeout, baseTimeout);
+
+    return session->GetRoundTripTimeEstimator().GetRetransBaseTimeout(baseTimeout, System::SystemClock().GetMonotonicTimestamp(),
+                                                                       Transport::kMinActiveTime);
+}
+
+void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
+{
+    System::Clock::Timestamp now         = System::SystemClock().GetMonotonicTimestamp();
+    System::Clock::Timestamp baseTimeout = GetRetransBaseTimeout(entry->ec->GetSessionHandle());
     System::Clock::Timestamp backoff     = ReliableMessageMgr::GetBackoff(baseTimeout, entry->sendCount);
-    entry->nextRetransTime               = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    entry->nextRetransTime               = now + backoff;
+    entry->firstSendTime                 = now;
+    if (mSendWindow > 0)
+    {
+        mSendQueueStats.mSentMessages++;
+    }
     StartTimer();
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
-    bool removed = false;
+    ExchangeContext * ackExchange = rc->GetExchangeContext();
+    bool removed                  = false;
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
+        if (entry->IsQueued() || entry->retainedBuf.GetMessageCounter() != ackMessageCounter)
         {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(*entry);
+            return Loop::Continue;
+        }
 
+        // Message counters are unique within a session, so the ack of a peer coalescing acks may come on any exchange of the
+        // session.  This is not part of the specification, so such acks are only accepted when coalescing is enabled.
+        if (entry->ec->GetReliableMessageContext() == rc ||
+            (IsAckCoalescingEnabled() && ackExchange->HasSessionHandle() && entry->ec->HasSessionHandle() &&
+             entry->ec->GetSessionHandle() == ackExchange->GetSessionHandle()))
+        {
             ChipLogDetail(ExchangeManager,
                           "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
                           " from Retrans Table on exchange " ChipLogFormatExchange,
-                          ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+                          ackMessageCounter, ChipLogValueExchange(&entry->ec.Get()));
+
+            // Per Karn's algorithm, the acknowledgment of a retransmitted message can't tell which transmission it acknowledges,
+            // so only the messages sent once give round-trip time samples.
+            if (entry->sendCount == 0 && entry->ec->HasSessionHandle())
+            {
+                System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+                entry->ec->GetSessionHandle()->GetRoundTripTimeEstimator().AddSample(
+                    std::chrono::duration_cast<System::Clock::Milliseconds32>(now - entry->firstSendTime), now);
+            }
+
+            // Clear the entry from the retransmision table.
+            ClearRetransTable(*entry);
             removed = true;
             return Loop::Break;
         }
@@ -352,6 +419,254 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
     return err;
 }
 
+bool ReliableMessageMgr::HoldAck(ReliableMessageContext * rc)
+{
+    ExchangeContext * ec = rc->GetExchangeContext();
+    VerifyOrReturnValue(IsAckCoalescingEnabled() && rc->IsAckPending() && !rc->IsEphemeralExchange() && ec->HasSessionHandle(),
+                        false);
+
+    HeldAck * heldAck = mHeldAcks.CreateObject(ec->GetExchangeMgr(), ec->GetSessionHandle(), ec->GetExchangeId(),
+                                               ec->IsInitiator(), rc->mPendingPeerAckMessageCounter, rc->mNextAckTime);
+    if (heldAck != nullptr && !heldAck->session)
+    {
+        // The session is being released.
+        mHeldAcks.ReleaseObject(heldAck);
+        heldAck = nullptr;
+    }
+    VerifyOrReturnValue(heldAck != nullptr, false);
+
+    rc->SetAckPending(false);
+    StartTimer();
+    return true;
+}
+
+bool ReliableMessageMgr::TakeCoalescedAck(const SessionHandle & session, ReliableMessageContext * rc,
+                                          uint32_t & ackMessageCounter)
+{
+    VerifyOrReturnValue(IsAckCoalescingEnabled() && !rc->HasPiggybackAckPending(), false);
+
+    // Take the ack due first, be it pending on an exchange or held for a closed one.
+    ReliableMessageContext * firstContext = nullptr;
+    HeldAck * firstHeldAck                = nullptr;
+    System::Clock::Timestamp firstAckTime = System::Clock::Timestamp::max();
+
+    ExecuteForAllContext([&](ReliableMessageContext * other) {
+        ExchangeContext * ec = other->GetExchangeContext();
+        if (other != rc && other->IsAckPending() && other->mNextAckTime < firstAckTime && ec->HasSessionHandle() &&
+            ec->GetSessionHandle() == session)
+        {
+            firstContext = other;
+            firstAckTime = other->mNextAckTime;
+        }
+    });
+    mHeldAcks.ForEachActiveObject([&](auto * heldAck) {
+        if (heldAck->ackTime < firstAckTime && heldAck->session.Contains(session))
+        {
+            firstContext = nullptr;
+            firstHeldAck = heldAck;
+            firstAckTime = heldAck->ackTime;
+        }
+        return Loop::Continue;
+    });
+
+    if (firstHeldAck != nullptr)
+    {
+        ackMessageCounter = firstHeldAck->messageCounter;
+        mHeldAcks.ReleaseObject(firstHeldAck);
+    }
+    else if (firstContext != nullptr)
+    {
+        ackMessageCounter = firstContext->TakePendingPeerAckMessageCounter();
+    }
+    else
+    {
+        return false;
+    }
+
+    ChipLogDetail(ExchangeManager,
+                  "Coalescing ack for MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
+}
+
+void ReliableMessageMgr::SendHeldAck(HeldAck & heldAck)
+{
+    // Nothing to ack if the session was released.
+    Optional<SessionHandle> session = heldAck.session.Get();
+    VerifyOrReturn(session.HasValue());
+
+    // As for a message no handler takes, an ephemeral exchange sends the standalone ack.
+    ExchangeContext * ec = mContextPool.CreateObject(heldAck.exchangeMgr, heldAck.exchangeId, session.Value(),
+                                                     heldAck.isInitiator, nullptr, true /* isEphemeralExchange */);
+    if (ec == nullptr)
+    {
+        ChipLogError(ExchangeManager,
+                     "Failed to send held ack for MessageCounter:" ChipLogFormatMessageCounter ": %" CHIP_ERROR_FORMAT,
+                     heldAck.messageCounter, CHIP_ERROR_NO_MEMORY.Format());
+        return;
+    }
+
+    ec->SetPendingPeerAckMessageCounter(heldAck.messageCounter);
+    ec->SendStandaloneAckMessage();
+    ec->Close();
+}
+
+bool ReliableMessageMgr::ShouldQueueMessage(const SessionHandle & session, SendPriority priority)
+{
+    VerifyOrReturnValue(mSendWindow > 0, false);
+
+    // Besides a full window, messages of the same or higher priority waiting in the queue keep the message from overtaking them.
+    bool queuedAhead = false;
+    mRetransTable.ForEachActiveObject([&](auto * entry) {
+        if (entry->IsQueued() && entry->priority >= priority && entry->ec->HasSessionHandle() &&
+            entry->ec->GetSessionHandle() == session)
+        {
+            queuedAhead = true;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+
+    return queuedAhead || !IsSendWindowOpen(session);
+}
+
+bool ReliableMessageMgr::IsSendWindowOpen(const SessionHandle & session)
+{
+    VerifyOrReturnValue(mSendWindow > 0, true);
+
+    uint8_t inFlight = 0;
+    mRetransTable.ForEachActiveObject([&](auto * entry) {
+        if (!entry->IsQueued() && entry->ec->HasSessionHandle() && entry->ec->GetSessionHandle() == session)
+        {
+            inFlight++;
+        }
+        return Loop::Continue;
+    });
+
+    return inFlight < mSendWindow;
+}
+
+CHIP_ERROR ReliableMessageMgr::QueueMessage(ReliableMessageContext * rc, const PayloadHeader & payloadHeader,
+                                            System::PacketBufferHandle && message, SendPriority priority)
+{
+    VerifyOrReturnError(!message.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    RetransTableEntry * entry = nullptr;
+    ReturnErrorOnFailure(AddToRetransTable(rc, &entry));
+
+    entry->queuedPayloadHeader = payloadHeader;
+    entry->queuedMessage       = std::move(message);
+    entry->queueTime           = System::SystemClock().GetMonotonicTimestamp();
+    entry->queueSequence       = mSendQueueSequence++;
+    entry->priority            = priority;
+    entry->nextRetransTime     = System::Clock::Timestamp::max();
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumQueuedMessages);
+
+    ChipLogDetail(ExchangeManager, "Send window full, queuing message on exchange " ChipLogFormatExchange,
+                  ChipLogValueExchange(rc->GetExchangeContext()));
+    return CHIP_NO_ERROR;
+}
+
+void ReliableMessageMgr::SetSendWindow(uint8_t window)
+{
+    mSendWindow     = window;
+    mSendQueueReady = true;
+    // Send the queued messages the new window allows right away.
+    if (mSystemLayer != nullptr)
+    {
+        StartTimer();
+    }
+}
+
+void ReliableMessageMgr::SendQueuedMessages()
+{
+    mSendQueueReady = false;
+
+    // Send the first queued message of the highest priority among the sessions whose window is open, until there is none.
+    while (true)
+    {
+        RetransTableEntry * next = nullptr;
+        mRetransTable.ForEachActiveObject([&](auto * entry) {
+            if (!entry->IsQueued())
+            {
+                return Loop::Continue;
+            }
+            if (next != nullptr &&
+                (entry->priority < next->priority ||
+                 (entry->priority == next->priority && static_cast<int32_t>(entry->queueSequence - next->queueSequence) > 0)))
+            {
+                return Loop::Continue;
+            }
+            // A message whose exchange lost its session is sent only to be cleared.
+            if (!entry->ec->HasSessionHandle() || IsSendWindowOpen(entry->ec->GetSessionHandle()))
+            {
+                next = entry;
+            }
+            return Loop::Continue;
+        });
+        VerifyOrReturn(next != nullptr);
+
+        SendQueuedMessage(next);
+    }
+}
+
+CHIP_ERROR ReliableMessageMgr::SendQueuedMessage(RetransTableEntry * entry)
+{
+    System::Clock::Milliseconds32 queueDelay = std::chrono::duration_cast<System::Clock::Milliseconds32>(
+        System::SystemClock().GetMonotonicTimestamp() - entry->queueTime);
+    mSendQueueStats.mQueuedMessages++;
+    mSendQueueStats.mTotalQueueDelay += queueDelay;
+    mSendQueueStats.mMaxQueueDelay = std::max(mSendQueueStats.mMaxQueueDelay, queueDelay);
+
+    System::PacketBufferHandle message = std::move(entry->queuedMessage);
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumQueuedMessages);
+
+    CHIP_ERROR err = CHIP_ERROR_INCORRECT_STATE;
+    if (entry->ec->HasSessionHandle())
+    {
+        ReliableMessageContext * rc   = entry->ec->GetReliableMessageContext();
+        SessionHandle session         = entry->ec->GetSessionHandle();
+        PayloadHeader & payloadHeader = entry->queuedPayloadHeader;
+        uint32_t coalescedAckMessageCounter;
+
+        // The acknowledgments pending when the message was queued were left for standalone acks, piggyback the ones still
+        // pending now.
+        if (rc->HasPiggybackAckPending())
+        {
+            payloadHeader.SetAckMessageCounter(rc->TakePendingPeerAckMessageCounter());
+        }
+        else if (TakeCoalescedAck(session, rc, coalescedAckMessageCounter))
+        {
+            payloadHeader.SetAckMessageCounter(coalescedAckMessageCounter);
+        }
+
+        auto * sessionManager = entry->ec->GetExchangeMgr()->GetSessionManager();
+        err                   = sessionManager->PrepareMessage(session, payloadHeader, std::move(message), entry->retainedBuf);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = sessionManager->SendPreparedMessage(session, entry->retainedBuf);
+            err = MapSendError(err, entry->ec->GetExchangeId(), entry->ec->IsInitiator());
+        }
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(ExchangeManager, "Failed to send queued message on exchange " ChipLogFormatExchange ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueExchange(&entry->ec.Get()), err.Format());
+        ExchangeHandle ec = entry->ec;
+        ClearRetransTable(*entry);
+        ec->OnQueuedMessageSendFailure();
+        return err;
+    }
+
+    ChipLogDetail(ExchangeManager,
+                  "Sent queued MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
+                  " after %" PRIu32 "ms",
+                  entry->retainedBuf.GetMessageCounter(), ChipLogValueExchange(&entry->ec.Get()), queueDelay.count());
+    StartRetransmision(entry);
+    return CHIP_NO_ERROR;
+}
+
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
     mRetransTable.ForEachActiveObject([&](auto * entry) {
@@ -366,6 +681,8 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
+    // A message no longer in flight opens the send window of its session, the timer sends the messages it queued.
+    mSendQueueReady = mSendQueueReady || (mSendWindow > 0 && !entry.IsQueued());
     mRetransTable.ReleaseObject(&entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
@@ -376,12 +693,25 @@ void ReliableMessageMgr::StartTimer()
     // When do we need to next wake up to send an ACK?
     System::Clock::Timestamp nextWakeTime = System::Clock::Timestamp::max();
 
+    // Messages may be sent from the send queues right away.
+    if (mSendQueueReady)
+    {
+        nextWakeTime = System::Clock::kZero;
+    }
+
     ExecuteForAllContext([&](ReliableMessageContext * rc) {
         if (rc->IsAckPending() && rc->mNextAckTime < nextWakeTime)
         {
             nextWakeTime = rc->mNextAckTime;
         }
     });
+    mHeldAcks.ForEachActiveObject([&](auto * heldAck) {
+        if (heldAck->ackTime < nextWakeTime)
+        {
+            nextWakeTime = heldAck->ackTime;
+        }
+        return Loop::Continue;
+    });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
     mRetransTable.ForEachActiveObject([&](auto * entry) {
@@ -463,6 +793,16 @@ int ReliableMessageMgr::TestGetCountRetransTable()
     });
     return count;
 }
+
+int ReliableMessageMgr::TestGetCountHeldAcks()
+{
+    int count = 0;
+    mHeldAcks.ForEachActiveObject([&](auto * heldAck) {
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
 #endif // CHIP_CONFIG_TEST
 
 } // namespace Messaging
@@ -45,6 +45,15 @@ class ReliableMessageContext;
 class ReliableMessageMgr
 {
 public:
+    /**
+     *  The priority of a message in the send queue of its session.  Acknowledgments are never queued.
+     */
+    enum class SendPriority : uint8_t
+    {
+        kNormal = 0,
+        kHigh   = 1, ///< Jumps ahead of the messages of normal priority, e.g. for status reports.
+    };
+
     /**
      *  @class RetransTableEntry
      *
@@ -63,8 +72,30 @@ public:
         ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
         EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
+        System::Clock::Timestamp firstSendTime;   /**< The time the message was first sent, to measure its round-trip time. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+
+        // A message waiting in the send queue of its session is not prepared yet, so that it only gets its message counter,
+        // and piggybacks a pending acknowledgment, once sent.
+        bool IsQueued() const { return !queuedMessage.IsNull(); }
+
+        PayloadHeader queuedPayloadHeader;
+        System::PacketBufferHandle queuedMessage;
+        System::Clock::Timestamp queueTime;
+        uint32_t queueSequence;
+        SendPriority priority;
+    };
+
+    /**
+     *  Statistics of the send queues of the sessions.
+     */
+    struct SendQueueStats
+    {
+        uint32_t mSentMessages                         = 0; ///< Reliable messages sent under a send window, queued or not.
+        uint32_t mQueuedMessages                       = 0; ///< Messages that were queued, then sent.
+        System::Clock::Milliseconds64 mTotalQueueDelay = System::Clock::kZero;
+        System::Clock::Milliseconds32 mMaxQueueDelay   = System::Clock::kZero;
     };
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
@@ -184,6 +215,99 @@ public:
      */
     void RegisterSessionUpdateDelegate(SessionUpdateDelegate * sessionUpdateDelegate);
 
+    /**
+     *  Set the acknowledgment coalescing window, zero to disable coalescing.
+     *
+     *  When coalescing, pending acknowledgments are held for up to the window instead of the acknowledgment timeout, so
+     *  that any exchange of their session can piggyback them.  The acknowledgment pending on an exchange that closes is
+     *  held too, and sent as a standalone acknowledgment once the window elapsed if no message piggybacked it.
+     *
+     *  Acknowledgments carried by another exchange are not part of the Matter specification: enable coalescing only when
+     *  every peer is a node built from this SDK with coalescing enabled too, since only such a node matches them against its
+     *  retransmission table in CheckAndRemRetransTable.  Other peers ignore them and retransmit.  The window must also stay
+     *  below the retransmission timeout of the peers.
+     */
+    void SetAckCoalescingWindow(System::Clock::Timeout window) { mAckCoalescingWindow = window; }
+
+    bool IsAckCoalescingEnabled() const { return mAckCoalescingWindow != System::Clock::kZero; }
+
+    /**
+     *  The time for which an exchange holds a pending acknowledgment before sending a standalone acknowledgment.
+     */
+    System::Clock::Timeout GetAckTimeout() const
+    {
+        using namespace System::Clock::Literals;
+        return IsAckCoalescingEnabled() ? mAckCoalescingWindow : System::Clock::Timeout(CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT);
+    }
+
+    /**
+     *  Hold the acknowledgment pending on a closing exchange, to be piggybacked by another exchange of its session or sent
+     *  once due.
+     *
+     *  @retval true if the acknowledgment is held, and no longer pending on the exchange.
+     *  @retval false if coalescing is disabled or the acknowledgment can't be held, and the exchange must flush it.
+     */
+    bool HoldAck(ReliableMessageContext * rc);
+
+    /**
+     *  Take the acknowledgment, pending on another exchange of the session or held for a closed one, that is due first, to
+     *  piggyback it on a message sent by rc.  Only takes one when coalescing is enabled and rc has no acknowledgment of its
+     *  own to piggyback, since the peer drops a message that does not acknowledge the one its exchange awaits.
+     *
+     *  @retval true if ackMessageCounter was set to the acknowledgment taken.
+     */
+    bool TakeCoalescedAck(const SessionHandle & session, ReliableMessageContext * rc, uint32_t & ackMessageCounter);
+
+    /**
+     *  Enable or disable retransmission timeouts derived from the round-trip time measured on each session.
+     *
+     *  @see CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+     */
+    void SetAdaptiveRetransTimeoutEnabled(bool enabled) { mAdaptiveRetransTimeout = enabled; }
+
+    bool IsAdaptiveRetransTimeoutEnabled() const { return mAdaptiveRetransTimeout; }
+
+    /**
+     *  The base interval of the retransmission backoff of the messages sent on the session: the active or idle interval
+     *  advertised by the peer, unless adaptive timeouts are enabled.
+     *
+     *  @see RoundTripTimeEstimator::GetRetransBaseTimeout
+     */
+    System::Clock::Timestamp GetRetransBaseTimeout(const SessionHandle & session) const;
+
+    /**
+     *  Set the send window, the number of reliable messages that may be in flight at once on a session, zero to disable it.
+     *
+     *  A reliable message sent while the window of its session is full waits in the send queue of the session, behind the
+     *  messages of the same or higher priority, until an acknowledgment or the failure of a message in flight opens the
+     *  window.  Acknowledgments, which are not reliable messages, are never queued.  Messages already queued when the window
+     *  is changed are sent right away if it allows.  A queued message that fails to send is reported to its exchange as a
+     *  response timeout, if a response was expected.
+     *
+     *  @see CHIP_CONFIG_MRP_SEND_WINDOW
+     */
+    void SetSendWindow(uint8_t window);
+
+    uint8_t GetSendWindow() const { return mSendWindow; }
+
+    /**
+     *  Whether a reliable message of the given priority must be queued rather than sent on the session.
+     */
+    bool ShouldQueueMessage(const SessionHandle & session, SendPriority priority);
+
+    /**
+     *  Add a reliable message to the retransmission table, queued until the send window of its session opens.  The message
+     *  gets its acknowledgment, if any pending, and is prepared once sent.
+     *
+     *  @retval  #CHIP_ERROR_RETRANS_TABLE_FULL If there is no empty slot left in the table for addition.
+     *  @retval  #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR QueueMessage(ReliableMessageContext * rc, const PayloadHeader & payloadHeader, System::PacketBufferHandle && message,
+                            SendPriority priority);
+
+    const SendQueueStats & GetSendQueueStats() const { return mSendQueueStats; }
+    void ResetSendQueueStats() { mSendQueueStats = SendQueueStats(); }
+
     /**
      * Map a send error code to the error code we should actually use for
      * success checks.  This maps some error codes to CHIP_NO_ERROR as
@@ -194,6 +318,7 @@ public:
 #if CHIP_CONFIG_TEST
     // Functions for testing
     int TestGetCountRetransTable();
+    int TestGetCountHeldAcks();
 
     // Enumerate the retransmission table.  Clearing an entry while enumerating
     // that entry is allowed.  F must take a RetransTableEntry as an argument
@@ -219,10 +344,39 @@ private:
         });
     }
 
+    // Acknowledgment held for a closed exchange.
+    struct HeldAck
+    {
+        HeldAck(ExchangeManager * exchangeMgr, const SessionHandle & session, uint16_t exchangeId, bool isInitiator,
+                uint32_t messageCounter, System::Clock::Timestamp ackTime) :
+            exchangeMgr(exchangeMgr),
+            session(session), exchangeId(exchangeId), isInitiator(isInitiator), messageCounter(messageCounter), ackTime(ackTime)
+        {}
+
+        ExchangeManager * exchangeMgr;
+        SessionHolder session;
+        uint16_t exchangeId;
+        bool isInitiator;
+        uint32_t messageCounter;
+        System::Clock::Timestamp ackTime;
+    };
+
     void TicklessDebugDumpRetransTable(const char * log);
+    void SendHeldAck(HeldAck & heldAck);
+    bool IsSendWindowOpen(const SessionHandle & session);
+    void SendQueuedMessages();
+    CHIP_ERROR SendQueuedMessage(RetransTableEntry * entry);
 
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
+    ObjectPool<HeldAck, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mHeldAcks;
+    System::Clock::Timeout mAckCoalescingWindow;
+    bool mAdaptiveRetransTimeout;
+
+    uint8_t mSendWindow;
+    uint32_t mSendQueueSequence = 0;
+    bool mSendQueueReady        = false; // Set when queued messages may be sent, e.g. a message in flight was cleared.
+    SendQueueStats mSendQueueStats;
 
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 };
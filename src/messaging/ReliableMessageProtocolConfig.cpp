@@ -27,6 +27,8 @@
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemClock.h>
 
+#include <algorithm>
+
 namespace chip {
 
 using namespace System::Clock::Literals;
@@ -88,6 +90,71 @@ Optional<ReliableMessageProtocolConfig> GetLocalMRPConfig()
                                              : Optional<ReliableMessageProtocolConfig>::Value(config);
 }
 
+void RoundTripTimeEstimator::AddSample(System::Clock::Milliseconds32 roundTripTime, System::Clock::Timestamp now)
+{
+    // Bounding the samples keeps the scaled values from overflowing.
+    uint32_t sample = std::min(roundTripTime, System::Clock::Milliseconds32(CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL)).count();
+
+    if (mSampleCount == 0)
+    {
+        // SRTT = R, RTTVAR = R / 2
+        mScaledSmoothedRoundTripTime  = sample << 3;
+        mScaledRoundTripTimeVariation = sample << 1;
+    }
+    else
+    {
+        uint32_t smoothedRoundTripTime = mScaledSmoothedRoundTripTime >> 3;
+        uint32_t error = (sample > smoothedRoundTripTime) ? sample - smoothedRoundTripTime : smoothedRoundTripTime - sample;
+
+        // RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R|, then SRTT = 7/8 * SRTT + 1/8 * R
+        mScaledRoundTripTimeVariation = mScaledRoundTripTimeVariation - (mScaledRoundTripTimeVariation >> 2) + error;
+        mScaledSmoothedRoundTripTime  = mScaledSmoothedRoundTripTime - (mScaledSmoothedRoundTripTime >> 3) + sample;
+    }
+
+    if (mSampleCount < UINT32_MAX)
+    {
+        mSampleCount++;
+    }
+    mLastSampleTime = now;
+    mBackoffShift   = 0;
+}
+
+System::Clock::Milliseconds32 RoundTripTimeEstimator::GetSmoothedRoundTripTime() const
+{
+    return System::Clock::Milliseconds32(mScaledSmoothedRoundTripTime >> 3);
+}
+
+System::Clock::Milliseconds32 RoundTripTimeEstimator::GetRoundTripTimeVariation() const
+{
+    return System::Clock::Milliseconds32(mScaledRoundTripTimeVariation >> 2);
+}
+
+void RoundTripTimeEstimator::OnRetransmission()
+{
+    if (mBackoffShift < kMaxBackoffShift)
+    {
+        mBackoffShift++;
+    }
+}
+
+System::Clock::Timestamp RoundTripTimeEstimator::GetRetransBaseTimeout(System::Clock::Timestamp advertisedInterval,
+                                                                       System::Clock::Timestamp now,
+                                                                       System::Clock::Timestamp activityThreshold) const
+{
+    System::Clock::Timestamp maxTimeout = System::Clock::Timestamp(CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL);
+    System::Clock::Timestamp timeout    = advertisedInterval;
+    if (HasEstimate() && now - mLastSampleTime < activityThreshold)
+    {
+        // RTO = SRTT + 4 * RTTVAR
+        timeout = System::Clock::Timestamp(GetSmoothedRoundTripTime().count() + mScaledRoundTripTimeVariation);
+        timeout = std::min(std::max(timeout, System::Clock::Timestamp(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL)), maxTimeout);
+    }
+
+    // The backoff never brings the timeout below the advertised interval.
+    timeout = timeout * (1u << mBackoffShift);
+    return std::min(timeout, std::max(advertisedInterval, maxTimeout));
+}
+
 System::Clock::Timestamp GetRetransmissionTimeout(System::Clock::Timestamp activeInterval, System::Clock::Timestamp idleInterval,
                                                   System::Clock::Timestamp lastActivityTime,
                                                   System::Clock::Timestamp activityThreshold)
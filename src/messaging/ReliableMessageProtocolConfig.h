@@ -94,6 +94,29 @@ namespace chip {
 #define CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT (200_ms32)
 #endif // CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT
 
+/**
+ *  @def CHIP_CONFIG_RMP_ACK_COALESCING_WINDOW
+ *
+ *  @brief
+ *    The default acknowledgment coalescing window, zero to disable coalescing.
+ *
+ *  When coalescing, the acknowledgments pending on a session, including those of
+ *  closed exchanges, are held for up to the window and piggybacked on the next
+ *  message sent on the session, whatever its exchange.  The window replaces the
+ *  acknowledgment timeout, so it must stay below the retransmission timeout of
+ *  the peers.
+ *
+ *  Acknowledgments carried by another exchange are not part of the Matter
+ *  specification, and only nodes with coalescing enabled accept them: only
+ *  enable it when every peer is a node built from this SDK with coalescing
+ *  enabled too.
+ *
+ *  @see ReliableMessageMgr::SetAckCoalescingWindow
+ */
+#ifndef CHIP_CONFIG_RMP_ACK_COALESCING_WINDOW
+#define CHIP_CONFIG_RMP_ACK_COALESCING_WINDOW (0_ms32)
+#endif // CHIP_CONFIG_RMP_ACK_COALESCING_WINDOW
+
 /**
  *  @def CHIP_CONFIG_RESOLVE_PEER_ON_FIRST_TRANSMIT_FAILURE
  *
@@ -165,6 +188,66 @@ namespace chip {
 #endif
 #endif // CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST && !CHIP_DEVICE_LAYER_TARGET_LINUX
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    Should the retransmission timeout of a session be derived from the round-trip
+ *    time measured on it, rather than from the retry intervals advertised by the peer.
+ *
+ *  The round-trip time is measured from the acknowledgments of the messages that
+ *  were not retransmitted, and smoothed as specified by RFC 6298.  The adaptive
+ *  timeout only applies while the peer is perceived as active, and only once a
+ *  round-trip time was measured: the advertised intervals are used otherwise.
+ *
+ *  @see ReliableMessageMgr::SetAdaptiveRetransTimeoutEnabled
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT 0
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+ *
+ *  @brief
+ *    The lower bound of the adaptive retransmission timeout.
+ *
+ *  The default value stays above the standalone acknowledgment timeout of the peer,
+ *  so that an acknowledgment the peer holds in the hope of piggybacking it does not
+ *  cause a spurious retransmission.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL (250_ms32)
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL
+ *
+ *  @brief
+ *    The upper bound of the adaptive retransmission timeout.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL (5000_ms32)
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL
+
+/**
+ *  @def CHIP_CONFIG_MRP_SEND_WINDOW
+ *
+ *  @brief
+ *    The default number of reliable messages that may be in flight at once on a
+ *    session, zero to send the messages without limit.
+ *
+ *  Bounding the messages in flight to a peer keeps a burst of messages from
+ *  overflowing the queues of the network, e.g. of a Thread border router, which
+ *  would cause retransmissions and make matters worse.  The messages past the
+ *  window wait in a send queue of the session.
+ *
+ *  @see ReliableMessageMgr::SetSendWindow
+ */
+#ifndef CHIP_CONFIG_MRP_SEND_WINDOW
+#define CHIP_CONFIG_MRP_SEND_WINDOW 0
+#endif // CHIP_CONFIG_MRP_SEND_WINDOW
+
 /**
  *  @brief
  *    The ReliableMessageProtocol configuration.
@@ -187,6 +270,67 @@ struct ReliableMessageProtocolConfig
     }
 };
 
+/**
+ *  @brief
+ *    Estimates the round-trip time of a session from the acknowledgments of its messages.
+ *
+ *  The smoothed round-trip time (SRTT) and its variation (RTTVAR) are computed as
+ *  specified by RFC 6298, and give a retransmission timeout of SRTT + 4 * RTTVAR,
+ *  bounded by CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL and
+ *  CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL.
+ *
+ *  Following Karn's algorithm, the round-trip time of retransmitted messages, whose
+ *  acknowledgments are ambiguous, must not be sampled.  Instead, the timeout backed
+ *  off by a retransmission is kept for the next messages until a sample is taken, so
+ *  that a timeout too short to ever sample a round trip still adapts.
+ */
+class RoundTripTimeEstimator
+{
+public:
+    /**
+     *  Add the round-trip time of a message that was not retransmitted, measured at the given time.
+     */
+    void AddSample(System::Clock::Milliseconds32 roundTripTime, System::Clock::Timestamp now);
+
+    /**
+     *  Back off the timeout, when a message is retransmitted for the first time.
+     */
+    void OnRetransmission();
+
+    bool HasEstimate() const { return mSampleCount > 0; }
+
+    /// The number of samples taken since the last Reset.
+    uint32_t GetSampleCount() const { return mSampleCount; }
+
+    System::Clock::Milliseconds32 GetSmoothedRoundTripTime() const;
+    System::Clock::Milliseconds32 GetRoundTripTimeVariation() const;
+
+    /**
+     *  The base interval of the retransmission backoff, that is the timeout derived from the round-trip time if the last
+     *  sample was taken less than activityThreshold ago, otherwise the advertised interval, backed off by the
+     *  retransmissions since the last sample.
+     *
+     *  @param[in] advertisedInterval  The active or idle interval advertised by the peer.
+     *  @param[in] now                 The current time.
+     *  @param[in] activityThreshold   The activity threshold for the peer to be considered active.  Since acknowledgments
+     *                                 are activity of the peer, the round-trip time is stale past it.
+     */
+    System::Clock::Timestamp GetRetransBaseTimeout(System::Clock::Timestamp advertisedInterval, System::Clock::Timestamp now,
+                                                   System::Clock::Timestamp activityThreshold) const;
+
+    void Reset() { *this = RoundTripTimeEstimator(); }
+
+private:
+    static constexpr uint8_t kMaxBackoffShift = 4;
+
+    // Scaled by 8 and 4 respectively, so that the gains of 1/8 and 1/4 keep the precision of the samples.
+    uint32_t mScaledSmoothedRoundTripTime    = 0;
+    uint32_t mScaledRoundTripTimeVariation   = 0;
+    uint32_t mSampleCount                    = 0;
+    System::Clock::Timestamp mLastSampleTime = System::Clock::kZero;
+    uint8_t mBackoffShift                    = 0;
+};
+
 /// @brief The default MRP config. The value is defined by spec, and shall be same for all implementations,
 ReliableMessageProtocolConfig GetDefaultMRPConfig();
 
@@ -259,6 +259,57 @@ void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+void CheckUmhDispatch(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate mockSolicitedAppDelegate;
+    MockAppDelegate mockProtocolAppDelegate;
+    MockAppDelegate mockTypeAppDelegate;
+    MockAppDelegate mockOtherProtocolAppDelegate;
+
+    // Register in an order different from the dispatch order.
+    err =
+        ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &mockTypeAppDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Echo::Id, &mockOtherProtocolAppDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &mockProtocolAppDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The handler for the message type is preferred over the one for the protocol.
+    ExchangeContext * ec1 = ctx.NewExchangeToAlice(&mockSolicitedAppDelegate);
+    ec1->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                     SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, mockTypeAppDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !mockProtocolAppDelegate.IsOnMessageReceivedCalled);
+
+    // Other message types of the protocol go to the handler for the protocol.
+    ec1 = ctx.NewExchangeToAlice(&mockSolicitedAppDelegate);
+    ec1->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                     SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, mockProtocolAppDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !mockOtherProtocolAppDelegate.IsOnMessageReceivedCalled);
+
+    // Once unregistered, messages of that type go to the handler for the protocol as well.
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    mockProtocolAppDelegate.IsOnMessageReceivedCalled = false;
+    ec1 = ctx.NewExchangeToAlice(&mockSolicitedAppDelegate);
+    ec1->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                     SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, mockProtocolAppDelegate.IsOnMessageReceivedCalled);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::Echo::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
 // Test Suite
 
 /**
@@ -270,6 +321,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test ExchangeMgr::CheckUmhDispatch",         CheckUmhDispatch),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
     NL_TEST_DEF("Test session eviction in timeout handling",  CheckSessionExpirationDuringTimeout),
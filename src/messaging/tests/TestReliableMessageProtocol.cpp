@@ -107,7 +107,7 @@ public:
         return CHIP_NO_ERROR;
     }
 
-    void OnResponseTimeout(ExchangeContext * ec) override {}
+    void OnResponseTimeout(ExchangeContext * ec) override { mResponseTimedOut = true; }
 
     void CloseExchangeIfNeeded()
     {
@@ -122,6 +122,7 @@ public:
     bool mReceivedPiggybackAck     = false;
     bool mDropAckResponse          = false;
     bool mRetainExchange           = false;
+    bool mResponseTimedOut         = false;
     ExchangeContext * mExchange    = nullptr;
     nlTestSuite * mTestSuite       = nullptr;
 };
@@ -1643,6 +1644,296 @@ void CheckLostStandaloneAck(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
 }
 
+void CheckAckCoalescing(nlTestSuite * inSuite, void * inContext)
+{
+    /**
+     * This tests the following scenario, without and then with ack coalescing:
+     * 1) The initiator sends kReports reliable messages, on as many exchanges, which the responder closes.
+     * 2) The responder sends kRequests < kReports reliable messages of its own, on as many new exchanges.
+     *
+     * Without coalescing, every message is acked by a standalone ack.  With coalescing, the responder piggybacks the acks
+     * held for its closed exchanges on its own messages, and only the remaining acks are sent standalone.
+     */
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr uint32_t kReports  = 8;
+    constexpr uint32_t kRequests = 4;
+
+    MockAppDelegate mockReceiver;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    mockReceiver.mTestSuite = inSuite;
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    // Ensure the retransmit table is empty right now
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    auto & loopback = ctx.GetLoopback();
+    uint32_t sentMessageCount[2];
+
+    const System::Clock::Timeout windows[] = { System::Clock::kZero, CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT };
+    for (size_t i = 0; i < ArraySize(windows); i++)
+    {
+        rm->SetAckCoalescingWindow(windows[i]);
+        loopback.mSentMessageCount = 0;
+
+        MockAppDelegate mockSender;
+        for (uint32_t j = 0; j < kReports; j++)
+        {
+            ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+            NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+            chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+            NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+            err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+        ctx.DrainAndServiceIO();
+
+        for (uint32_t j = 0; j < kRequests; j++)
+        {
+            ExchangeContext * exchange = ctx.NewExchangeToBob(&mockSender);
+            NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+            chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+            NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+            err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+        ctx.DrainAndServiceIO();
+
+        // Wait for the acks that were not piggybacked to be sent.
+        const uint32_t expectedCount = 2 * kReports + (rm->IsAckCoalescingEnabled() ? kRequests : 2 * kRequests);
+        ctx.GetIOContext().DriveIOUntil(1000_ms32, [&] {
+            return rm->TestGetCountRetransTable() == 0 && rm->TestGetCountHeldAcks() == 0 &&
+                loopback.mSentMessageCount >= expectedCount;
+        });
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+        NL_TEST_ASSERT(inSuite, rm->TestGetCountHeldAcks() == 0);
+        NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == expectedCount);
+        sentMessageCount[i] = loopback.mSentMessageCount;
+    }
+
+    // Every message the responder sent saved a standalone ack.
+    ChipLogProgress(Test, "Ack coalescing: %" PRIu32 " packets sent instead of %" PRIu32, sentMessageCount[1], sentMessageCount[0]);
+    NL_TEST_ASSERT(inSuite, sentMessageCount[0] - sentMessageCount[1] == kRequests);
+
+    rm->SetAckCoalescingWindow(System::Clock::kZero);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+void CheckRoundTripTimeSampling(nlTestSuite * inSuite, void * inContext)
+{
+    /**
+     * This tests that the acknowledgment of a message sent once gives a round-trip time sample, while the acknowledgment of a
+     * retransmitted message, which can't tell which transmission it acknowledges, does not.
+     */
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockReceiver;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    mockReceiver.mTestSuite = inSuite;
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    RoundTripTimeEstimator & roundTripTime = ctx.GetSessionBobToAlice()->GetRoundTripTimeEstimator();
+    roundTripTime.Reset();
+
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+
+    MockAppDelegate mockSender;
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    // Ensure the message and its standalone ack were sent, and the round trip sampled.
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 2);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, roundTripTime.GetSampleCount() == 1);
+
+    // Now drop the initial transmission of the next message.
+    loopback.mNumMessagesToDrop = 1;
+
+    exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+
+    // Wait for the retransmission to be acknowledged.
+    ctx.GetIOContext().DriveIOUntil(1000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 5);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, roundTripTime.GetSampleCount() == 1);
+
+    roundTripTime.Reset();
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+void CheckSendWindow(nlTestSuite * inSuite, void * inContext)
+{
+    /**
+     * This tests that with a send window of one message, reliable messages sent on several exchanges of a session are queued
+     * while a message is in flight, and sent, in order, as the acknowledgments open the window.
+     */
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr uint32_t kMessages = 3;
+
+    MockAppDelegate mockReceiver;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    mockReceiver.mTestSuite = inSuite;
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    // Ensure the retransmit table is empty right now
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    auto & loopback            = ctx.GetLoopback();
+    loopback.mSentMessageCount = 0;
+
+    rm->SetSendWindow(1);
+    rm->ResetSendQueueStats();
+
+    MockAppDelegate mockSender;
+    for (uint32_t i = 0; i < kMessages; i++)
+    {
+        ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+        NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    // Only the first message is in flight, the others wait in the retransmit table.
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == kMessages);
+
+    // Every message is sent, then acknowledged by a standalone ack.
+    ctx.GetIOContext().DriveIOUntil(1000_ms32, [&] {
+        return rm->TestGetCountRetransTable() == 0 && loopback.mSentMessageCount >= 2 * kMessages;
+    });
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 2 * kMessages);
+    NL_TEST_ASSERT(inSuite, rm->GetSendQueueStats().mSentMessages == kMessages);
+    NL_TEST_ASSERT(inSuite, rm->GetSendQueueStats().mQueuedMessages == kMessages - 1);
+
+    rm->SetSendWindow(0);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+void CheckQueuedSendFailure(nlTestSuite * inSuite, void * inContext)
+{
+    /**
+     * This tests that widening the send window sends the queued messages right away, and that a queued message that fails to
+     * send times out the response expected by its exchange.
+     */
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockReceiver;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    mockReceiver.mTestSuite = inSuite;
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    // Ensure the retransmit table is empty right now
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 1;
+    loopback.mDroppedMessageCount = 0;
+
+    rm->SetSendWindow(1);
+
+    // The first message is dropped, so it stays in flight until retransmitted, and the second one is queued.
+    MockAppDelegate mockSender;
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    // Retransmit late enough for the queued message to be sent, when the window widens, before the timer would wake anyway.
+    exchange->GetSessionHandle()->AsSecureSession()->SetRemoteMRPConfig({
+        System::Clock::Timestamp(1000), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(1000), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    });
+
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockAppDelegate mockQueuedSender;
+    exchange = ctx.NewExchangeToAlice(&mockQueuedSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+    buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer), SendMessageFlags::kExpectResponse);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 2);
+
+    // Widening the window sends the queued message without waiting for the retransmission, and its failure times out the
+    // response right away.
+    loopback.mMessageSendError = CHIP_ERROR_NOT_CONNECTED;
+    rm->SetSendWindow(2);
+    ctx.GetIOContext().DriveIOUntil(100_ms32, [&] { return mockQueuedSender.mResponseTimedOut; });
+
+    NL_TEST_ASSERT(inSuite, mockQueuedSender.mResponseTimedOut);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+
+    // The first message is retransmitted and acknowledged.
+    loopback.mMessageSendError = CHIP_NO_ERROR;
+    ctx.GetIOContext().DriveIOUntil(3000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, !mockSender.mResponseTimedOut);
+
+    rm->SetSendWindow(0);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
 void CheckGetBackoff(nlTestSuite * inSuite, void * inContext)
 {
     // Run 3x iterations to thoroughly test random jitter always results in backoff within bounds.
@@ -1708,6 +1999,10 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test that unencrypted message is dropped if exchange requires encryption", CheckUnencryptedMessageReceiveFailure),
     NL_TEST_DEF("Test that dropping an application-level message with a piggyback ack works ok once both sides retransmit", CheckLostResponseWithPiggyback),
     NL_TEST_DEF("Test that an application-level response-to-response after a lost standalone ack to the initial message works", CheckLostStandaloneAck),
+    NL_TEST_DEF("Test that closed exchanges hold their acks for other exchanges of the session to piggyback", CheckAckCoalescing),
+    NL_TEST_DEF("Test that only the acks of messages sent once give round-trip time samples", CheckRoundTripTimeSampling),
+    NL_TEST_DEF("Test that a full send window queues reliable messages until acknowledgments open it", CheckSendWindow),
+    NL_TEST_DEF("Test that a queued message that fails to send times out the response of its exchange", CheckQueuedSendFailure),
     NL_TEST_DEF("Test MRP backoff algorithm", CheckGetBackoff),
 
     NL_TEST_SENTINEL()
@@ -0,0 +1,298 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the RoundTripTimeEstimator, including a
+ *      simulation of the retransmissions of messages over lossy links.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/ReliableMessageProtocolConfig.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <inttypes.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::System::Clock::Literals;
+
+constexpr System::Clock::Timestamp kActivityThreshold = 4000_ms64;
+
+void CheckFirstSample(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+    NL_TEST_ASSERT(inSuite, !estimator.HasEstimate());
+
+    // Without samples, the advertised interval is used.
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) == 300_ms64);
+
+    // SRTT = R, RTTVAR = R / 2, RTO = SRTT + 4 * RTTVAR
+    estimator.AddSample(100_ms32, 1000_ms64);
+    NL_TEST_ASSERT(inSuite, estimator.HasEstimate());
+    NL_TEST_ASSERT(inSuite, estimator.GetSampleCount() == 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRoundTripTime() == 100_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRoundTripTimeVariation() == 50_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 1000_ms64, kActivityThreshold) == 300_ms64);
+
+    estimator.Reset();
+    NL_TEST_ASSERT(inSuite, !estimator.HasEstimate());
+}
+
+void CheckConvergence(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+    System::Clock::Timestamp now = 0_ms64;
+
+    estimator.AddSample(1000_ms32, now);
+    for (int i = 0; i < 64; i++)
+    {
+        now += 100_ms64;
+        estimator.AddSample(600_ms32, now);
+    }
+
+    // SRTT = 7/8 * SRTT + 1/8 * R converges to R, and RTTVAR to 0.
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRoundTripTime() >= 600_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRoundTripTime() <= 610_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRoundTripTimeVariation() <= 10_ms32);
+
+    System::Clock::Timestamp timeout = estimator.GetRetransBaseTimeout(300_ms64, now, kActivityThreshold);
+    NL_TEST_ASSERT(inSuite, timeout >= 600_ms64);
+    NL_TEST_ASSERT(inSuite, timeout <= 650_ms64);
+}
+
+void CheckBounds(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+
+    estimator.AddSample(1_ms32, 0_ms64);
+    NL_TEST_ASSERT(inSuite,
+                   estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) ==
+                       System::Clock::Timestamp(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL));
+
+    estimator.Reset();
+    estimator.AddSample(System::Clock::Milliseconds32(UINT32_MAX), 0_ms64);
+    NL_TEST_ASSERT(inSuite,
+                   estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) ==
+                       System::Clock::Timestamp(CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL));
+
+    // A stale round-trip time gives way to the advertised interval.
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, kActivityThreshold, kActivityThreshold) == 300_ms64);
+}
+
+void CheckBackoffRetention(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+
+    // The backoff applies to the advertised interval until a sample is taken...
+    estimator.OnRetransmission();
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) == 600_ms64);
+    estimator.OnRetransmission();
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) == 1200_ms64);
+
+    // ... is bounded...
+    for (int i = 0; i < 16; i++)
+    {
+        estimator.OnRetransmission();
+    }
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) == 4800_ms64);
+    NL_TEST_ASSERT(inSuite,
+                   estimator.GetRetransBaseTimeout(600_ms64, 0_ms64, kActivityThreshold) ==
+                       System::Clock::Timestamp(CHIP_CONFIG_MRP_ADAPTIVE_MAX_RETRY_INTERVAL));
+
+    // ... and is reset by the next sample.
+    estimator.AddSample(400_ms32, 0_ms64);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransBaseTimeout(300_ms64, 0_ms64, kActivityThreshold) == 1200_ms64);
+}
+
+/**
+ *  A link dropping a message or its acknowledgment with the given probability, and otherwise delivering the acknowledgment
+ *  after a round-trip time uniformly distributed in the given range.
+ */
+struct LossyLink
+{
+    uint32_t minRoundTripTimeMs;
+    uint32_t maxRoundTripTimeMs;
+    uint32_t lossPercent;
+};
+
+struct SimulationResult
+{
+    uint32_t delivered               = 0;
+    uint32_t failed                  = 0;
+    uint32_t retransmissions         = 0;
+    uint32_t spuriousRetransmissions = 0; ///< Retransmissions of messages whose acknowledgment was on its way.
+    uint64_t totalLatencyMs          = 0;
+
+    uint64_t MeanLatencyMs() const { return delivered ? totalLatencyMs / delivered : 0; }
+};
+
+/**
+ *  Send messages one after the other over the link, retransmitting them as the reliable message manager does, with
+ *  the backoff of GetBackoff (without its jitter, so that the simulation is deterministic) and the base interval of either
+ *  the advertised interval or the round-trip time estimator.
+ */
+SimulationResult SimulateLink(const LossyLink & link, bool adaptive, uint32_t messageCount)
+{
+    constexpr System::Clock::Timestamp kAdvertisedInterval = 300_ms64;
+
+    SimulationResult result;
+    RoundTripTimeEstimator estimator;
+    System::Clock::Timestamp now = 0_ms64;
+
+    // Park-Miller generator, so that both timeout policies see the same link.
+    uint32_t seed = 1;
+    auto random   = [&seed](uint32_t range) {
+        seed = static_cast<uint32_t>((static_cast<uint64_t>(seed) * 48271) % 2147483647);
+        return seed % range;
+    };
+
+    for (uint32_t i = 0; i < messageCount; i++)
+    {
+        System::Clock::Timestamp firstSendTime = now;
+        System::Clock::Timestamp sendTime      = now;
+        System::Clock::Timestamp ackTime       = System::Clock::Timestamp::max();
+        System::Clock::Timestamp retransTime;
+        uint8_t sendCount = 0;
+
+        while (true)
+        {
+            bool lost                = random(100) < link.lossPercent;
+            uint32_t roundTripTimeMs = link.minRoundTripTimeMs + random(link.maxRoundTripTimeMs - link.minRoundTripTimeMs + 1);
+            if (!lost)
+            {
+                ackTime = std::min(ackTime, sendTime + System::Clock::Milliseconds32(roundTripTimeMs));
+            }
+
+            System::Clock::Timestamp baseTimeout =
+                adaptive ? estimator.GetRetransBaseTimeout(kAdvertisedInterval, sendTime, kActivityThreshold) : kAdvertisedInterval;
+            retransTime = sendTime + ReliableMessageMgr::GetBackoff(baseTimeout, sendCount, /* computeMaxPossible */ true);
+            if (sendCount == 1)
+            {
+                estimator.OnRetransmission();
+            }
+            if (ackTime <= retransTime || sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+            {
+                break;
+            }
+
+            result.retransmissions++;
+            if (ackTime != System::Clock::Timestamp::max())
+            {
+                result.spuriousRetransmissions++;
+            }
+            sendTime = retransTime;
+            sendCount++;
+        }
+
+        if (ackTime <= retransTime)
+        {
+            result.delivered++;
+            result.totalLatencyMs += (ackTime - firstSendTime).count();
+            if (sendCount == 0)
+            {
+                estimator.AddSample(std::chrono::duration_cast<System::Clock::Milliseconds32>(ackTime - firstSendTime), ackTime);
+            }
+            now = ackTime;
+        }
+        else
+        {
+            result.failed++;
+            now = retransTime;
+        }
+    }
+
+    return result;
+}
+
+void LogSimulation(const char * name, const SimulationResult & fixed, const SimulationResult & adaptive)
+{
+    ChipLogProgress(Test,
+                    "%s: mean latency %" PRIu32 "ms -> %" PRIu32 "ms, retransmissions %" PRIu32 " -> %" PRIu32
+                    " (spurious %" PRIu32 " -> %" PRIu32 "), failures %" PRIu32 " -> %" PRIu32,
+                    name, static_cast<uint32_t>(fixed.MeanLatencyMs()), static_cast<uint32_t>(adaptive.MeanLatencyMs()),
+                    fixed.retransmissions, adaptive.retransmissions, fixed.spuriousRetransmissions,
+                    adaptive.spuriousRetransmissions, fixed.failed, adaptive.failed);
+}
+
+void CheckFastLossyLink(nlTestSuite * inSuite, void * inContext)
+{
+    // A Wi-Fi or Ethernet link, where the advertised intervals are far above the round-trip time.
+    constexpr LossyLink kLink = { 10, 40, 10 };
+
+    SimulationResult fixed    = SimulateLink(kLink, false, 1000);
+    SimulationResult adaptive = SimulateLink(kLink, true, 1000);
+    LogSimulation("Fast lossy link", fixed, adaptive);
+
+    // Losses are recovered from sooner.
+    NL_TEST_ASSERT(inSuite, adaptive.MeanLatencyMs() < fixed.MeanLatencyMs());
+    NL_TEST_ASSERT(inSuite, adaptive.spuriousRetransmissions == 0);
+    NL_TEST_ASSERT(inSuite, adaptive.failed <= fixed.failed);
+}
+
+void CheckSlowLossyLink(nlTestSuite * inSuite, void * inContext)
+{
+    // A congested Thread mesh, where the round-trip time is far above the advertised intervals.
+    constexpr LossyLink kLink = { 500, 1500, 5 };
+
+    SimulationResult fixed    = SimulateLink(kLink, false, 1000);
+    SimulationResult adaptive = SimulateLink(kLink, true, 1000);
+    LogSimulation("Slow lossy link", fixed, adaptive);
+
+    // The messages are no longer all retransmitted while their acknowledgments are on their way.
+    NL_TEST_ASSERT(inSuite, adaptive.spuriousRetransmissions * 4 < fixed.spuriousRetransmissions);
+    NL_TEST_ASSERT(inSuite, adaptive.retransmissions < fixed.retransmissions);
+    NL_TEST_ASSERT(inSuite, adaptive.failed <= fixed.failed);
+}
+
+} // namespace
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("First sample",                                CheckFirstSample),
+    NL_TEST_DEF("Convergence",                                 CheckConvergence),
+    NL_TEST_DEF("Timeout bounds",                              CheckBounds),
+    NL_TEST_DEF("Backoff retention",                           CheckBackoffRetention),
+    NL_TEST_DEF("Simulation of a fast lossy link",             CheckFastLossyLink),
+    NL_TEST_DEF("Simulation of a slow lossy link",             CheckSlowLossyLink),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Main
+ */
+int TestRoundTripTimeEstimator()
+{
+    nlTestSuite theSuite = { "Messaging-TestRoundTripTimeEstimator", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRoundTripTimeEstimator);
@@ -24,31 +24,125 @@
 
 #include <platform/DeviceSafeQueue.h>
 
+#include <lib/support/CodeUtils.h>
+
 namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
+DeviceSafeQueue::DeviceSafeQueue()
+{
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    for (size_t i = 0; i < kRingSize; i++)
+    {
+        mRing[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+}
+
 void DeviceSafeQueue::Push(const ChipDeviceEvent & event)
 {
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    // Once a message has spilled into the mutex-protected queue, the following ones have to go there as well until the
+    // consumer has drained it, so that they are not popped before it.
+    if (!mOverflowing.load(std::memory_order_acquire) && TryPushToRing(event))
+    {
+        return;
+    }
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+
     std::unique_lock<std::mutex> lock(mEventQueueLock);
     mEventQueue.push(event);
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    mOverflowing.store(true, std::memory_order_release);
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
 }
 
 bool DeviceSafeQueue::Empty()
 {
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    const Cell & cell = mRing[mPopPosition & (kRingSize - 1)];
+    if (cell.mSequence.load(std::memory_order_acquire) == mPopPosition + 1)
+    {
+        return false;
+    }
+    return mPushPosition.load(std::memory_order_acquire) != mPopPosition || !mOverflowing.load(std::memory_order_acquire);
+#else  // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
     std::unique_lock<std::mutex> lock(mEventQueueLock);
     return mEventQueue.empty();
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
 }
 
-ChipDeviceEvent DeviceSafeQueue::PopFront()
+bool DeviceSafeQueue::TryPopFront(ChipDeviceEvent & event)
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    if (TryPopFromRing(event))
+    {
+        return true;
+    }
+
+    // The messages still being pushed to the ring were pushed before the ones in the mutex-protected queue.
+    if (mPushPosition.load(std::memory_order_acquire) != mPopPosition || !mOverflowing.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
 
-    const ChipDeviceEvent event = mEventQueue.front();
+    std::unique_lock<std::mutex> lock(mEventQueueLock);
+    VerifyOrReturnValue(!mEventQueue.empty(), false);
+    event = mEventQueue.front();
     mEventQueue.pop();
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    if (mEventQueue.empty())
+    {
+        mOverflowing.store(false, std::memory_order_release);
+    }
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    return true;
+}
+
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+bool DeviceSafeQueue::TryPushToRing(const ChipDeviceEvent & event)
+{
+    size_t position = mPushPosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell & cell           = mRing[position & (kRingSize - 1)];
+        const size_t sequence = cell.mSequence.load(std::memory_order_acquire);
+        if (sequence == position)
+        {
+            // The cell is free, claim it.  On failure, position is updated to the current push position.
+            if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.mEvent = event;
+                cell.mSequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (sequence < position)
+        {
+            // The cell still holds the message pushed one lap earlier: the ring is full.
+            return false;
+        }
+        else
+        {
+            position = mPushPosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool DeviceSafeQueue::TryPopFromRing(ChipDeviceEvent & event)
+{
+    Cell & cell = mRing[mPopPosition & (kRingSize - 1)];
+    VerifyOrReturnValue(cell.mSequence.load(std::memory_order_acquire) == mPopPosition + 1, false);
 
-    return event;
+    event = cell.mEvent;
+    // Free the cell for the push one lap later.
+    cell.mSequence.store(mPopPosition + kRingSize, std::memory_order_release);
+    mPopPosition++;
+    return true;
 }
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
 
 } // namespace Internal
 } // namespace DeviceLayer
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <queue>
 
@@ -43,18 +44,50 @@ namespace Internal {
  *      is used by the CHIP event loop to hold incoming messages. Each message is sequentially dequeued, decoded,
  *      and then an action is performed.
  *
+ *      Messages can be pushed from any number of threads, but only the CHIP event loop pops them. If
+ *      CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE is set, they are first held in a bounded lock-free ring; only once the
+ *      ring is full do messages spill into the mutex-protected queue, which preserves the order of the messages pushed
+ *      by each thread.
+ *
  */
 class DeviceSafeQueue
 {
 public:
-    DeviceSafeQueue()  = default;
+    DeviceSafeQueue();
     ~DeviceSafeQueue() = default;
 
     void Push(const ChipDeviceEvent & event);
+
+    /*
+     * Only to be called by the consumer.  A message being pushed concurrently might not be visible yet, the thread pushing
+     * it is expected to wake the consumer up once it is pushed.
+     */
     bool Empty();
-    ChipDeviceEvent PopFront();
+    bool TryPopFront(ChipDeviceEvent & event);
 
 private:
+#if CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+    static constexpr size_t kRingSize = CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE;
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "The event queue ring size must be a power of two");
+
+    struct Cell
+    {
+        // Equal to the position of the cell when it is free for that position, to the position + 1 once it holds the
+        // message pushed at that position.
+        std::atomic<size_t> mSequence;
+        ChipDeviceEvent mEvent;
+    };
+
+    bool TryPushToRing(const ChipDeviceEvent & event);
+    bool TryPopFromRing(ChipDeviceEvent & event);
+
+    Cell mRing[kRingSize];
+    std::atomic<size_t> mPushPosition{ 0 };
+    size_t mPopPosition = 0; // Only accessed by the consumer.
+    // Set while messages that spilled from the ring are in mEventQueue.
+    std::atomic<bool> mOverflowing{ false };
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE > 0
+
     std::queue<ChipDeviceEvent> mEventQueue;
     std::mutex mEventQueueLock;
 
@@ -68,6 +68,10 @@
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 1
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+#ifndef CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+#define CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE 256
+#endif // CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
@@ -64,6 +64,22 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+#define CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS 256
+#endif // CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+
+#ifndef CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE 64
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+#define CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE 48
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 128
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
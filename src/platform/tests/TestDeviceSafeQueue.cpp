@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the DeviceSafeQueue.
+ */
+
+#include <platform/DeviceSafeQueue.h>
+
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+ChipDeviceEvent MakeEvent(intptr_t producer, intptr_t sequence)
+{
+    ChipDeviceEvent event;
+    event.Type                    = DeviceEventType::kCallWorkFunct;
+    event.CallWorkFunct.WorkFunct = nullptr;
+    event.CallWorkFunct.Arg       = (producer << 24) | sequence;
+    return event;
+}
+
+void TestSingleProducerOrder(nlTestSuite * inSuite, void * inContext)
+{
+    auto queue = std::make_unique<DeviceSafeQueue>();
+    ChipDeviceEvent event;
+
+    NL_TEST_ASSERT(inSuite, queue->Empty());
+    NL_TEST_ASSERT(inSuite, !queue->TryPopFront(event));
+
+    // Push past the ring size so that events spill into the overflow queue, twice in a row.
+    constexpr intptr_t kEventCount = CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE * 2 + 3;
+    for (int round = 0; round < 2; round++)
+    {
+        for (intptr_t i = 0; i < kEventCount; i++)
+        {
+            queue->Push(MakeEvent(0, i));
+        }
+
+        for (intptr_t i = 0; i < kEventCount; i++)
+        {
+            NL_TEST_ASSERT(inSuite, !queue->Empty());
+            NL_TEST_ASSERT(inSuite, queue->TryPopFront(event));
+            NL_TEST_ASSERT(inSuite, event.CallWorkFunct.Arg == i);
+
+            // Events pushed while popping go behind the ones already queued.
+            if (i == CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE)
+            {
+                queue->Push(MakeEvent(1, 0));
+            }
+        }
+
+        NL_TEST_ASSERT(inSuite, queue->TryPopFront(event));
+        NL_TEST_ASSERT(inSuite, event.CallWorkFunct.Arg == MakeEvent(1, 0).CallWorkFunct.Arg);
+        NL_TEST_ASSERT(inSuite, queue->Empty());
+        NL_TEST_ASSERT(inSuite, !queue->TryPopFront(event));
+    }
+}
+
+void TestMultipleProducers(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr unsigned kProducerCount     = 4;
+    constexpr intptr_t kEventsPerProducer = 1000;
+
+    auto queue                            = std::make_unique<DeviceSafeQueue>();
+    intptr_t nextSequence[kProducerCount] = {};
+    std::vector<std::thread> producers;
+    ChipDeviceEvent event;
+
+    for (unsigned producer = 0; producer < kProducerCount; producer++)
+    {
+        producers.emplace_back([&queue, producer] {
+            for (intptr_t i = 0; i < kEventsPerProducer; i++)
+            {
+                queue->Push(MakeEvent(producer, i));
+            }
+        });
+    }
+
+    // Every event is popped once, and the events of each producer in the order they were pushed.
+    for (intptr_t received = 0; received < kEventsPerProducer * kProducerCount;)
+    {
+        if (!queue->TryPopFront(event))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const intptr_t producer = event.CallWorkFunct.Arg >> 24;
+        const intptr_t sequence = event.CallWorkFunct.Arg & 0xFFFFFF;
+        NL_TEST_ASSERT(inSuite, sequence == nextSequence[producer]);
+        nextSequence[producer] = sequence + 1;
+        received++;
+    }
+
+    for (auto & thread : producers)
+    {
+        thread.join();
+    }
+
+    NL_TEST_ASSERT(inSuite, queue->Empty());
+    NL_TEST_ASSERT(inSuite, !queue->TryPopFront(event));
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test single producer order", TestSingleProducerOrder),
+    NL_TEST_DEF("Test multiple producers", TestMultipleProducers),
+    NL_TEST_SENTINEL(),
+};
+
+} // namespace
+
+int TestDeviceSafeQueue()
+{
+    nlTestSuite theSuite = { "DeviceSafeQueue tests", &sTests[0], nullptr, nullptr };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDeviceSafeQueue)
@@ -256,6 +256,18 @@
 #define CHIP_SYSTEM_CONFIG_POOL_USE_HEAP 0
 #endif /* CHIP_SYSTEM_CONFIG_POOL_USE_HEAP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS
+ *
+ *  @brief
+ *      Number of blocks of released objects each heap pool keeps for reuse, so that creating objects does not allocate from
+ *      the heap while the number of objects in use is steady.  The cached blocks are freed by ReleaseAll() and when the pool is
+ *      destroyed.  Only relevant if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP is set.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS
+#define CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS 16
+#endif /* CHIP_SYSTEM_CONFIG_POOL_HEAP_CACHED_BLOCKS */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_NO_LOCKING
  *
@@ -409,6 +421,53 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX 1583
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The capacity, i.e. reserve plus data, of the smallest size class of cached heap-allocated packet buffers.
+ *
+ *      The default fits a standalone acknowledgement or a status report, with the default header reserve and the message
+ *      footer.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The capacity, i.e. reserve plus data, of the intermediate size class of cached heap-allocated packet buffers.  The
+ *      largest size class only holds full-size buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE
+ *
+ *  @brief
+ *      The number of freed heap-allocated packet buffers kept per size class, to serve the next allocations of that class
+ *      without going through Platform::MemoryAlloc.  Buffers are only cached while a system layer is initialized; the cache
+ *      is emptied when the last one shuts down.
+ *
+ *      Buffers up to #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY or #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *      bytes are allocated at the capacity of their class, and full-size buffers are a class of their own.  Buffers of other
+ *      sizes, including the ones reallocated by RightSize(), are allocated at their exact size and never cached.
+ *
+ *      This may be set to zero (0) to allocate and free every packet buffer with Platform::MemoryAlloc and
+ *      Platform::MemoryFree, at its exact size.  The cache is only enabled by default with POSIX locking.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE 16
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE 0
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE */
+
 /**
  *  @def _CHIP_SYSTEM_CONFIG_LWIP_EVENT
  *
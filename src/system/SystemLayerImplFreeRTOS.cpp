@@ -27,6 +27,7 @@
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplFreeRTOS.h>
+#include <system/SystemPacketBuffer.h>
 
 namespace chip {
 namespace System {
@@ -41,12 +42,22 @@ CHIP_ERROR LayerImplFreeRTOS::Init()
     RegisterLwIPErrorFormatter();
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    PacketBuffer::StartHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
     VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
     return CHIP_NO_ERROR;
 }
 
 void LayerImplFreeRTOS::Shutdown()
 {
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    if (mLayerState.IsInitialized())
+    {
+        PacketBuffer::StopHeapCache();
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
     mLayerState.ResetFromInitialized();
 }
 
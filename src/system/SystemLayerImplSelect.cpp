@@ -27,6 +27,7 @@
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplSelect.h>
+#include <system/SystemPacketBuffer.h>
 
 #include <errno.h>
 
@@ -58,6 +59,10 @@ CHIP_ERROR LayerImplSelect::Init()
     // Create an event to allow an arbitrary thread to wake the thread in the select loop.
     ReturnErrorOnFailure(mWakeEvent.Open(*this));
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    PacketBuffer::StartHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
     VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
     return CHIP_NO_ERROR;
 }
@@ -90,6 +95,10 @@ void LayerImplSelect::Shutdown()
 
     mWakeEvent.Close(*this);
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    PacketBuffer::StopHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
     mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
 }
 
@@ -126,6 +126,240 @@ void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 }
 #endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 
+namespace {
+
+// Heap-allocated packet buffers up to the capacity of a size class are allocated at that capacity, so that they can be cached
+// for reuse by any allocation of the class.  Full-size buffers are a class of their own.  Other buffers, notably the ones
+// reallocated by RightSize(), are allocated at their exact size and never cached.
+enum HeapSizeClass : uint8_t
+{
+    kHeapSizeClass_Small,
+    kHeapSizeClass_Medium,
+    kHeapSizeClass_Large,
+    kNumHeapSizeClasses,
+};
+
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY &&
+                  CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < PacketBuffer::kMaxSizeWithoutReserve,
+              "Packet buffer size classes must be increasing");
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+constexpr int kHeapSizeClassStats[kNumHeapSizeClasses] = {
+    chip::System::Stats::kSystemLayer_NumSmallPacketBufs,
+    chip::System::Stats::kSystemLayer_NumMediumPacketBufs,
+    chip::System::Stats::kSystemLayer_NumLargePacketBufs,
+};
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+// Returns kNumHeapSizeClasses if a buffer of aAllocSize bytes belongs to no size class.
+HeapSizeClass HeapSizeClassOf(uint16_t aAllocSize)
+{
+    if (aAllocSize <= CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY)
+    {
+        return kHeapSizeClass_Small;
+    }
+    if (aAllocSize <= CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY)
+    {
+        return kHeapSizeClass_Medium;
+    }
+    if (aAllocSize == PacketBuffer::kMaxSizeWithoutReserve)
+    {
+        return kHeapSizeClass_Large;
+    }
+    return kNumHeapSizeClasses;
+}
+
+// Counts the buffers in use per size class.
+void CountHeapBuffer(HeapSizeClass aSizeClass, bool aInUse)
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    VerifyOrReturn(aSizeClass < kNumHeapSizeClasses);
+    if (aInUse)
+    {
+        SYSTEM_STATS_INCREMENT(kHeapSizeClassStats[aSizeClass]);
+    }
+    else
+    {
+        SYSTEM_STATS_DECREMENT(kHeapSizeClassStats[aSizeClass]);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+
+constexpr uint16_t kHeapSizeClassCapacities[kNumHeapSizeClasses] = {
+    CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY,
+    CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY,
+    PacketBuffer::kMaxSizeWithoutReserve,
+};
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+constexpr int kHeapCacheStats[kNumHeapSizeClasses] = {
+    chip::System::Stats::kSystemLayer_NumCachedSmallPacketBufs,
+    chip::System::Stats::kSystemLayer_NumCachedMediumPacketBufs,
+    chip::System::Stats::kSystemLayer_NumCachedLargePacketBufs,
+};
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+// Free lists of the freed packet buffers of each size class, up to CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE per class, linked
+// through their first bytes.  Buffers are only cached while at least one system layer is initialized, so that the cache is
+// empty by the time Platform::MemoryShutdown() is called.
+class HeapCache
+{
+public:
+    HeapCache()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        Mutex::Init(mLock);
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    void Start()
+    {
+        Lock();
+        mUsers++;
+        Unlock();
+    }
+
+    void Stop()
+    {
+        Lock();
+        VerifyOrDie(mUsers > 0);
+        if (--mUsers == 0)
+        {
+            for (size_t sizeClass = 0; sizeClass < kNumHeapSizeClasses; sizeClass++)
+            {
+                while (mFreeLists[sizeClass] != nullptr)
+                {
+                    chip::Platform::MemoryFree(Pop(static_cast<HeapSizeClass>(sizeClass)));
+                }
+            }
+        }
+        Unlock();
+    }
+
+    PacketBuffer * Take(HeapSizeClass aSizeClass)
+    {
+        Lock();
+        PacketBuffer * buffer = (mFreeLists[aSizeClass] != nullptr) ? Pop(aSizeClass) : nullptr;
+        Unlock();
+        return buffer;
+    }
+
+    // Returns false if the buffer is to be freed instead.
+    bool Put(PacketBuffer * aBuffer, HeapSizeClass aSizeClass)
+    {
+        Lock();
+        const bool cached = (mUsers > 0) && (mCounts[aSizeClass] < CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE);
+        if (cached)
+        {
+            FreeBlock * block      = reinterpret_cast<FreeBlock *>(aBuffer);
+            block->mNext           = mFreeLists[aSizeClass];
+            mFreeLists[aSizeClass] = block;
+            mCounts[aSizeClass]++;
+            SYSTEM_STATS_INCREMENT(kHeapCacheStats[aSizeClass]);
+        }
+        Unlock();
+        return cached;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock * mNext;
+    };
+
+    PacketBuffer * Pop(HeapSizeClass aSizeClass)
+    {
+        FreeBlock * block      = mFreeLists[aSizeClass];
+        mFreeLists[aSizeClass] = block->mNext;
+        mCounts[aSizeClass]--;
+        SYSTEM_STATS_DECREMENT(kHeapCacheStats[aSizeClass]);
+        return reinterpret_cast<PacketBuffer *>(block);
+    }
+
+#if CHIP_SYSTEM_CONFIG_NO_LOCKING
+    void Lock() {}
+    void Unlock() {}
+#else  // CHIP_SYSTEM_CONFIG_NO_LOCKING
+    void Lock() { mLock.Lock(); }
+    void Unlock() { mLock.Unlock(); }
+
+    Mutex mLock;
+#endif // CHIP_SYSTEM_CONFIG_NO_LOCKING
+    FreeBlock * mFreeLists[kNumHeapSizeClasses]    = {};
+    size_t mCounts[kNumHeapSizeClasses]            = {};
+    unsigned mUsers                                = 0;
+};
+
+HeapCache sHeapCache;
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+
+// The capacity of the heap block holding a buffer of aAllocSize bytes.
+uint16_t HeapBlockCapacity(uint16_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    const HeapSizeClass sizeClass = HeapSizeClassOf(aAllocSize);
+    return (sizeClass < kNumHeapSizeClasses) ? kHeapSizeClassCapacities[sizeClass] : aAllocSize;
+#else  // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    return aAllocSize;
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+}
+
+} // namespace
+
+void PacketBuffer::StartHeapCache()
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    sHeapCache.Start();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+}
+
+void PacketBuffer::StopHeapCache()
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    sHeapCache.Stop();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+}
+
+PacketBuffer * PacketBuffer::HeapAlloc(uint16_t aAllocSize)
+{
+    const HeapSizeClass sizeClass = HeapSizeClassOf(aAllocSize);
+    PacketBuffer * buffer         = nullptr;
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    if (sizeClass < kNumHeapSizeClasses)
+    {
+        buffer = sHeapCache.Take(sizeClass);
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    if (buffer == nullptr)
+    {
+        buffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + HeapBlockCapacity(aAllocSize)));
+    }
+
+    if (buffer != nullptr)
+    {
+        CountHeapBuffer(sizeClass, true);
+    }
+    return buffer;
+}
+
+void PacketBuffer::HeapFree(PacketBuffer * aPacket, uint16_t aAllocSize)
+{
+    const HeapSizeClass sizeClass = HeapSizeClassOf(aAllocSize);
+
+    CountHeapBuffer(sizeClass, false);
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    if (sizeClass < kNumHeapSizeClasses && sHeapCache.Put(aPacket, sizeClass))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+    chip::Platform::MemoryFree(aPacket);
+}
+
 // Number of unused bytes below which \c RightSize() won't bother reallocating.
 constexpr uint16_t kRightSizingThreshold = 16;
 
@@ -141,13 +375,12 @@ void PacketBufferHandle::InternalRightSize()
     const uint8_t * const start   = mBuffer->ReserveStart();
     const uint8_t * const payload = mBuffer->Start();
     const uint16_t usedSize       = static_cast<uint16_t>(payload - start + mBuffer->len);
-    if (usedSize + kRightSizingThreshold > mBuffer->alloc_size)
+    if (HeapBlockCapacity(usedSize) + kRightSizingThreshold > HeapBlockCapacity(mBuffer->alloc_size))
     {
         return;
     }
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
-    PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+    PacketBuffer * newBuffer = PacketBuffer::HeapAlloc(usedSize);
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -527,7 +760,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
-    lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+    lPacket = PacketBuffer::HeapAlloc(static_cast<uint16_t>(lAllocSize));
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -606,13 +839,14 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const uint16_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            chip::Platform::MemoryFree(aPacket);
+            HeapFree(aPacket, lAllocSize);
 #endif
             aPacket       = lNextPacket;
         }
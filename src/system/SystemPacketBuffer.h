@@ -50,6 +50,7 @@ namespace chip {
 namespace System {
 
 class PacketBufferHandle;
+class ChainedPacketBufferBackingStore;
 
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP
 struct pbuf
@@ -353,6 +354,21 @@ public:
 #endif
     }
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    /**
+     * Start caching freed packet buffers for reuse, if #CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE is not zero.
+     *
+     * Each call must be matched by a call to StopHeapCache().  The system layer calls it when initialized.
+     */
+    static void StartHeapCache();
+
+    /**
+     * Match a call to StartHeapCache().  After the last one, freed packet buffers are no longer cached, and the cached ones are
+     * freed.  The system layer calls it when shut down, before the application calls Platform::MemoryShutdown().
+     */
+    static void StopHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
 private:
     // Memory required for a maximum-size PacketBuffer.
     static constexpr uint16_t kBlockSize = PacketBuffer::kStructureSize + PacketBuffer::kMaxSizeWithoutReserve;
@@ -369,6 +385,11 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    static PacketBuffer * HeapAlloc(uint16_t aAllocSize);
+    static void HeapFree(PacketBuffer * aPacket, uint16_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -392,6 +413,7 @@ private:
     const uint8_t * ReserveStart() const;
 
     friend class PacketBufferHandle;
+    friend class ChainedPacketBufferBackingStore;
     friend class ::PacketBufferTest;
 };
 
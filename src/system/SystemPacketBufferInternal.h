@@ -104,6 +104,35 @@
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER
+ *
+ * True if the SDK is built with AddressSanitizer.
+ */
+#if defined(__SANITIZE_ADDRESS__)
+#define CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER 1
+#endif
+#endif
+#ifndef CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER
+#define CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER 0
+#endif
+
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+ *
+ * True if freed heap-allocated packet buffers are cached for reuse by allocations of the same size class.  The cache is disabled
+ * under AddressSanitizer, which otherwise could not detect uses of freed buffers.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_CACHE_SIZE > 0) &&                                  \
+    !CHIP_SYSTEM_PACKETBUFFER_ADDRESS_SANITIZER
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE 0
+#endif
+
 // Sanity checks
 
 #if (CHIP_SYSTEM_CONFIG_USE_LWIP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP + CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL) != 1
@@ -44,6 +44,14 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0)
+    "SystemLayer_NumSmallPacketBufs",
+    "SystemLayer_NumMediumPacketBufs",
+    "SystemLayer_NumLargePacketBufs",
+    "SystemLayer_NumCachedSmallPacketBufs",
+    "SystemLayer_NumCachedMediumPacketBufs",
+    "SystemLayer_NumCachedLargePacketBufs",
+#endif
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -52,7 +60,8 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #if INET_CONFIG_NUM_UDP_ENDPOINTS
     "InetLayer_NumUDPEpsInUse",
 #endif
-    "ExchangeMgr_NumContextsInUse", "ExchangeMgr_NumUMHandlersInUse", "ExchangeMgr_NumBindings", "MessageLayer_NumConnectionsInUse",
+    "ExchangeMgr_NumContextsInUse", "ExchangeMgr_NumUMHandlersInUse", "ExchangeMgr_NumBindings", "ExchangeMgr_NumQueuedMessages",
+    "MessageLayer_NumConnectionsInUse",
 };
 
 count_t sResourcesInUse[kNumEntries];
@@ -58,6 +58,15 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE == 0)
+    // Heap-allocated packet buffers in use per size class, from the smallest, then the freed ones cached per size class.
+    kSystemLayer_NumSmallPacketBufs,
+    kSystemLayer_NumMediumPacketBufs,
+    kSystemLayer_NumLargePacketBufs,
+    kSystemLayer_NumCachedSmallPacketBufs,
+    kSystemLayer_NumCachedMediumPacketBufs,
+    kSystemLayer_NumCachedLargePacketBufs,
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -69,6 +78,7 @@ enum
     kExchangeMgr_NumContexts,
     kExchangeMgr_NumUMHandlers,
     kExchangeMgr_NumBindings,
+    kExchangeMgr_NumQueuedMessages,
     kMessageLayer_NumConnections,
     kNumEntries
 };
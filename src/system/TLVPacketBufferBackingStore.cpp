@@ -23,6 +23,7 @@
 
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 
 namespace chip {
@@ -113,5 +114,51 @@ CHIP_ERROR TLVPacketBufferBackingStore::GetNewBuffer(chip::TLV::TLVWriter & writ
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ChainedPacketBufferBackingStore::OnInit(chip::TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
+{
+    VerifyOrReturnError(mpHead != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mpCurrent = mpHead;
+    bufStart  = mpHead->Start();
+    bufLen    = mpHead->DataLength();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChainedPacketBufferBackingStore::GetNextBuffer(chip::TLV::TLVReader & reader, const uint8_t *& bufStart,
+                                                          uint32_t & bufLen)
+{
+    // bufStart is where the reader stopped, i.e. the end of the buffer it is done with.  Readers
+    // usually go through the chain in order, so try the buffer handed out last before searching.
+    PacketBuffer * buffer = mpCurrent;
+    if (buffer == nullptr || buffer->Start() + buffer->DataLength() != bufStart)
+    {
+        for (buffer = mpHead; buffer != nullptr; buffer = buffer->ChainedBuffer())
+        {
+            if (buffer->Start() + buffer->DataLength() == bufStart)
+            {
+                break;
+            }
+        }
+        VerifyOrReturnError(buffer != nullptr, CHIP_ERROR_INTERNAL);
+    }
+
+    do
+    {
+        buffer = buffer->ChainedBuffer();
+    } while (buffer != nullptr && buffer->DataLength() == 0);
+
+    if (buffer == nullptr)
+    {
+        bufStart = nullptr;
+        bufLen   = 0;
+        return CHIP_NO_ERROR;
+    }
+
+    mpCurrent = buffer;
+    bufStart  = buffer->Start();
+    bufLen    = buffer->DataLength();
+    return CHIP_NO_ERROR;
+}
+
 } // namespace System
 } // namespace chip
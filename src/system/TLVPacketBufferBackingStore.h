@@ -87,6 +87,47 @@ protected:
     bool mUseChainedBuffers;
 };
 
+/**
+ * A read-only TLVBackingStore over a chain of PacketBuffers, presenting their data to a TLVReader
+ * without copying it into a contiguous buffer.
+ *
+ * Unlike TLVPacketBufferBackingStore, the store does not advance through the chain on its own: the
+ * buffer to read next is the one following the buffer that ends where the reader stopped.  Several
+ * readers can thus share the store, such as the copies of a reader made while decoding nested
+ * containers, regardless of the order in which they read.
+ *
+ * The store does not own the chain, which must outlive the readers using it.
+ */
+class ChainedPacketBufferBackingStore : public chip::TLV::TLVBackingStore
+{
+public:
+    void Init(const PacketBufferHandle & aHead)
+    {
+        mpHead    = aHead.operator->();
+        mpCurrent = mpHead;
+    }
+
+    // TLVBackingStore overrides:
+    CHIP_ERROR OnInit(chip::TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+    CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+    CHIP_ERROR OnInit(chip::TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR GetNewBuffer(chip::TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(chip::TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    PacketBuffer * mpHead    = nullptr;
+    PacketBuffer * mpCurrent = nullptr; // Last buffer handed out, to find the next one without walking the chain.
+};
+
 class DLL_EXPORT PacketBufferTLVReader : public TLV::ContiguousBufferTLVReader
 {
 public:
@@ -107,6 +148,36 @@ private:
     PacketBufferHandle mBuffer;
 };
 
+class DLL_EXPORT ChainedPacketBufferTLVReader : public TLV::TLVReader
+{
+public:
+    /**
+     * Initializes a TLVReader object to read from a chain of PacketBuffers, in place.
+     *
+     * @param[in]    buffer  A handle to the head of the chain of PacketBuffers holding the TLV.
+     *
+     * @note Elements may span buffers, but a string can only be accessed through GetDataPtr()
+     *       (and thus be decoded as a span) if it is held entirely by one buffer.
+     */
+    CHIP_ERROR Init(chip::System::PacketBufferHandle && buffer)
+    {
+        mBuffer = std::move(buffer);
+        if (mBuffer.IsNull())
+        {
+            TLV::TLVReader::Init(nullptr, 0);
+            return CHIP_NO_ERROR;
+        }
+
+        size_t totalLength = mBuffer->TotalLength();
+        mBackingStore.Init(mBuffer);
+        return TLV::TLVReader::Init(mBackingStore, totalLength > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(totalLength));
+    }
+
+private:
+    PacketBufferHandle mBuffer;
+    ChainedPacketBufferBackingStore mBackingStore;
+};
+
 class DLL_EXPORT PacketBufferTLVWriter : public chip::TLV::TLVWriter
 {
 public:
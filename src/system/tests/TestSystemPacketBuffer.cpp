@@ -133,6 +133,8 @@ public:
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
+    static void CheckHeapCache(nlTestSuite * inSuite, void * inContext);
+    static void CheckHeapCacheChurn(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
@@ -1963,6 +1965,90 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+void PacketBufferTest::CheckHeapCache(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+
+    constexpr uint16_t kSmallSize  = 100;
+    constexpr uint16_t kMediumSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY + 1;
+    constexpr uint16_t kOtherSize  = CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY + 1;
+
+    // A freed buffer is reused by the next allocation of its size class, whatever its size.
+    PacketBufferHandle handle = PacketBufferHandle::New(kSmallSize, 0);
+    PacketBuffer * small      = handle.mBuffer;
+    handle                    = nullptr;
+    handle                    = PacketBufferHandle::New(kSmallSize / 2, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == small);
+    NL_TEST_ASSERT(inSuite, handle->AllocSize() == kSmallSize / 2);
+
+    // It is not reused by an allocation of another class.
+    handle                         = nullptr;
+    PacketBufferHandle otherHandle = PacketBufferHandle::New(kMediumSize, 0);
+    NL_TEST_ASSERT(inSuite, otherHandle.mBuffer != small);
+    NL_TEST_ASSERT(inSuite, otherHandle->AllocSize() == kMediumSize);
+    otherHandle = nullptr;
+
+    // Full-size buffers are only reused by full-size allocations, other sizes are allocated at their exact size.
+    handle             = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    PacketBuffer * big = handle.mBuffer;
+    handle             = nullptr;
+    otherHandle        = PacketBufferHandle::New(kOtherSize, 0);
+    NL_TEST_ASSERT(inSuite, otherHandle.mBuffer != big);
+    otherHandle = nullptr;
+
+    // Right-sizing a full-size buffer moves its data to a buffer of the smallest class that fits, and caches the full-size one.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == big);
+    handle->SetDataLength(kSmallSize);
+    handle.RightSize();
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == small);
+    NL_TEST_ASSERT(inSuite, handle->DataLength() == kSmallSize);
+
+    // Right-sizing within a class keeps the buffer.
+    handle->SetDataLength(kSmallSize / 2);
+    handle.RightSize();
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == small);
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == big);
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CACHE
+}
+
+/**
+ *  Check that buffers in use are never handed out again under a message load: every full-size message received is
+ *  acknowledged and answered by a status report, the last few of which stay in flight, as if awaiting acknowledgement.
+ */
+void PacketBufferTest::CheckHeapCacheChurn(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+    constexpr size_t kMessageCount = 1000;
+    constexpr uint16_t kAckSize    = 16; // Message integrity check of an otherwise empty message.
+    constexpr uint16_t kStatusSize = 24; // Status report and message integrity check.
+    PacketBufferHandle inFlight[16];
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        PacketBufferHandle received = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+        PacketBufferHandle ack      = PacketBufferHandle::New(kAckSize);
+        PacketBufferHandle status   = PacketBufferHandle::New(kStatusSize);
+        NL_TEST_ASSERT(inSuite, !received.IsNull() && !ack.IsNull() && !status.IsNull());
+        NL_TEST_ASSERT(inSuite, received.mBuffer != ack.mBuffer && ack.mBuffer != status.mBuffer);
+        for (const PacketBufferHandle & sent : inFlight)
+        {
+            NL_TEST_ASSERT(inSuite, sent.IsNull() || sent.mBuffer != status.mBuffer);
+        }
+
+        inFlight[i % ArraySize(inFlight)] = std::move(status);
+    }
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -2003,6 +2089,8 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::HeapCache",              PacketBufferTest::CheckHeapCache),
+    NL_TEST_DEF("PacketBuffer::HeapCacheChurn",         PacketBufferTest::CheckHeapCacheChurn),
 
     NL_TEST_SENTINEL()
 };
@@ -28,6 +28,7 @@
 
 using ::chip::Platform::ScopedMemoryBuffer;
 using ::chip::System::PacketBuffer;
+using ::chip::System::ChainedPacketBufferTLVReader;
 using ::chip::System::PacketBufferHandle;
 using ::chip::System::PacketBufferTLVReader;
 using ::chip::System::PacketBufferTLVWriter;
@@ -43,6 +44,7 @@ public:
 
     static void BasicEncodeDecode(nlTestSuite * inSuite, void * inContext);
     static void MultiBufferEncode(nlTestSuite * inSuite, void * inContext);
+    static void ChainedBufferDecode(nlTestSuite * inSuite, void * inContext);
 };
 
 int TLVPacketBufferBackingStoreTest::TestSetup(void * inContext)
@@ -238,6 +240,81 @@ void TLVPacketBufferBackingStoreTest::MultiBufferEncode(nlTestSuite * inSuite, v
     NL_TEST_ASSERT(inSuite, error == CHIP_END_OF_TLV);
 }
 
+/**
+ * Test that we can decode TLV spread over a chain of buffers in place, using
+ * several readers sharing the chain.
+ */
+void TLVPacketBufferBackingStoreTest::ChainedBufferDecode(nlTestSuite * inSuite, void * inContext)
+{
+    // Encode an array of 3 byte strings, with the array start and the first
+    // string in one buffer, the second string in another buffer, and the
+    // third string and the array end in a third buffer.
+    uint8_t bytes[3][200];
+    for (size_t i = 0; i < 3; i++)
+    {
+        memset(bytes[i], static_cast<int>(i + 1), sizeof(bytes[i]));
+    }
+
+    PacketBufferHandle chain;
+    TLV::TLVType outerContainerType;
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto buffer = PacketBufferHandle::New(256, 0);
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+        TLV::TLVWriter writer;
+        writer.Init(buffer->Start(), buffer->AvailableDataLength());
+        if (i == 0)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerContainerType) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, writer.Put(TLV::AnonymousTag(), ByteSpan(bytes[i])) == CHIP_NO_ERROR);
+        uint32_t length = writer.GetLengthWritten();
+        if (i == 2)
+        {
+            // A writer cannot end a container it did not start, add the end of container by hand.
+            buffer->Start()[length++] = static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer);
+        }
+        buffer->SetDataLength(static_cast<uint16_t>(length));
+
+        chain.AddToEnd(std::move(buffer));
+    }
+    NL_TEST_ASSERT(inSuite, chain->HasChainedBuffer());
+
+    ChainedPacketBufferTLVReader reader;
+    NL_TEST_ASSERT(inSuite, reader.Init(std::move(chain)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.EnterContainer(outerContainerType) == CHIP_NO_ERROR);
+
+    // Take a copy of the reader at the first element, then read the whole
+    // array with the original reader.
+    TLV::TLVReader copy;
+    copy.Init(reader);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        ByteSpan value;
+        NL_TEST_ASSERT(inSuite, reader.Next(TLV::kTLVType_ByteString, TLV::AnonymousTag()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, value.data_equal(ByteSpan(bytes[i])));
+    }
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, reader.ExitContainer(outerContainerType) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+
+    // The copy is not affected by the original reader having gone through the
+    // whole chain.
+    for (size_t i = 0; i < 3; i++)
+    {
+        ByteSpan value;
+        NL_TEST_ASSERT(inSuite, copy.Next(TLV::kTLVType_ByteString, TLV::AnonymousTag()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, copy.Get(value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, value.data_equal(ByteSpan(bytes[i])));
+    }
+    NL_TEST_ASSERT(inSuite, copy.Next() == CHIP_END_OF_TLV);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -246,6 +323,7 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("BasicEncodeDecode",                    TLVPacketBufferBackingStoreTest::BasicEncodeDecode),
     NL_TEST_DEF("MultiBufferEncode",                    TLVPacketBufferBackingStoreTest::MultiBufferEncode),
+    NL_TEST_DEF("ChainedBufferDecode",                  TLVPacketBufferBackingStoreTest::ChainedBufferDecode),
 
     NL_TEST_SENTINEL()
 };
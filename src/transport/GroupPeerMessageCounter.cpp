@@ -41,72 +41,77 @@ CHIP_ERROR GroupPeerTable::FindOrAddPeer(FabricIndex fabricIndex, NodeId nodeId,
             // Already iterated through all known fabricIndex
             // Add the new peer to save some processing time
             groupFabric.mFabricIndex = fabricIndex;
+        }
+
+        if (fabricIndex == groupFabric.mFabricIndex)
+        {
+            GroupSender * sender;
             if (isControl)
             {
-                groupFabric.mControlGroupSenders[0].mNodeId = nodeId;
-                counter                                     = &(groupFabric.mControlGroupSenders[0].msgCounter);
-                groupFabric.mControlPeerCount++;
+                sender = FindOrAddSender(groupFabric.mControlGroupSenders, GroupFabric::kControlPeerSlots,
+                                         groupFabric.mControlPeerCount, CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS, nodeId);
             }
             else
             {
-                groupFabric.mDataGroupSenders[0].mNodeId = nodeId;
-                counter                                  = &(groupFabric.mDataGroupSenders[0].msgCounter);
-                groupFabric.mDataPeerCount++;
+                sender = FindOrAddSender(groupFabric.mDataGroupSenders, GroupFabric::kDataPeerSlots, groupFabric.mDataPeerCount,
+                                         CHIP_CONFIG_MAX_GROUP_DATA_PEERS, nodeId);
             }
+            counter = &(sender->msgCounter);
             return CHIP_NO_ERROR;
         }
+    }
 
-        if (fabricIndex == groupFabric.mFabricIndex)
+    // Exceeded the Max number of Group peers
+    return CHIP_ERROR_TOO_MANY_PEER_NODES;
+}
+
+GroupSender * GroupPeerTable::FindOrAddSender(GroupSender * table, uint32_t slots, uint16_t & count, uint32_t maxCount,
+                                              NodeId nodeId)
+{
+    uint32_t index = HomeSlot(nodeId, slots);
+
+    // Tables always have more slots than senders, so probing ends on an empty slot.
+    while (table[index].mNodeId != kUndefinedNodeId)
+    {
+        if (table[index].mNodeId == nodeId)
         {
-            if (isControl)
+            table[index].mLastUsed = ++mUseCounter;
+            return &table[index];
+        }
+        index = (index + 1) % slots;
+    }
+
+    if (count >= maxCount)
+    {
+        // Evict the least recently used sender. This scan only happens when a new sender shows up on a full table.
+        uint32_t lruIndex = slots;
+        for (uint32_t i = 0; i < slots; i++)
+        {
+            if (table[i].mNodeId == kUndefinedNodeId)
             {
-                for (auto & node : groupFabric.mControlGroupSenders)
-                {
-                    if (node.mNodeId == kUndefinedNodeId)
-                    {
-                        // Already iterated through all known NodeIds
-                        // Add the new peer to save some processing time
-                        node.mNodeId = nodeId;
-                        counter      = &(node.msgCounter);
-                        groupFabric.mControlPeerCount++;
-                        return CHIP_NO_ERROR;
-                    }
-
-                    if (node.mNodeId == nodeId)
-                    {
-                        counter = &(node.msgCounter);
-                        return CHIP_NO_ERROR;
-                    }
-                }
+                continue;
             }
-            else
+            // Compare ages rather than raw values so that wrapping of the use counter is handled.
+            if (lruIndex == slots || (mUseCounter - table[i].mLastUsed) > (mUseCounter - table[lruIndex].mLastUsed))
             {
-                for (auto & node : groupFabric.mDataGroupSenders)
-                {
-                    if (node.mNodeId == kUndefinedNodeId)
-                    {
-                        // Already iterated through all known NodeIds
-                        // Add the new peer to save some processing time
-                        node.mNodeId = nodeId;
-                        counter      = &(node.msgCounter);
-                        groupFabric.mDataPeerCount++;
-                        return CHIP_NO_ERROR;
-                    }
-
-                    if (node.mNodeId == nodeId)
-                    {
-                        counter = &(node.msgCounter);
-                        return CHIP_NO_ERROR;
-                    }
-                }
+                lruIndex = i;
             }
-            // Exceeded the Max number of Group peers
-            return CHIP_ERROR_TOO_MANY_PEER_NODES;
+        }
+        RemoveSenderAt(table, slots, lruIndex);
+        count--;
+
+        // Removal may have shifted entries, so look for the insertion slot again.
+        index = HomeSlot(nodeId, slots);
+        while (table[index].mNodeId != kUndefinedNodeId)
+        {
+            index = (index + 1) % slots;
         }
     }
 
-    // Exceeded the Max number of Group peers
-    return CHIP_ERROR_TOO_MANY_PEER_NODES;
+    table[index].mNodeId   = nodeId;
+    table[index].mLastUsed = ++mUseCounter;
+    count++;
+    return &table[index];
 }
 
 // Used in case of MCSP failure
@@ -126,7 +131,7 @@ CHIP_ERROR GroupPeerTable::RemovePeer(FabricIndex fabricIndex, NodeId nodeId, bo
         {
             if (isControl)
             {
-                if (RemoveSpecificPeer(mGroupFabrics[it].mControlGroupSenders, nodeId, CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS))
+                if (RemoveSpecificPeer(mGroupFabrics[it].mControlGroupSenders, nodeId, GroupFabric::kControlPeerSlots))
                 {
                     fabricIt = it;
                     mGroupFabrics[it].mControlPeerCount--;
@@ -135,7 +140,7 @@ CHIP_ERROR GroupPeerTable::RemovePeer(FabricIndex fabricIndex, NodeId nodeId, bo
             }
             else
             {
-                if (RemoveSpecificPeer(mGroupFabrics[it].mDataGroupSenders, nodeId, CHIP_CONFIG_MAX_GROUP_DATA_PEERS))
+                if (RemoveSpecificPeer(mGroupFabrics[it].mDataGroupSenders, nodeId, GroupFabric::kDataPeerSlots))
                 {
                     fabricIt = it;
                     mGroupFabrics[it].mDataPeerCount--;
@@ -181,54 +186,51 @@ CHIP_ERROR GroupPeerTable::FabricRemoved(FabricIndex fabricIndex)
     return err;
 }
 
-bool GroupPeerTable::RemoveSpecificPeer(GroupSender * list, NodeId nodeId, uint32_t size)
+bool GroupPeerTable::RemoveSpecificPeer(GroupSender * table, NodeId nodeId, uint32_t slots)
 {
-    bool removed = false;
-    for (uint32_t nodeIt = 0; nodeIt < size; nodeIt++)
+    uint32_t index = HomeSlot(nodeId, slots);
+    while (table[index].mNodeId != kUndefinedNodeId)
     {
-        if (list[nodeIt].mNodeId == nodeId)
+        if (table[index].mNodeId == nodeId)
         {
-            list[nodeIt].mNodeId = kUndefinedNodeId;
-            list[nodeIt].msgCounter.Reset();
-            removed = true;
-            break;
+            RemoveSenderAt(table, slots, index);
+            return true;
         }
+        index = (index + 1) % slots;
     }
 
-    if (removed)
-    {
-        CompactPeers(list, size);
-    }
-
-    return removed;
+    return false;
 }
 
-void GroupPeerTable::CompactPeers(GroupSender * list, uint32_t size)
+void GroupPeerTable::RemoveSenderAt(GroupSender * table, uint32_t slots, uint32_t index)
 {
-    if (list == nullptr || size == 0)
+    // Backward shift deletion: move later entries of the probe sequence into the hole, so that no
+    // lookup stops early on it and no tombstones are needed.
+    uint32_t hole = index;
+    uint32_t next = (hole + 1) % slots;
+    while (table[next].mNodeId != kUndefinedNodeId)
     {
-        return;
-    }
-
-    for (uint32_t peerIndex = 0; peerIndex < size; peerIndex++)
-    {
-        if (list[peerIndex].mNodeId != kUndefinedNodeId)
-        {
-            continue;
-        }
-
-        for (uint32_t i = (size - 1); i > peerIndex; i--)
+        uint32_t home = HomeSlot(table[next].mNodeId, slots);
+        // The entry may move to the hole only if its home slot is not within (hole, next].
+        bool canMove = (hole < next) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (canMove)
         {
-            if (list[i].mNodeId != kUndefinedNodeId)
-            {
-                // Logic works since all buffer are static
-                // move it up front
-                new (&list[peerIndex]) GroupSender(list[i]);
-                new (&list[i]) GroupSender();
-                break;
-            }
+            // Logic works since all buffer are static
+            new (&table[hole]) GroupSender(table[next]);
+            hole = next;
         }
+        next = (next + 1) % slots;
     }
+
+    table[hole].msgCounter.Reset();
+    new (&table[hole]) GroupSender();
+}
+
+uint32_t GroupPeerTable::HomeSlot(NodeId nodeId, uint32_t slots)
+{
+    // Fold the 64-bit node id and spread it with a multiplicative hash (Knuth).
+    uint32_t hash = static_cast<uint32_t>(nodeId ^ (nodeId >> 32)) * 2654435761u;
+    return hash % slots;
 }
 
 void GroupPeerTable::RemoveAndCompactFabric(uint32_t tableIndex)
@@ -41,21 +41,46 @@ class GroupSender
 public:
     NodeId mNodeId = kUndefinedNodeId;
     PeerMessageCounter msgCounter;
+    // Value of GroupPeerTable's use counter when this sender was last looked up, for LRU eviction.
+    uint32_t mLastUsed = 0;
 };
 
+/// Number of hash table slots used to track up to `maxPeers` senders, keeping the load factor at or below 80%.
+constexpr uint32_t GroupSenderTableSlots(uint32_t maxPeers)
+{
+    return maxPeers + (maxPeers + 3) / 4;
+}
+
+/**
+ * Group message senders of a single fabric.
+ *
+ * Senders are kept in open addressing hash tables (linear probing, keyed by node id), which have
+ * more slots than the maximum number of senders so that lookups stay short and always terminate
+ * on an empty slot.
+ */
 class GroupFabric
 {
 public:
-    FabricIndex mFabricIndex  = kUndefinedFabricIndex;
-    uint8_t mControlPeerCount = 0;
-    uint8_t mDataPeerCount    = 0;
-    GroupSender mDataGroupSenders[CHIP_CONFIG_MAX_GROUP_DATA_PEERS];
-    GroupSender mControlGroupSenders[CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS];
+    static constexpr uint32_t kDataPeerSlots    = GroupSenderTableSlots(CHIP_CONFIG_MAX_GROUP_DATA_PEERS);
+    static constexpr uint32_t kControlPeerSlots = GroupSenderTableSlots(CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS);
+
+    FabricIndex mFabricIndex   = kUndefinedFabricIndex;
+    uint16_t mControlPeerCount = 0;
+    uint16_t mDataPeerCount    = 0;
+    GroupSender mDataGroupSenders[kDataPeerSlots];
+    GroupSender mControlGroupSenders[kControlPeerSlots];
 };
 
 class GroupPeerTable
 {
 public:
+    /**
+     * Find the message counter of a group message sender, adding the sender if it is not known yet.
+     *
+     * When the fabric already tracks the maximum number of senders of the given kind, the least
+     * recently used one is evicted to make room. CHIP_ERROR_TOO_MANY_PEER_NODES is only returned
+     * when no more fabrics can be tracked.
+     */
     CHIP_ERROR FindOrAddPeer(FabricIndex fabricIndex, NodeId nodeId, bool isControl,
                              chip::Transport::PeerMessageCounter *& counter);
 
@@ -66,11 +91,15 @@ public:
 
     // Protected for Unit Tests inheritance
 protected:
-    bool RemoveSpecificPeer(GroupSender * list, NodeId nodeId, uint32_t size);
-    void CompactPeers(GroupSender * list, uint32_t size);
+    GroupSender * FindOrAddSender(GroupSender * table, uint32_t slots, uint16_t & count, uint32_t maxCount, NodeId nodeId);
+    bool RemoveSpecificPeer(GroupSender * table, NodeId nodeId, uint32_t slots);
+    void RemoveSenderAt(GroupSender * table, uint32_t slots, uint32_t index);
     void RemoveAndCompactFabric(uint32_t tableIndex);
 
+    static uint32_t HomeSlot(NodeId nodeId, uint32_t slots);
+
     GroupFabric mGroupFabrics[CHIP_CONFIG_MAX_FABRICS];
+    uint32_t mUseCounter = 0;
 };
 
 // Might want to rename this so that it is explicitly the sending side of counters
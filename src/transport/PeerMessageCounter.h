@@ -22,7 +22,8 @@
 #pragma once
 
 #include <array>
-#include <bitset>
+#include <new>
+#include <stdint.h>
 
 #include <lib/support/Span.h>
 
@@ -82,7 +83,7 @@ public:
         mStatus = Status::Synced;
         new (&mSynced) Synced();
         mSynced.mMaxCounter = counter;
-        mSynced.mWindow.reset(); // reset all bits, accept all packets in the window
+        mSynced.mWindow.Reset(); // reset all bits, accept all packets in the window
         return CHIP_NO_ERROR;
     }
 
@@ -190,7 +191,7 @@ public:
         mStatus = Status::Synced;
         new (&mSynced) Synced();
         mSynced.mMaxCounter = value;
-        mSynced.mWindow.reset();
+        mSynced.mWindow.Reset();
     }
 
     uint32_t GetCounter() const { return mSynced.mMaxCounter; }
@@ -278,7 +279,7 @@ private:
             return CHIP_NO_ERROR;
         case Position::InWindow: {
             uint32_t offset = mSynced.mMaxCounter - counter;
-            if (mSynced.mWindow.test(offset - 1))
+            if (mSynced.mWindow.Test(offset - 1))
             {
                 return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED;
             }
@@ -303,7 +304,7 @@ private:
             return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED;
         case Position::InWindow: {
             uint32_t offset = mSynced.mMaxCounter - counter;
-            if (mSynced.mWindow.test(offset - 1))
+            if (mSynced.mWindow.Test(offset - 1))
             {
                 return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED;
             }
@@ -340,7 +341,7 @@ private:
         {
         case Position::InWindow: {
             uint32_t offset = mSynced.mMaxCounter - counter;
-            mSynced.mWindow.set(offset - 1);
+            mSynced.mWindow.Set(offset - 1);
             break;
         }
         case Position::MaxCounter: {
@@ -353,12 +354,12 @@ private:
             mSynced.mMaxCounter = counter;
             if (shift > CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE)
             {
-                mSynced.mWindow.reset();
+                mSynced.mWindow.Reset();
             }
             else
             {
-                mSynced.mWindow <<= shift;
-                mSynced.mWindow.set(shift - 1);
+                mSynced.mWindow.Slide(shift);
+                mSynced.mWindow.Set(shift - 1);
             }
             break;
         }
@@ -372,6 +373,60 @@ private:
         Synced,        // mSynced will be active
     } mStatus;
 
+    /**
+     * Bitmap of the counters seen before the max counter, bit n standing for
+     * max counter - n - 1.  The bits are held in words, so that testing a bit
+     * needs no bounds check and sliding the window takes a shift per word; the
+     * default window of 32 counters is a single word.
+     */
+    class Window
+    {
+    public:
+        static constexpr size_t kSize = CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE;
+
+        void Reset() { mWords.fill(0); }
+
+        // bit must be less than kSize.
+        bool Test(uint32_t bit) const { return ((mWords[bit / kWordBits] >> (bit % kWordBits)) & 1) != 0; }
+        void Set(uint32_t bit) { mWords[bit / kWordBits] |= static_cast<Word>(Word(1) << (bit % kWordBits)); }
+
+        /**
+         * Move every bit up by shift, 1 <= shift <= kSize, as the max counter
+         * increases by shift.  The bits moved past the window are dropped.
+         */
+        void Slide(uint32_t shift)
+        {
+            const size_t wordShift = shift / kWordBits;
+            const size_t bitShift  = shift % kWordBits;
+            for (size_t i = kWordCount; i-- > 0;)
+            {
+                Word word = 0;
+                if (i >= wordShift)
+                {
+                    word = static_cast<Word>(mWords[i - wordShift] << bitShift);
+                    if (bitShift != 0 && i > wordShift)
+                    {
+                        word = static_cast<Word>(word | (mWords[i - wordShift - 1] >> (kWordBits - bitShift)));
+                    }
+                }
+                mWords[i] = word;
+            }
+            mWords[kWordCount - 1] &= kLastWordMask;
+        }
+
+    private:
+        using Word = uint32_t;
+
+        static constexpr size_t kWordBits  = 32;
+        static constexpr size_t kWordCount = (kSize + kWordBits - 1) / kWordBits;
+        static constexpr Word kLastWordMask =
+            (kSize % kWordBits == 0) ? static_cast<Word>(~Word(0)) : static_cast<Word>((Word(1) << (kSize % kWordBits)) - 1);
+
+        static_assert(kSize > 0, "The message counter window must not be empty");
+
+        std::array<Word, kWordCount> mWords = {};
+    };
+
     struct SyncInProcess
     {
         std::array<uint8_t, kChallengeSize> mChallenge;
@@ -388,7 +443,7 @@ private:
          *  |[n]|  ...   |[0]|
          */
         uint32_t mMaxCounter = 0; // The most recent counter we have seen
-        std::bitset<CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE> mWindow;
+        Window mWindow;
     };
 
     // We should use std::variant here when migrated to C++17
@@ -208,6 +208,9 @@ public:
     // the target For group sessions, this function will always return 0.
     System::Clock::Timeout ComputeRoundTripTimeout(System::Clock::Timeout upperlayerProcessingTimeout);
 
+    // The round-trip time of the session, as measured by the reliable message manager from the acknowledgments of the peer.
+    RoundTripTimeEstimator & GetRoundTripTimeEstimator() { return mRoundTripTimeEstimator; }
+
     FabricIndex GetFabricIndex() const { return mFabricIndex; }
 
     SecureSession * AsSecureSession();
@@ -263,6 +266,7 @@ protected:
 
 private:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
+    RoundTripTimeEstimator mRoundTripTimeEstimator;
 };
 
 //
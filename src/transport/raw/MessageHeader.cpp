@@ -87,6 +87,14 @@ constexpr uint8_t kMsgFlagsMask = 0x07;
 /// Shift to convert to/from a masked version 8bit value to a 4bit version.
 constexpr int kVersionShift = 4;
 
+/// Security flags that must be clear in the common packet header: unicast session, no message extensions.
+constexpr uint8_t kCommonSecFlagsClearMask =
+    Header::SecFlagMask::kSessionTypeMask | to_underlying(Header::SecFlagValues::kMsgExtensionFlag);
+
+/// Exchange flags that must be clear in the common payload header: no vendor id, no secured extensions.
+constexpr uint8_t kCommonExFlagsClearMask = to_underlying(Header::ExFlagValues::kExchangeFlag_VendorIdPresent) |
+    to_underlying(Header::ExFlagValues::kExchangeFlag_SecuredExtension);
+
 } // namespace
 
 uint16_t PacketHeader::EncodeSizeBytes() const
@@ -163,6 +171,22 @@ CHIP_ERROR PacketHeader::DecodeFixed(const System::PacketBufferHandle & buf)
 
 CHIP_ERROR PacketHeader::Decode(const uint8_t * const data, uint16_t size, uint16_t * decode_len)
 {
+    // Most messages are sent on unicast sessions, whose headers have only the fixed fields: decode these directly.  The message
+    // flags are then the version alone, without source node id nor destination.
+    constexpr uint8_t kCommonMsgFlags = kMsgHeaderVersion << kVersionShift;
+    if (size >= kFixedUnencryptedHeaderSizeBytes && data[0] == kCommonMsgFlags && (data[3] & kCommonSecFlagsClearMask) == 0)
+    {
+        SetMessageFlags(data[0]);
+        mSessionId = LittleEndian::Get16(&data[1]);
+        SetSecurityFlags(data[3]);
+        mMessageCounter = LittleEndian::Get32(&data[4]);
+        mSourceNodeId.ClearValue();
+        mDestinationNodeId.ClearValue();
+        mDestinationGroupId.ClearValue();
+        *decode_len = kFixedUnencryptedHeaderSizeBytes;
+        return CHIP_NO_ERROR;
+    }
+
     CHIP_ERROR err = CHIP_NO_ERROR;
     LittleEndian::Reader reader(data, size);
     // TODO: De-uint16-ify everything related to this library
@@ -249,6 +273,30 @@ CHIP_ERROR PacketHeader::DecodeAndConsume(const System::PacketBufferHandle & buf
 
 CHIP_ERROR PayloadHeader::Decode(const uint8_t * const data, uint16_t size, uint16_t * decode_len)
 {
+    // Without vendor id nor secured extensions, the fields are at fixed offsets, and only the acknowledged counter is optional.
+    if (size >= kEncryptedHeaderSizeBytes && (data[0] & kCommonExFlagsClearMask) == 0)
+    {
+        const bool hasAck   = (data[0] & to_underlying(Header::ExFlagValues::kExchangeFlag_AckMsg)) != 0;
+        const size_t length = kEncryptedHeaderSizeBytes + (hasAck ? kAckMessageCounterSizeBytes : 0);
+        if (size >= length)
+        {
+            mExchangeFlags.SetRaw(data[0]);
+            mMessageType = data[1];
+            mExchangeID  = LittleEndian::Get16(&data[2]);
+            mProtocolID  = Protocols::Id(VendorId::Common, LittleEndian::Get16(&data[4]));
+            if (hasAck)
+            {
+                mAckMessageCounter.SetValue(LittleEndian::Get32(&data[kEncryptedHeaderSizeBytes]));
+            }
+            else
+            {
+                mAckMessageCounter.ClearValue();
+            }
+            *decode_len = static_cast<uint16_t>(length);
+            return CHIP_NO_ERROR;
+        }
+    }
+
     CHIP_ERROR err = CHIP_NO_ERROR;
     LittleEndian::Reader reader(data, size);
     uint8_t header;
@@ -314,7 +362,8 @@ CHIP_ERROR PayloadHeader::DecodeAndConsume(const System::PacketBufferHandle & bu
 
 CHIP_ERROR PacketHeader::Encode(uint8_t * data, uint16_t size, uint16_t * encode_size) const
 {
-    VerifyOrReturnError(size >= EncodeSizeBytes(), CHIP_ERROR_INVALID_ARGUMENT);
+    const uint16_t headerSize = EncodeSizeBytes();
+    VerifyOrReturnError(size >= headerSize, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(!(mDestinationNodeId.HasValue() && mDestinationGroupId.HasValue()), CHIP_ERROR_INTERNAL);
     VerifyOrReturnError(encode_size != nullptr, CHIP_ERROR_INTERNAL);
     VerifyOrReturnError(IsSessionTypeValid(), CHIP_ERROR_INTERNAL);
@@ -345,7 +394,7 @@ CHIP_ERROR PacketHeader::Encode(uint8_t * data, uint16_t size, uint16_t * encode
     }
 
     // Written data size provided to caller on success
-    VerifyOrReturnError(p - data == EncodeSizeBytes(), CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(p - data == headerSize, CHIP_ERROR_INTERNAL);
     *encode_size = static_cast<uint16_t>(p - data);
 
     return CHIP_NO_ERROR;
@@ -366,7 +415,8 @@ CHIP_ERROR PacketHeader::EncodeBeforeData(const System::PacketBufferHandle & buf
 
 CHIP_ERROR PayloadHeader::Encode(uint8_t * data, uint16_t size, uint16_t * encode_size) const
 {
-    VerifyOrReturnError(size >= EncodeSizeBytes(), CHIP_ERROR_INVALID_ARGUMENT);
+    const uint16_t headerSize = EncodeSizeBytes();
+    VerifyOrReturnError(size >= headerSize, CHIP_ERROR_INVALID_ARGUMENT);
 
     uint8_t * p          = data;
     const uint8_t header = mExchangeFlags.Raw();
@@ -385,7 +435,7 @@ CHIP_ERROR PayloadHeader::Encode(uint8_t * data, uint16_t size, uint16_t * encod
     }
 
     // Written data size provided to caller on success
-    VerifyOrReturnError(p - data == EncodeSizeBytes(), CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(p - data == headerSize, CHIP_ERROR_INTERNAL);
     *encode_size = static_cast<uint16_t>(p - data);
 
     return CHIP_NO_ERROR;
@@ -31,6 +31,7 @@
 #include <transport/raw/MessageHeader.h>
 
 #include <inttypes.h>
+#include <string.h>
 #include <limits>
 
 namespace chip {
@@ -78,6 +79,7 @@ CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     VerifyOrExit(mState == State::kNotReady, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mActiveConnectionsSize > 0, err = CHIP_ERROR_NO_MEMORY);
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     err = params.GetEndPointManager()->NewEndPoint(&mListenSocket);
@@ -304,6 +306,30 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
         // Peel off the head to pass upstream, which effectively consumes it from `state->mReceived`.
         message = state->mReceived.PopHead();
     }
+    else if (state->mReceived->DataLength() > messageSize &&
+             state->mReceived->DataLength() - messageSize < messageSize)
+    {
+        // The head buffer holds the whole message followed by the start of the next one(s), which is what a burst
+        // of messages coalesced by the peer's TCP stack looks like. Rather than copying the message out, copy the
+        // (shorter) trailing data into a fresh buffer and pass the head upstream. The head is then owned exclusively
+        // by upper layers, so they remain free to use the space beyond the message.
+        const uint16_t tailLength              = static_cast<uint16_t>(state->mReceived->DataLength() - messageSize);
+        System::PacketBufferHandle receiveTail = System::PacketBufferHandle::New(tailLength, 0);
+        if (receiveTail.IsNull())
+        {
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        memcpy(receiveTail->Start(), state->mReceived->Start() + messageSize, tailLength);
+        receiveTail->SetDataLength(tailLength);
+
+        state->mReceived->SetDataLength(messageSize);
+        message = state->mReceived.PopHead();
+        if (!state->mReceived.IsNull())
+        {
+            receiveTail->AddToEnd(std::move(state->mReceived));
+        }
+        state->mReceived = std::move(receiveTail);
+    }
     else
     {
         // The message is either longer or shorter than the head buffer.
@@ -32,6 +32,7 @@
 #include <inet/InetInterface.h>
 #include <inet/TCPEndPoint.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/PoolWrapper.h>
 #include <transport/raw/Base.h>
@@ -180,6 +181,17 @@ public:
      */
     void CloseActiveConnections();
 
+protected:
+    /**
+     * Provide the connection table for transports that only allocate it after TCPBase has been
+     * constructed. Must be called before Init(). Every entry must be initialized by the caller.
+     */
+    void SetActiveConnections(ActiveConnectionState * activeConnectionsBuffer, size_t bufferSize)
+    {
+        mActiveConnections     = activeConnectionsBuffer;
+        mActiveConnectionsSize = bufferSize;
+    }
+
 private:
     friend class TCPTest;
 
@@ -259,7 +271,7 @@ private:
 
     // Currently active connections
     ActiveConnectionState * mActiveConnections;
-    const size_t mActiveConnectionsSize;
+    size_t mActiveConnectionsSize;
 
     // Data to be sent when connections succeed
     PendingPacketPoolType & mPendingPackets;
@@ -284,5 +296,55 @@ private:
     PoolImpl<PendingPacket, kPendingPacketSize, ObjectPoolMem::kInline, PendingPacketPoolType::Interface> mPendingPackets;
 };
 
+/**
+ * TCP transport whose connection table is sized at runtime and allocated from the heap, for
+ * devices (typically controllers and bridges) that keep many connections open at once.
+ *
+ * Pending packets use a heap backed pool when CHIP_SYSTEM_CONFIG_POOL_USE_HEAP is enabled.
+ */
+class HeapTCP : public TCPBase
+{
+public:
+    explicit HeapTCP(size_t activeConnectionsSize = CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS) :
+        TCPBase(nullptr, 0, mPendingPackets)
+    {
+        void * buffer = Platform::MemoryCalloc(activeConnectionsSize, sizeof(ActiveConnectionState));
+        if (buffer == nullptr)
+        {
+            // Init() will fail, as there is no room for any connection.
+            return;
+        }
+
+        mConnectionsBuffer = static_cast<ActiveConnectionState *>(buffer);
+        for (size_t i = 0; i < activeConnectionsSize; ++i)
+        {
+            new (&mConnectionsBuffer[i]) ActiveConnectionState();
+            mConnectionsBuffer[i].Init(nullptr);
+        }
+        mConnectionsBufferSize = activeConnectionsSize;
+        SetActiveConnections(mConnectionsBuffer, mConnectionsBufferSize);
+    }
+
+    ~HeapTCP() override
+    {
+        // Connections must be released while the table still exists.
+        CloseActiveConnections();
+        SetActiveConnections(nullptr, 0);
+        mPendingPackets.ReleaseAll();
+
+        for (size_t i = 0; i < mConnectionsBufferSize; ++i)
+        {
+            mConnectionsBuffer[i].~ActiveConnectionState();
+        }
+        Platform::MemoryFree(mConnectionsBuffer);
+    }
+
+private:
+    ActiveConnectionState * mConnectionsBuffer = nullptr;
+    size_t mConnectionsBufferSize              = 0;
+    PoolImpl<PendingPacket, CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS, ObjectPoolMem::kDefault, PendingPacketPoolType::Interface>
+        mPendingPackets;
+};
+
 } // namespace Transport
 } // namespace chip
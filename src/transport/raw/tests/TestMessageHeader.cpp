@@ -218,6 +218,64 @@ void TestPayloadHeaderEncodeDecode(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, header.GetProtocolID() == Protocols::Id(VendorId::Common, 1221));
 }
 
+void TestCommonHeaderDecode(nlTestSuite * inSuite, void * inContext)
+{
+    // Headers without node ids, vendor id nor extensions, on unicast sessions, are decoded with a shortcut: check it decodes
+    // the same fields as the general decoding of the other header shapes, and the same bounds.
+    uint8_t buffer[64];
+    uint16_t encodeLen;
+    uint16_t decodeLen;
+
+    for (bool control : { false, true })
+    {
+        PacketHeader header;
+        header.SetSessionId(0xBEEF).SetMessageCounter(0x01020304).SetSecureSessionControlMsg(control);
+        NL_TEST_ASSERT(inSuite, header.Encode(buffer, &encodeLen) == CHIP_NO_ERROR);
+
+        // change it to verify decoding
+        header.SetSessionId(1).SetMessageCounter(2).SetSourceNodeId(3).SetDestinationGroupId(4);
+        header.SetSecureSessionControlMsg(!control);
+
+        NL_TEST_ASSERT(inSuite, header.Decode(buffer, &decodeLen) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, encodeLen == decodeLen);
+        NL_TEST_ASSERT(inSuite, header.GetSessionId() == 0xBEEF);
+        NL_TEST_ASSERT(inSuite, header.GetMessageCounter() == 0x01020304);
+        NL_TEST_ASSERT(inSuite, header.IsSecureSessionControlMsg() == control);
+        NL_TEST_ASSERT(inSuite, header.IsUnicastSession());
+        NL_TEST_ASSERT(inSuite, !header.GetSourceNodeId().HasValue());
+        NL_TEST_ASSERT(inSuite, !header.GetDestinationNodeId().HasValue());
+        NL_TEST_ASSERT(inSuite, !header.GetDestinationGroupId().HasValue());
+
+        NL_TEST_ASSERT(inSuite, header.Decode(buffer, static_cast<uint16_t>(encodeLen - 1), &decodeLen) != CHIP_NO_ERROR);
+    }
+
+    for (bool ack : { false, true })
+    {
+        PayloadHeader header;
+        header.SetMessageType(Protocols::Id(VendorId::Common, 0x0506), 0x07).SetExchangeID(0x0809).SetInitiator(true);
+        if (ack)
+        {
+            header.SetAckMessageCounter(0x0A0B0C0D);
+        }
+        NL_TEST_ASSERT(inSuite, header.Encode(buffer, &encodeLen) == CHIP_NO_ERROR);
+
+        // change it to verify decoding
+        header.SetMessageType(Protocols::Id(VendorId::NotSpecified, 1), 2).SetExchangeID(3).SetInitiator(false);
+        header.SetAckMessageCounter(4);
+
+        NL_TEST_ASSERT(inSuite, header.Decode(buffer, &decodeLen) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, encodeLen == decodeLen);
+        NL_TEST_ASSERT(inSuite, header.GetMessageType() == 0x07);
+        NL_TEST_ASSERT(inSuite, header.GetExchangeID() == 0x0809);
+        NL_TEST_ASSERT(inSuite, header.GetProtocolID() == Protocols::Id(VendorId::Common, 0x0506));
+        NL_TEST_ASSERT(inSuite, header.IsInitiator());
+        NL_TEST_ASSERT(inSuite, header.GetAckMessageCounter().HasValue() == ack);
+        NL_TEST_ASSERT(inSuite, !ack || header.GetAckMessageCounter().Value() == 0x0A0B0C0D);
+
+        NL_TEST_ASSERT(inSuite, header.Decode(buffer, static_cast<uint16_t>(encodeLen - 1), &decodeLen) != CHIP_NO_ERROR);
+    }
+}
+
 void TestPacketHeaderEncodeDecodeBounds(nlTestSuite * inSuite, void * inContext)
 {
     PacketHeader header;
@@ -541,6 +599,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("PayloadInitialState", TestPayloadHeaderInitialState),
     NL_TEST_DEF("PacketEncodeDecode", TestPacketHeaderEncodeDecode),
     NL_TEST_DEF("PayloadEncodeDecode", TestPayloadHeaderEncodeDecode),
+    NL_TEST_DEF("CommonHeaderDecode", TestCommonHeaderDecode),
     NL_TEST_DEF("PacketEncodeDecodeBounds", TestPacketHeaderEncodeDecodeBounds),
     NL_TEST_DEF("PayloadEncodeDecodeBounds", TestPayloadHeaderEncodeDecodeBounds),
     NL_TEST_DEF("SpecComplianceEncode", TestSpecComplianceEncode),
@@ -105,7 +105,7 @@ public:
         mReceiveHandlerCallCount++;
     }
 
-    void InitializeMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void InitializeMessageTest(Transport::TCPBase & tcp, const IPAddress & addr)
     {
         CHIP_ERROR err = tcp.Init(Transport::TcpListenParameters(mContext.GetTCPEndPointManager()).SetAddressType(addr.Type()));
 
@@ -137,7 +137,7 @@ public:
         mReceiveHandlerCallCount = 0;
     }
 
-    void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void SingleMessageTest(Transport::TCPBase & tcp, const IPAddress & addr)
     {
         chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
         NL_TEST_ASSERT(mSuite, !buffer.IsNull());
@@ -161,10 +161,70 @@ public:
         SetCallback(nullptr);
     }
 
-    void FinalizeMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void ChainedMessageTest(Transport::TCPBase & tcp, const IPAddress & addr, uint8_t messageCount)
+    {
+        // Messages sent while the connection is being established are chained into a single
+        // pending packet buffer, which the endpoint then sends with one gather write.
+        SetCallback([](const uint8_t * message, size_t length, int count, void * data) {
+            return (length == 1 && message[0] == count) ? 0 : -1;
+        });
+
+        for (uint8_t i = 0; i < messageCount; i++)
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(&i, sizeof(i));
+            NL_TEST_ASSERT(mSuite, !buffer.IsNull());
+
+            PacketHeader header;
+            header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter + i);
+
+            CHIP_ERROR err = header.EncodeBeforeData(buffer);
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+
+            err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer));
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        }
+
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5),
+                              [this, messageCount]() { return mReceiveHandlerCallCount == messageCount; });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == messageCount);
+
+        SetCallback(nullptr);
+    }
+
+    void MultiplePeersMessageTest(Transport::TCPBase & tcp, const IPAddress * addrs, uint8_t peerCount)
+    {
+        // One message to each peer, each over its own connection. The connections stay open until FinalizeMessageTest.
+        SetCallback([](const uint8_t * message, size_t length, int count, void * data) { return (length == 1) ? 0 : -1; });
+
+        for (uint8_t i = 0; i < peerCount; i++)
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(&i, sizeof(i));
+            NL_TEST_ASSERT(mSuite, !buffer.IsNull());
+
+            PacketHeader header;
+            header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter + i);
+
+            CHIP_ERROR err = header.EncodeBeforeData(buffer);
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+
+            err = tcp.SendMessage(Transport::PeerAddress::TCP(addrs[i]), std::move(buffer));
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        }
+
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5),
+                              [this, peerCount]() { return mReceiveHandlerCallCount == peerCount; });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == peerCount);
+
+        SetCallback(nullptr);
+    }
+
+    void FinalizeMessageTest(Transport::TCPBase & tcp, const IPAddress * addrs, size_t peerCount = 1)
     {
         // Disconnect and wait for seeing peer close
-        tcp.Disconnect(Transport::PeerAddress::TCP(addr));
+        for (size_t i = 0; i < peerCount; i++)
+        {
+            tcp.Disconnect(Transport::PeerAddress::TCP(addrs[i]));
+        }
         mContext.DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp]() { return !tcp.HasActiveConnections(); });
     }
 
@@ -213,7 +273,7 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress &
     MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
     gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
     gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
-    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, &addr);
 }
 
 #if INET_CONFIG_ENABLE_IPV4
@@ -232,6 +292,43 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckChainedMessageTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.ChainedMessageTest(tcp, addr, 5);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, &addr);
+}
+
+#if INET_CONFIG_ENABLE_IPV4
+void CheckHeapTCPConnectionsTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // A message to each of three loopback addresses opens three outgoing and three incoming connections, more than
+    // the kMaxTcpActiveConnectionCount that TCPImpl can hold.
+    constexpr uint8_t kPeerCount = 3;
+    static_assert(2 * kPeerCount > kMaxTcpActiveConnectionCount, "The test must need more connections than TCPImpl has");
+    Transport::HeapTCP tcp(2 * kPeerCount);
+
+    IPAddress addrs[kPeerCount];
+    IPAddress::FromString("127.0.0.1", addrs[0]);
+    IPAddress::FromString("127.0.0.2", addrs[1]);
+    IPAddress::FromString("127.0.0.3", addrs[2]);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addrs[0]);
+    gMockTransportMgrDelegate.MultiplePeersMessageTest(tcp, addrs, kPeerCount);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addrs, kPeerCount);
+}
+#endif // INET_CONFIG_ENABLE_IPV4
+
 // Generates a packet buffer or a chain of packet buffers for a single message.
 struct TestData
 {
@@ -440,6 +537,23 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
 
+    // Test two messages coalesced into a single packet buffer, the second one shorter than the first.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 151, 0 }));
+    NL_TEST_ASSERT(inSuite, testData[1].Init((const uint16_t[]){ 52, 0 }));
+    {
+        const uint16_t firstLength           = testData[0].mHandle->DataLength();
+        const uint16_t secondLength          = testData[1].mHandle->DataLength();
+        System::PacketBufferHandle coalesced = System::PacketBufferHandle::New(firstLength + secondLength, 0);
+        NL_TEST_ASSERT(inSuite, !coalesced.IsNull());
+        memcpy(coalesced->Start(), testData[0].mHandle->Start(), firstLength);
+        memcpy(coalesced->Start() + firstLength, testData[1].mHandle->Start(), secondLength);
+        coalesced->SetDataLength(static_cast<uint16_t>(firstLength + secondLength));
+        err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(coalesced));
+    }
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
+
     // Test a message that is too large to coalesce into a single packet buffer.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     gMockTransportMgrDelegate.SetCallback(TestDataCallbackCheck, &testData[1]);
@@ -450,7 +564,7 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_MESSAGE_TOO_LONG);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 0);
 
-    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, &addr);
 }
 
 // Test Suite
@@ -463,10 +577,12 @@ static const nlTest sTests[] =
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("Simple Init Test IPV4",        CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",       CheckMessageTest4),
+    NL_TEST_DEF("HeapTCP Connections Test",     CheckHeapTCPConnectionsTest),
 #endif
 
     NL_TEST_DEF("Simple Init Test IPV6",        CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",       CheckMessageTest6),
+    NL_TEST_DEF("Chained Message Test",         CheckChainedMessageTest),
     NL_TEST_DEF("ProcessReceivedBuffer Test",   chip::Transport::TCPTest::CheckProcessReceivedBuffer),
 
     NL_TEST_SENTINEL()
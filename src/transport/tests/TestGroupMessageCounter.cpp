@@ -82,22 +82,25 @@ public:
 
         return kUndefinedFabricIndex;
     }
-    NodeId GetNodeIdAt(uint8_t fabricIndex, uint8_t index, bool isControl)
+    bool HasPeerAt(uint8_t fabricIndex, NodeId nodeId, bool isControl)
     {
-        if (fabricIndex < CHIP_CONFIG_MAX_FABRICS)
+        if (fabricIndex >= CHIP_CONFIG_MAX_FABRICS)
         {
-            if (isControl && index < CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS)
-            {
-                return mGroupFabrics[fabricIndex].mControlGroupSenders[index].mNodeId;
-            }
+            return false;
+        }
 
-            if (!isControl && index < CHIP_CONFIG_MAX_GROUP_DATA_PEERS)
+        const chip::Transport::GroupSender * senders = isControl ? mGroupFabrics[fabricIndex].mControlGroupSenders
+                                                                 : mGroupFabrics[fabricIndex].mDataGroupSenders;
+        uint32_t slots = isControl ? chip::Transport::GroupFabric::kControlPeerSlots : chip::Transport::GroupFabric::kDataPeerSlots;
+        for (uint32_t i = 0; i < slots; i++)
+        {
+            if (senders[i].mNodeId == nodeId)
             {
-                return mGroupFabrics[fabricIndex].mDataGroupSenders[index].mNodeId;
+                return true;
             }
         }
 
-        return kUndefinedNodeId;
+        return false;
     }
 };
 
@@ -108,17 +111,31 @@ void AddPeerTest(nlTestSuite * inSuite, void * inContext)
     uint32_t i                                    = 0;
     CHIP_ERROR err                                = CHIP_NO_ERROR;
     chip::Transport::PeerMessageCounter * counter = nullptr;
-    chip::Transport::GroupPeerTable mGroupPeerMsgCounter;
+    TestGroupPeerTable mGroupPeerMsgCounter;
 
-    do
+    for (i = 0; i < CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i++)
     {
-        err = mGroupPeerMsgCounter.FindOrAddPeer(fabricIndex, peerNodeId++, false, counter);
-        i++;
+        err = mGroupPeerMsgCounter.FindOrAddPeer(fabricIndex, peerNodeId + i, false, counter);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
 
-    } while (err != CHIP_ERROR_TOO_MANY_PEER_NODES);
+    // Once the fabric is full, adding a peer evicts the least recently used one.
+    for (i = 1; i < CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i++)
+    {
+        err = mGroupPeerMsgCounter.FindOrAddPeer(fabricIndex, peerNodeId + i, false, counter);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = mGroupPeerMsgCounter.FindOrAddPeer(fabricIndex, peerNodeId + CHIP_CONFIG_MAX_GROUP_DATA_PEERS, false, counter);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 
-    NL_TEST_ASSERT(inSuite, i == CHIP_CONFIG_MAX_GROUP_DATA_PEERS + 1);
+    NL_TEST_ASSERT(inSuite, !mGroupPeerMsgCounter.HasPeerAt(0, peerNodeId, false));
+    for (i = 1; i <= CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.HasPeerAt(0, peerNodeId + i, false));
+    }
 
+    // Fabrics are never evicted
+    peerNodeId += CHIP_CONFIG_MAX_GROUP_DATA_PEERS + 1;
     i = 1;
     do
     {
@@ -322,30 +339,86 @@ void ReorderPeerRemovalTest(nlTestSuite * inSuite, void * inContext)
     err = mGroupPeerMsgCounter.FindOrAddPeer(1, 2, true, counter);
     err = mGroupPeerMsgCounter.RemovePeer(1, 1, true);
 
-    NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.GetNodeIdAt(0, 0, true) == 2);
+    NL_TEST_ASSERT(inSuite, !mGroupPeerMsgCounter.HasPeerAt(0, 1, true));
+    NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.HasPeerAt(0, 2, true));
 
     // with other list
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 1, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 2, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 3, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 4, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 5, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 6, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 7, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 8, false, counter);
-    err = mGroupPeerMsgCounter.FindOrAddPeer(2, 9, false, counter);
+    for (NodeId nodeId = 1; nodeId <= 9; nodeId++)
+    {
+        err = mGroupPeerMsgCounter.FindOrAddPeer(2, nodeId, false, counter);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        // Give every peer a distinct counter, to check that entries are moved around intact.
+        err = counter->VerifyOrTrustFirstGroup(static_cast<uint32_t>(nodeId * 1000));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        counter->CommitGroup(static_cast<uint32_t>(nodeId * 1000));
+    }
 
     err = mGroupPeerMsgCounter.RemovePeer(2, 7, false);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.GetNodeIdAt(1, 6, false) == 9);
-
     err = mGroupPeerMsgCounter.RemovePeer(2, 4, false);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.GetNodeIdAt(1, 3, false) == 8);
-
     err = mGroupPeerMsgCounter.RemovePeer(2, 1, false);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.GetNodeIdAt(1, 0, false) == 9);
+    err = mGroupPeerMsgCounter.RemovePeer(2, 1, false);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NOT_FOUND);
+
+    for (NodeId nodeId = 1; nodeId <= 9; nodeId++)
+    {
+        bool removed = (nodeId == 1 || nodeId == 4 || nodeId == 7);
+        NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.HasPeerAt(1, nodeId, false) == !removed);
+        if (removed)
+        {
+            continue;
+        }
+
+        err = mGroupPeerMsgCounter.FindOrAddPeer(2, nodeId, false, counter);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        // The committed counter must still be in place: replaying it is rejected.
+        err = counter->VerifyOrTrustFirstGroup(static_cast<uint32_t>(nodeId * 1000));
+        NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+    }
+}
+
+void ManyPeersTest(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err                                = CHIP_NO_ERROR;
+    chip::Transport::PeerMessageCounter * counter = nullptr;
+    TestGroupPeerTable mGroupPeerMsgCounter;
+
+    // Node ids sharing low bits, to exercise collisions in the hash tables.
+    constexpr NodeId kNodeIdStride = 0x100000000;
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        for (NodeId i = 1; i <= CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i++)
+        {
+            err = mGroupPeerMsgCounter.FindOrAddPeer(1, i * kNodeIdStride, false, counter);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            if (round == 0)
+            {
+                err = counter->VerifyOrTrustFirstGroup(static_cast<uint32_t>(i));
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                counter->CommitGroup(static_cast<uint32_t>(i));
+            }
+            else
+            {
+                // Lookups after the first round must find the existing counter.
+                err = counter->VerifyOrTrustFirstGroup(static_cast<uint32_t>(i));
+                NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+            }
+        }
+    }
+
+    // Remove every other peer, then make sure the remaining ones are still found.
+    for (NodeId i = 1; i <= CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i += 2)
+    {
+        err = mGroupPeerMsgCounter.RemovePeer(1, i * kNodeIdStride, false);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    for (NodeId i = 1; i <= CHIP_CONFIG_MAX_GROUP_DATA_PEERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, mGroupPeerMsgCounter.HasPeerAt(0, i * kNodeIdStride, false) == (i % 2 == 0));
+    }
 }
 
 void ReorderFabricRemovalTest(nlTestSuite * inSuite, void * inContext)
@@ -468,6 +541,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Counter Trust first",    CounterTrustFirstTest),
     NL_TEST_DEF("Reorder Peer removal",   ReorderPeerRemovalTest),
     NL_TEST_DEF("Reorder Fabric Removal", ReorderFabricRemovalTest),
+    NL_TEST_DEF("Many Peers",             ManyPeersTest),
     NL_TEST_DEF("Group Message Counter",  GroupMessageCounterTest),
     NL_TEST_SENTINEL()
 };
@@ -25,9 +25,11 @@
 #include <transport/MessageCounter.h>
 #include <transport/PeerMessageCounter.h>
 
+#include <algorithm>
 #include <errno.h>
 #include <nlbyteorder.h>
 #include <nlunit-test.h>
+#include <set>
 #include <vector>
 
 namespace {
@@ -468,6 +470,51 @@ void UnencryptedOutOfWindow(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void UnicastReorderTest(nlTestSuite * inSuite, void * inContext)
+{
+    // Counters arriving out of order, some of them repeated, must be accepted exactly once while within the window behind the
+    // max counter.  The expected outcome is tracked with the set of the counters accepted so far.
+    constexpr uint32_t kWindowSize = CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE;
+    constexpr uint32_t kStart      = 0x10000;
+
+    chip::Transport::PeerMessageCounter counter;
+    counter.SetCounter(kStart);
+
+    std::set<uint32_t> accepted = { kStart };
+    uint32_t maxCounter         = kStart;
+    uint32_t random             = 1;
+    for (int i = 0; i < 100000; i++)
+    {
+        // Mostly next counters, then reordered or repeated ones from around the window, and a few leaps.
+        random              = random * 1103515245 + 12345;
+        const uint32_t pick = (random >> 16) % 16;
+        uint32_t value;
+        if (pick < 8)
+        {
+            value = maxCounter + 1 + pick % 3;
+        }
+        else if (pick < 15)
+        {
+            value = maxCounter - ((random >> 8) % (kWindowSize + 8));
+        }
+        else
+        {
+            value = maxCounter + 1 + ((random >> 8) % (2 * kWindowSize + 64));
+        }
+
+        const bool expectAccepted = (value > maxCounter) || (maxCounter - value <= kWindowSize && accepted.count(value) == 0);
+        const CHIP_ERROR err      = counter.VerifyEncryptedUnicast(value);
+        NL_TEST_ASSERT(inSuite, (err == CHIP_NO_ERROR) == expectAccepted);
+        if (err == CHIP_NO_ERROR)
+        {
+            counter.CommitEncryptedUnicast(value);
+            accepted.insert(value);
+            maxCounter = std::max(maxCounter, value);
+        }
+        NL_TEST_ASSERT(inSuite, counter.GetCounter() == maxCounter);
+    }
+}
+
 } // namespace
 
 /**
@@ -482,6 +529,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Group Out of Window Test",       GroupOutOfWindow),
     NL_TEST_DEF("Unicast small step Test",        UnicastSmallStepTest),
     NL_TEST_DEF("Unicast large step Test",        UnicastLargeStepTest),
+    NL_TEST_DEF("Unicast reorder Test",           UnicastReorderTest),
     NL_TEST_DEF("Unencrypted Roll over Test",     UnencryptedRollOverTest),
     NL_TEST_DEF("Unencrypted Backtrack Test",     UnencryptedBackTrackTest),
     NL_TEST_DEF("Unencrypted All value test",     UnencryptedBigLeapTest),